@@ -0,0 +1,283 @@
+
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef MSEALGORITHM_H
+#define MSEALGORITHM_H
+
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <stdexcept>
+#ifdef MSE_SELF_TESTS
+#include "msemsevector.h"
+#include "msemsearray.h"
+#include "msemstdvector.h"
+#include "msemstdarray.h"
+#endif // MSE_SELF_TESTS
+
+#ifdef MSE_CUSTOM_THROW_DEFINITION
+#include <iostream>
+#define MSE_THROW(x) MSE_CUSTOM_THROW_DEFINITION(x)
+#else // MSE_CUSTOM_THROW_DEFINITION
+#define MSE_THROW(x) throw(x)
+#endif // MSE_CUSTOM_THROW_DEFINITION
+
+/* Bulk versions of some common algorithms. They take a range of (bounds checked) iterators of one of the library's
+contiguous containers (msevector, msearray, mstd::vector, mstd::array, ivector), validate the range once, up front, and
+then operate directly on the underlying storage, rather than incurring a bounds check for each element access. The
+resulting loops are simple enough for the compiler to auto-vectorize (given the appropriate target flags, -mavx2 for
+example). They don't accept other iterators (use the standard algorithms for those), and they're named differently
+from the standard algorithms so that unqualified calls (with "using namespace std;") aren't ambiguous.
+Note that, as with the standard algorithms, the function objects passed to these algorithms must not change the size
+(or otherwise invalidate the iterators) of the container being operated on. Unlike the per-element bounds checks,
+the up front validation cannot detect such changes made during the operation. */
+
+namespace mse {
+
+	class msealgorithm_range_error : public std::range_error { public:
+		using std::range_error::range_error;
+	};
+
+	namespace us {
+		namespace impl {
+			template<class _TIter>
+			struct HasPositionMethod {
+				template<class U> static auto test(const U* u) -> decltype(u->position(), std::true_type());
+				template<class U> static std::false_type test(...);
+				static const bool value = decltype(test<_TIter>(nullptr))::value;
+			};
+			/* The library's iterators that expose a position() member are all index based iterators over contiguous
+			storage. */
+			template<class _TIter>
+			struct IsContiguousCheckedIterator : std::integral_constant<bool, HasPositionMethod<_TIter>::value
+				&& std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_TIter>::iterator_category>::value
+				&& std::is_lvalue_reference<typename std::iterator_traits<_TIter>::reference>::value> {};
+
+			template<class _TIter>
+			using TRawPointer = typename std::add_pointer<typename std::remove_reference<typename std::iterator_traits<_TIter>::reference>::type>::type;
+
+			/* Returns a pointer to the first element of the range [first, first + count), after verifying (using the
+			iterators' own bounds checking) that the whole range is valid. */
+			template<class _TIter>
+			TRawPointer<_TIter> checked_range_data(const _TIter& first, typename std::iterator_traits<_TIter>::difference_type count) {
+				if (0 > count) { MSE_THROW(msealgorithm_range_error("invalid range - checked_range_data() - msealgorithm")); }
+				if (0 == count) { return nullptr; }
+				/* Both dereferences are bounds checked. */
+				auto first_ptr = std::addressof(*first);
+				auto last_ptr = std::addressof(*(first + (count - 1)));
+				if ((count - 1) != (last_ptr - first_ptr)) { MSE_THROW(msealgorithm_range_error("non-contiguous range - checked_range_data() - msealgorithm")); }
+				return first_ptr;
+			}
+			template<class _TIter>
+			typename std::iterator_traits<_TIter>::difference_type checked_range_size(const _TIter& first, const _TIter& last) {
+				/* The iterators' operator-() verifies that they refer to the same container. */
+				return (last - first);
+			}
+
+			template<class _TIter, class _TFunction>
+			_TIter for_each_n_helper(_TIter first, typename std::iterator_traits<_TIter>::difference_type n, _TFunction& func) {
+				auto data = checked_range_data(first, n);
+				for (decltype(n) i = 0; i < n; i += 1) {
+					func(data[i]);
+				}
+				return first + n;
+			}
+
+			template<class _TInIter, class _TOutIter, class _TUnaryOperation>
+			_TOutIter transform_helper(_TInIter first, _TInIter last, _TOutIter d_first, _TUnaryOperation& unary_op) {
+				const auto count = checked_range_size(first, last);
+				const auto in_data = checked_range_data(first, count);
+				const auto out_data = checked_range_data(d_first, count);
+				for (decltype(checked_range_size(first, last)) i = 0; i < count; i += 1) {
+					out_data[i] = unary_op(in_data[i]);
+				}
+				return d_first + count;
+			}
+			template<class _TInIter1, class _TInIter2, class _TOutIter, class _TBinaryOperation>
+			_TOutIter transform_helper(_TInIter1 first1, _TInIter1 last1, _TInIter2 first2, _TOutIter d_first, _TBinaryOperation& binary_op) {
+				const auto count = checked_range_size(first1, last1);
+				const auto in_data1 = checked_range_data(first1, count);
+				const auto in_data2 = checked_range_data(first2, count);
+				const auto out_data = checked_range_data(d_first, count);
+				for (decltype(checked_range_size(first1, last1)) i = 0; i < count; i += 1) {
+					out_data[i] = binary_op(in_data1[i], in_data2[i]);
+				}
+				return d_first + count;
+			}
+
+			template<class _TIter, class _Ty>
+			void fill_helper(_TIter first, _TIter last, const _Ty& value) {
+				const auto count = checked_range_size(first, last);
+				const auto data = checked_range_data(first, count);
+				std::fill(data, data + count, value);
+			}
+
+			template<class _TInIter, class _TOutIter>
+			_TOutIter copy_helper(_TInIter first, _TInIter last, _TOutIter d_first) {
+				const auto count = checked_range_size(first, last);
+				const auto in_data = checked_range_data(first, count);
+				const auto out_data = checked_range_data(d_first, count);
+				std::copy(in_data, in_data + count, out_data);
+				return d_first + count;
+			}
+
+			template<class _TIter, class _Ty, class _TBinaryOperation>
+			_Ty accumulate_helper(_TIter first, _TIter last, _Ty init, _TBinaryOperation& op) {
+				const auto count = checked_range_size(first, last);
+				const auto data = checked_range_data(first, count);
+				for (decltype(checked_range_size(first, last)) i = 0; i < count; i += 1) {
+					init = op(std::move(init), data[i]);
+				}
+				return init;
+			}
+
+			template<class _TIter, class _Ty>
+			_TIter find_helper(_TIter first, _TIter last, const _Ty& value) {
+				const auto count = checked_range_size(first, last);
+				const auto data = checked_range_data(first, count);
+				const auto found_ptr = std::find(data, data + count, value);
+				return first + (found_ptr - data);
+			}
+
+			template<class... _TIters>
+			struct AreContiguousCheckedIterators;
+			template<class _TIter>
+			struct AreContiguousCheckedIterators<_TIter> : IsContiguousCheckedIterator<_TIter> {};
+			template<class _TIter, class... _TIters>
+			struct AreContiguousCheckedIterators<_TIter, _TIters...> : std::integral_constant<bool,
+				IsContiguousCheckedIterator<_TIter>::value && AreContiguousCheckedIterators<_TIters...>::value> {};
+		}
+	}
+
+	template<class _TIter, class _TSize, class _TFunction, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	_TIter bulk_for_each_n(_TIter first, _TSize n, _TFunction func) {
+		typedef typename std::iterator_traits<_TIter>::difference_type difference_type;
+		return us::impl::for_each_n_helper(first, difference_type(n), func);
+	}
+	/* This version takes the number of elements as a template parameter (for when it's known at compile-time, as when
+	iterating over an msearray or mstd::array, for example). The range validation checks that involve the count are then
+	resolved at compile-time, leaving just the (bounds checked) dereferences of the first and last elements, and the loop
+	has a fixed trip count the compiler can unroll. */
+	template<size_t _Count, class _TIter, class _TFunction, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	_TIter bulk_for_each_n(_TIter first, _TFunction func) {
+		typedef typename std::iterator_traits<_TIter>::difference_type difference_type;
+		return us::impl::for_each_n_helper(first, difference_type(_Count), func);
+	}
+	template<class _TInIter, class _TOutIter, class _TUnaryOperation, class = typename std::enable_if<us::impl::AreContiguousCheckedIterators<_TInIter, _TOutIter>::value, void>::type>
+	_TOutIter bulk_transform(_TInIter first, _TInIter last, _TOutIter d_first, _TUnaryOperation unary_op) {
+		return us::impl::transform_helper(first, last, d_first, unary_op);
+	}
+	template<class _TInIter1, class _TInIter2, class _TOutIter, class _TBinaryOperation, class = typename std::enable_if<us::impl::AreContiguousCheckedIterators<_TInIter1, _TInIter2, _TOutIter>::value, void>::type>
+	_TOutIter bulk_transform(_TInIter1 first1, _TInIter1 last1, _TInIter2 first2, _TOutIter d_first, _TBinaryOperation binary_op) {
+		return us::impl::transform_helper(first1, last1, first2, d_first, binary_op);
+	}
+	template<class _TIter, class _Ty, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	void bulk_fill(_TIter first, _TIter last, const _Ty& value) {
+		us::impl::fill_helper(first, last, value);
+	}
+	template<class _TInIter, class _TOutIter, class = typename std::enable_if<us::impl::AreContiguousCheckedIterators<_TInIter, _TOutIter>::value, void>::type>
+	_TOutIter bulk_copy(_TInIter first, _TInIter last, _TOutIter d_first) {
+		return us::impl::copy_helper(first, last, d_first);
+	}
+	template<class _TIter, class _Ty, class _TBinaryOperation, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	_Ty bulk_accumulate(_TIter first, _TIter last, _Ty init, _TBinaryOperation op) {
+		return us::impl::accumulate_helper(first, last, std::move(init), op);
+	}
+	template<class _TIter, class _Ty, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	_Ty bulk_accumulate(_TIter first, _TIter last, _Ty init) {
+		return mse::bulk_accumulate(first, last, std::move(init), std::plus<_Ty>());
+	}
+	template<class _TIter, class _Ty, class = typename std::enable_if<us::impl::IsContiguousCheckedIterator<_TIter>::value, void>::type>
+	_TIter bulk_find(_TIter first, _TIter last, const _Ty& value) {
+		return us::impl::find_helper(first, last, value);
+	}
+
+
+	class msealgorithm_test {
+	public:
+		void test1() {
+#ifdef MSE_SELF_TESTS
+			{
+				mse::msevector<int> v1(100, 1);
+				mse::msevector<int> v2(100);
+				mse::bulk_fill(v2.ss_begin(), v2.ss_end(), 3);
+				auto res1 = mse::bulk_accumulate(v2.ss_cbegin(), v2.ss_cend(), 0);
+				assert(300 == res1);
+				mse::bulk_transform(v1.ss_cbegin(), v1.ss_cend(), v2.ss_cbegin(), v2.ss_begin(), [](int a, int b) { return a + b; });
+				auto res2 = mse::bulk_accumulate(v2.ss_cbegin(), v2.ss_cend(), 0);
+				assert(400 == res2);
+				mse::bulk_for_each_n(v1.ss_begin(), 10, [](int& a) { a = 7; });
+				auto found_it = mse::bulk_find(v1.ss_cbegin(), v1.ss_cend(), 1);
+				assert(10 == found_it.position());
+
+				auto ip1 = mse::bulk_copy(v1.ibegin(), v1.iend(), v2.ibegin());
+				assert(v2.iend() == ip1);
+				assert(7 == v2[0]);
+
+				mse::msevector<int> v3(50);
+				try {
+					/* The destination is too small. */
+					mse::bulk_copy(v1.ss_cbegin(), v1.ss_cend(), v3.ss_begin());
+					assert(false);
+				}
+				catch (...) {
+				}
+				try {
+					/* The iterators refer to different containers. */
+					mse::bulk_fill(v1.ss_begin(), v2.ss_end(), 3);
+					assert(false);
+				}
+				catch (...) {
+				}
+				try {
+					mse::bulk_for_each_n(v3.ss_begin(), 51, [](int& a) { a = 7; });
+					assert(false);
+				}
+				catch (...) {
+				}
+			}
+			{
+				mse::msearray<double, 64> a1;
+				mse::bulk_fill(a1.ss_begin(), a1.ss_end(), 0.5);
+				mse::mstd::array<double, 64> a2;
+				mse::bulk_transform(a1.ss_cbegin(), a1.ss_cend(), a2.begin(), [](double a) { return 2 * a; });
+				auto res3 = mse::bulk_accumulate(a2.cbegin(), a2.cend(), 0.0);
+				assert(64.0 == res3);
+
+				mse::mstd::vector<double> v4(64);
+				mse::bulk_copy(a2.cbegin(), a2.cend(), v4.begin());
+				assert(1.0 == v4.back());
+
+				double sum1 = 0.0;
+				mse::bulk_for_each_n<64>(a2.cbegin(), [&sum1](double a) { sum1 += a; });
+				assert(64.0 == sum1);
+				try {
+					mse::bulk_for_each_n<65>(a1.ss_begin(), [](double& a) { a = 7; });
+					assert(false);
+				}
+				catch (...) {
+				}
+			}
+			{
+				/* The bulk algorithms don't clash with the standard ones in unqualified calls. */
+				using namespace std;
+				mse::msevector<int> v5(10, 2);
+				fill(v5.ss_begin(), v5.ss_begin() + 5, 1);
+				auto found_it2 = find(v5.ss_cbegin(), v5.ss_cend(), 2);
+				assert(5 == found_it2.position());
+				assert(15 == accumulate(v5.ss_cbegin(), v5.ss_cend(), 0));
+			}
+#endif // MSE_SELF_TESTS
+		}
+	};
+}
+
+#undef MSE_THROW
+
+#endif /*ndef MSEALGORITHM_H*/
@@ -10,8 +10,22 @@
 
 #include "mseoptional.h"
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <tuple>
+#include <array>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <ctime>
@@ -93,7 +107,7 @@ namespace mse {
 				retval = true;
 			}
 			else {
-				assert(0 == m_writelock_count);
+				assert((std::this_thread::get_id() != m_writelock_thread_id) || (0 == m_writelock_count));
 				retval = base_class::try_lock();
 				if (retval) {
 					m_writelock_thread_id = std::this_thread::get_id();
@@ -120,7 +134,7 @@ namespace mse {
 				retval = true;
 			}
 			else {
-				assert(0 == m_writelock_count);
+				assert((std::this_thread::get_id() != m_writelock_thread_id) || (0 == m_writelock_count));
 				retval = base_class::try_lock_until(_Abs_time);
 				if (retval) {
 					m_writelock_thread_id = std::this_thread::get_id();
@@ -281,8 +295,831 @@ namespace mse {
 		std::unordered_map<std::thread::id, int> m_thread_id_readlock_count_map;
 	};
 
-	//typedef std::shared_timed_mutex async_shared_timed_mutex_type;
-	typedef recursive_shared_timed_mutex async_shared_timed_mutex_type;
+	namespace us {
+		namespace impl {
+			static const size_t sc_async_shared_num_reader_slots = 32;
+			/* Each thread is (round-robin) assigned one of the reader slots, and uses it for its lifetime. */
+			inline size_t async_shared_reader_slot_index() {
+				static std::atomic<size_t> s_next_index{ 0 };
+				static thread_local const size_t tl_index = s_next_index.fetch_add(1, std::memory_order_relaxed) % sc_async_shared_num_reader_slots;
+				return tl_index;
+			}
+
+			struct immutable_payload_tag {};
+		}
+	}
+
+	/* distributed_recursive_shared_timed_mutex is an alternative to recursive_shared_timed_mutex that scales better when
+	many threads acquire shared (read) locks concurrently. Instead of going through a common bookkeeping mutex and counter,
+	readers register in one of a set of cache line padded reader slots (each thread always uses the same slot), so read
+	locks taken by different threads mostly touch different cache lines. Writers have precedence: once a writer is waiting,
+	new read lock requests wait until it's done. Recursive read locks are tracked per thread, and are granted even while a
+	writer is waiting (otherwise the writer and the reader would wait on each other). Write locks are also recursive. The
+	costs are a larger footprint (a couple of kilobytes) and more expensive write locks. Define
+	MSE_ASYNCSHARED_USE_DISTRIBUTED_MUTEX to have TAsyncSharedObj use it in place of recursive_shared_timed_mutex. */
+	class distributed_recursive_shared_timed_mutex {
+	public:
+		distributed_recursive_shared_timed_mutex() {}
+		distributed_recursive_shared_timed_mutex(const distributed_recursive_shared_timed_mutex&) = delete;
+		distributed_recursive_shared_timed_mutex& operator=(const distributed_recursive_shared_timed_mutex&) = delete;
+
+		void lock()
+		{	// lock exclusive
+			if (owns_write_lock()) {
+				m_writelock_count += 1;
+				return;
+			}
+			m_writer_mutex.lock();
+			m_writer_pending.store(true);
+			{
+				std::unique_lock<std::mutex> lock1(m_wait_mutex);
+				m_wait_cv.wait(lock1, [this]() { return !has_readers(); });
+			}
+			set_write_lock_owner();
+		}
+
+		bool try_lock()
+		{	// try to lock exclusive
+			if (owns_write_lock()) {
+				m_writelock_count += 1;
+				return true;
+			}
+			if (!m_writer_mutex.try_lock()) {
+				return false;
+			}
+			m_writer_pending.store(true);
+			if (has_readers()) {
+				release_writer();
+				return false;
+			}
+			set_write_lock_owner();
+			return true;
+		}
+
+		template<class _Rep, class _Period>
+		bool try_lock_for(const std::chrono::duration<_Rep, _Period>& _Rel_time)
+		{	// try to lock for duration
+			return (try_lock_until(std::chrono::steady_clock::now() + _Rel_time));
+		}
+
+		template<class _Clock, class _Duration>
+		bool try_lock_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time)
+		{	// try to lock until time point
+			if (owns_write_lock()) {
+				m_writelock_count += 1;
+				return true;
+			}
+			if (!m_writer_mutex.try_lock_until(_Abs_time)) {
+				return false;
+			}
+			m_writer_pending.store(true);
+			bool no_readers = false;
+			{
+				std::unique_lock<std::mutex> lock1(m_wait_mutex);
+				no_readers = m_wait_cv.wait_until(lock1, _Abs_time, [this]() { return !has_readers(); });
+			}
+			if (!no_readers) {
+				release_writer();
+				return false;
+			}
+			set_write_lock_owner();
+			return true;
+		}
+
+		void unlock()
+		{	// unlock exclusive
+			assert(owns_write_lock());
+			if (2 <= m_writelock_count) {
+				m_writelock_count -= 1;
+				return;
+			}
+			assert(1 == m_writelock_count);
+			m_writelock_count = 0;
+			m_writelock_thread_id.store(std::thread::id());
+			release_writer();
+		}
+
+		void lock_shared()
+		{	// lock non-exclusive
+			if (increment_existing_readlock_count()) {
+				return;
+			}
+			auto& slot = m_reader_slots[us::impl::async_shared_reader_slot_index()];
+			slot.m_num_readers.fetch_add(1);
+			while (m_writer_pending.load()) {
+				/* Step aside for the writer. */
+				slot.m_num_readers.fetch_sub(1);
+				{
+					std::unique_lock<std::mutex> lock1(m_wait_mutex);
+					m_wait_cv.notify_all();
+					m_wait_cv.wait(lock1, [this]() { return !m_writer_pending.load(); });
+				}
+				slot.m_num_readers.fetch_add(1);
+			}
+			add_readlock_record();
+		}
+
+		bool try_lock_shared()
+		{	// try to lock non-exclusive
+			if (increment_existing_readlock_count()) {
+				return true;
+			}
+			auto& slot = m_reader_slots[us::impl::async_shared_reader_slot_index()];
+			slot.m_num_readers.fetch_add(1);
+			if (m_writer_pending.load()) {
+				unregister_reader(slot);
+				return false;
+			}
+			add_readlock_record();
+			return true;
+		}
+
+		template<class _Rep, class _Period>
+		bool try_lock_shared_for(const std::chrono::duration<_Rep, _Period>& _Rel_time)
+		{	// try to lock non-exclusive for relative time
+			return (try_lock_shared_until(_Rel_time + std::chrono::steady_clock::now()));
+		}
+
+		template<class _Clock, class _Duration>
+		bool try_lock_shared_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time)
+		{	// try to lock non-exclusive until absolute time
+			if (increment_existing_readlock_count()) {
+				return true;
+			}
+			auto& slot = m_reader_slots[us::impl::async_shared_reader_slot_index()];
+			slot.m_num_readers.fetch_add(1);
+			while (m_writer_pending.load()) {
+				slot.m_num_readers.fetch_sub(1);
+				{
+					std::unique_lock<std::mutex> lock1(m_wait_mutex);
+					m_wait_cv.notify_all();
+					if (!m_wait_cv.wait_until(lock1, _Abs_time, [this]() { return !m_writer_pending.load(); })) {
+						return false;
+					}
+				}
+				slot.m_num_readers.fetch_add(1);
+			}
+			add_readlock_record();
+			return true;
+		}
+
+		void unlock_shared()
+		{	// unlock non-exclusive
+			auto& records = tl_readlock_records();
+			const auto found_it = find_readlock_record(records);
+			assert(records.end() != found_it);
+			if (records.end() == found_it) { return; }
+			if (2 <= (*found_it).m_count) {
+				(*found_it).m_count -= 1;
+				return;
+			}
+			records.erase(found_it);
+			unregister_reader(m_reader_slots[us::impl::async_shared_reader_slot_index()]);
+		}
+
+	private:
+		struct CReaderSlot {
+			std::atomic<long> m_num_readers{ 0 };
+			/* Padding to keep different threads' slots out of each others' cache lines. */
+			char m_padding[64 - sizeof(std::atomic<long>)];
+		};
+		/* The (per-thread) read lock recursion count for each mutex the thread holds a read lock on. A thread rarely holds
+		read locks on more than a few mutexes at a time, so a linear search is fine. */
+		struct CReadLockRecord {
+			const distributed_recursive_shared_timed_mutex* m_mutex_ptr;
+			int m_count;
+		};
+		typedef std::vector<CReadLockRecord> readlock_records_t;
+		static readlock_records_t& tl_readlock_records() {
+			static thread_local readlock_records_t tl_records;
+			return tl_records;
+		}
+		readlock_records_t::iterator find_readlock_record(readlock_records_t& records) const {
+			auto it = records.begin();
+			for (; records.end() != it; it++) {
+				if (this == (*it).m_mutex_ptr) { break; }
+			}
+			return it;
+		}
+		bool increment_existing_readlock_count() {
+			auto& records = tl_readlock_records();
+			const auto found_it = find_readlock_record(records);
+			if (records.end() != found_it) {
+				assert(1 <= (*found_it).m_count);
+				(*found_it).m_count += 1;
+				return true;
+			}
+			return false;
+		}
+		void add_readlock_record() {
+			try {
+				tl_readlock_records().push_back(CReadLockRecord{ this, 1 });
+			}
+			catch (...) {
+				unregister_reader(m_reader_slots[us::impl::async_shared_reader_slot_index()]);
+				MSE_THROW(asyncshared_runtime_error("std::vector<>::push_back() failed? - mse::distributed_recursive_shared_timed_mutex"));
+			}
+		}
+		void unregister_reader(CReaderSlot& slot) {
+			slot.m_num_readers.fetch_sub(1);
+			if (m_writer_pending.load()) {
+				/* A writer may be waiting for the readers to drain. */
+				std::lock_guard<std::mutex> lock1(m_wait_mutex);
+				m_wait_cv.notify_all();
+			}
+		}
+		bool has_readers() const {
+			for (const auto& slot : m_reader_slots) {
+				if (0 != slot.m_num_readers.load()) { return true; }
+			}
+			return false;
+		}
+
+		bool owns_write_lock() const {
+			return (std::this_thread::get_id() == m_writelock_thread_id.load(std::memory_order_relaxed));
+		}
+		void set_write_lock_owner() {
+			m_writelock_thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+			m_writelock_count = 1;
+		}
+		void release_writer() {
+			{
+				std::lock_guard<std::mutex> lock1(m_wait_mutex);
+				m_writer_pending.store(false);
+			}
+			m_wait_cv.notify_all();
+			m_writer_mutex.unlock();
+		}
+
+		CReaderSlot m_reader_slots[us::impl::sc_async_shared_num_reader_slots];
+		std::atomic<bool> m_writer_pending{ false };
+		std::timed_mutex m_writer_mutex;
+		std::mutex m_wait_mutex;
+		std::condition_variable m_wait_cv;
+
+		std::atomic<std::thread::id> m_writelock_thread_id{ std::thread::id() };
+		int m_writelock_count = 0;
+	};
+
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+	/* With MSE_ASYNCSHARED_INSTRUMENTATION1 defined, the mutex of each TAsyncSharedObj keeps lock contention statistics,
+	which can be obtained via async_shared_lock_stats_snapshot(). */
+	static const size_t sc_async_shared_lock_stats_num_histogram_buckets = 40;
+
+	class CAsyncSharedLockModeStatsSnapshot {
+	public:
+		uint64_t m_acquisition_count = 0;
+		/* The number of try_lock*() calls that failed (or timed out). */
+		uint64_t m_failed_try_count = 0;
+		uint64_t m_total_wait_nanoseconds = 0;
+		uint64_t m_max_wait_nanoseconds = 0;
+		/* m_wait_histogram[i] is the number of acquisitions that waited at least 2^i (but less than 2^(i+1)) nanoseconds.
+		The first bucket also counts acquisitions that didn't wait at all. */
+		std::array<uint64_t, sc_async_shared_lock_stats_num_histogram_buckets> m_wait_histogram = {};
+		uint64_t m_total_hold_nanoseconds = 0;
+		uint64_t m_max_hold_nanoseconds = 0;
+	};
+	class CAsyncSharedLockStatsSnapshot {
+	public:
+		uint64_t total_wait_nanoseconds() const {
+			return m_reader_stats.m_total_wait_nanoseconds + m_writer_stats.m_total_wait_nanoseconds;
+		}
+
+		/* The address of the TAsyncSharedObj's mutex, which identifies the object. */
+		const void* m_mutex_address = nullptr;
+		CAsyncSharedLockModeStatsSnapshot m_reader_stats;
+		/* Asynchronously granted locks (see TAsyncSharedReadWriteAccessRequester<>::async_writelock_ptr()) are counted
+		as writer acquisitions. */
+		CAsyncSharedLockModeStatsSnapshot m_writer_stats;
+	};
+
+	namespace us {
+		namespace impl {
+			typedef std::chrono::steady_clock async_shared_lock_stats_clock;
+
+			inline uint64_t async_shared_lock_stats_elapsed_nanoseconds(const async_shared_lock_stats_clock::time_point& start_time, const async_shared_lock_stats_clock::time_point& end_time) {
+				const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+				return (0 < nanoseconds) ? uint64_t(nanoseconds) : 0;
+			}
+
+			class CAsyncSharedLockModeStats {
+			public:
+				CAsyncSharedLockModeStats() {
+					for (auto& bucket : m_wait_histogram) {
+						bucket.store(0, std::memory_order_relaxed);
+					}
+				}
+				void note_acquisition(uint64_t wait_nanoseconds) {
+					m_acquisition_count.fetch_add(1, std::memory_order_relaxed);
+					m_total_wait_nanoseconds.fetch_add(wait_nanoseconds, std::memory_order_relaxed);
+					note_max(m_max_wait_nanoseconds, wait_nanoseconds);
+					m_wait_histogram[histogram_bucket(wait_nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+				}
+				void note_failed_try() {
+					m_failed_try_count.fetch_add(1, std::memory_order_relaxed);
+				}
+				void note_hold(uint64_t hold_nanoseconds) {
+					m_total_hold_nanoseconds.fetch_add(hold_nanoseconds, std::memory_order_relaxed);
+					note_max(m_max_hold_nanoseconds, hold_nanoseconds);
+				}
+				CAsyncSharedLockModeStatsSnapshot snapshot() const {
+					CAsyncSharedLockModeStatsSnapshot retval;
+					retval.m_acquisition_count = m_acquisition_count.load(std::memory_order_relaxed);
+					retval.m_failed_try_count = m_failed_try_count.load(std::memory_order_relaxed);
+					retval.m_total_wait_nanoseconds = m_total_wait_nanoseconds.load(std::memory_order_relaxed);
+					retval.m_max_wait_nanoseconds = m_max_wait_nanoseconds.load(std::memory_order_relaxed);
+					for (size_t i = 0; sc_async_shared_lock_stats_num_histogram_buckets > i; i += 1) {
+						retval.m_wait_histogram[i] = m_wait_histogram[i].load(std::memory_order_relaxed);
+					}
+					retval.m_total_hold_nanoseconds = m_total_hold_nanoseconds.load(std::memory_order_relaxed);
+					retval.m_max_hold_nanoseconds = m_max_hold_nanoseconds.load(std::memory_order_relaxed);
+					return retval;
+				}
+
+			private:
+				static size_t histogram_bucket(uint64_t nanoseconds) {
+					size_t retval = 0;
+					while ((1 < nanoseconds) && (sc_async_shared_lock_stats_num_histogram_buckets - 1 > retval)) {
+						nanoseconds >>= 1;
+						retval += 1;
+					}
+					return retval;
+				}
+				static void note_max(std::atomic<uint64_t>& max_ref, uint64_t value) {
+					auto current_max = max_ref.load(std::memory_order_relaxed);
+					while ((current_max < value) && (!max_ref.compare_exchange_weak(current_max, value, std::memory_order_relaxed))) {}
+				}
+
+				std::atomic<uint64_t> m_acquisition_count{ 0 };
+				std::atomic<uint64_t> m_failed_try_count{ 0 };
+				std::atomic<uint64_t> m_total_wait_nanoseconds{ 0 };
+				std::atomic<uint64_t> m_max_wait_nanoseconds{ 0 };
+				std::array<std::atomic<uint64_t>, sc_async_shared_lock_stats_num_histogram_buckets> m_wait_histogram;
+				std::atomic<uint64_t> m_total_hold_nanoseconds{ 0 };
+				std::atomic<uint64_t> m_max_hold_nanoseconds{ 0 };
+			};
+
+			class CAsyncSharedLockStats;
+			/* Keeps track of the (live) CAsyncSharedLockStats objects. */
+			class CAsyncSharedLockStatsRegistry {
+			public:
+				static CAsyncSharedLockStatsRegistry& instance() {
+					static CAsyncSharedLockStatsRegistry s_instance;
+					return s_instance;
+				}
+				void register_stats(const CAsyncSharedLockStats* stats_ptr) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					m_stats_ptrs.insert(stats_ptr);
+				}
+				void unregister_stats(const CAsyncSharedLockStats* stats_ptr) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					m_stats_ptrs.erase(stats_ptr);
+				}
+				inline std::vector<CAsyncSharedLockStatsSnapshot> snapshot() const;
+
+			private:
+				mutable std::mutex m_mutex;
+				std::unordered_set<const CAsyncSharedLockStats*> m_stats_ptrs;
+			};
+
+			class CAsyncSharedLockStats {
+			public:
+				CAsyncSharedLockStats(const void* mutex_address) : m_mutex_address(mutex_address) {
+					CAsyncSharedLockStatsRegistry::instance().register_stats(this);
+				}
+				CAsyncSharedLockStats(const CAsyncSharedLockStats&) = delete;
+				~CAsyncSharedLockStats() {
+					CAsyncSharedLockStatsRegistry::instance().unregister_stats(this);
+				}
+				CAsyncSharedLockStatsSnapshot snapshot() const {
+					CAsyncSharedLockStatsSnapshot retval;
+					retval.m_mutex_address = m_mutex_address;
+					retval.m_reader_stats = m_reader_stats.snapshot();
+					retval.m_writer_stats = m_writer_stats.snapshot();
+					return retval;
+				}
+
+				const void* m_mutex_address;
+				CAsyncSharedLockModeStats m_reader_stats;
+				CAsyncSharedLockModeStats m_writer_stats;
+			};
+
+			inline std::vector<CAsyncSharedLockStatsSnapshot> CAsyncSharedLockStatsRegistry::snapshot() const {
+				std::vector<CAsyncSharedLockStatsSnapshot> retval;
+				std::lock_guard<std::mutex> lock1(m_mutex);
+				retval.reserve(m_stats_ptrs.size());
+				for (const auto stats_ptr : m_stats_ptrs) {
+					retval.push_back(stats_ptr->snapshot());
+				}
+				return retval;
+			}
+
+			/* Each thread keeps track of when it (first) acquired each of the read locks it holds. */
+			class CAsyncSharedReadHoldRecord {
+			public:
+				const void* m_mutex_address;
+				int m_count;
+				async_shared_lock_stats_clock::time_point m_acquisition_time;
+			};
+			inline std::vector<CAsyncSharedReadHoldRecord>& async_shared_thread_read_hold_records() {
+				thread_local std::vector<CAsyncSharedReadHoldRecord> tl_records;
+				return tl_records;
+			}
+		}
+	}
+
+	/* Returns the lock statistics of (up to max_num_objects of) the live TAsyncSharedObjs, most contended (by total wait
+	time) first. */
+	inline std::vector<CAsyncSharedLockStatsSnapshot> async_shared_lock_stats_snapshot(size_t max_num_objects = size_t(-1)) {
+		auto retval = us::impl::CAsyncSharedLockStatsRegistry::instance().snapshot();
+		std::sort(retval.begin(), retval.end(), [](const CAsyncSharedLockStatsSnapshot& a, const CAsyncSharedLockStatsSnapshot& b) {
+			return a.total_wait_nanoseconds() > b.total_wait_nanoseconds();
+		});
+		if (retval.size() > max_num_objects) {
+			retval.resize(max_num_objects);
+		}
+		return retval;
+	}
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+
+	namespace us {
+		namespace impl {
+			/* TAsyncLockQueueMutex wraps the (thread-affine) mutex of TAsyncSharedObj and, if
+			MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS is defined, adds a FIFO queue of asynchronous lock requests. A lock granted to
+			an asynchronous request isn't owned by any thread. It's held until the last reference to its CAsyncLockHold is
+			released, possibly by a different thread than the one that requested it. Asynchronous grants are exclusive with
+			respect to each other and to (synchronous) holders of the wrapped mutex, which register themselves with a couple of
+			atomic operations (on a counter shared by all threads) and only wait (on a condition variable) if an asynchronous
+			grant is outstanding. Grant functions are called from whichever thread makes the lock available (the requesting
+			thread if it's available right away) and should be brief. An exception thrown by a grant function is discarded, so
+			the requesters forward any exceptions to the requesting party themselves.
+			Without MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS, synchronous locking just goes (directly) to the wrapped mutex. */
+			template<typename _TMutex>
+			class TAsyncLockQueueMutex {
+			public:
+				typedef _TMutex base_mutex_type;
+
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				class CAsyncLockHold {
+				public:
+					CAsyncLockHold(TAsyncLockQueueMutex& mutex_ref) : m_mutex_ref(mutex_ref) {}
+					CAsyncLockHold(const CAsyncLockHold&) = delete;
+					~CAsyncLockHold() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_mutex_ref.m_stats.m_writer_stats.note_hold(async_shared_lock_stats_elapsed_nanoseconds(m_grant_time, async_shared_lock_stats_clock::now()));
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_mutex_ref.release_async_lock();
+					}
+				private:
+					TAsyncLockQueueMutex& m_mutex_ref;
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					async_shared_lock_stats_clock::time_point m_grant_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+				};
+				typedef std::function<void(std::shared_ptr<CAsyncLockHold>)> grant_function_type;
+#else // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				/* Never defined or instantiated without MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS. */
+				class CAsyncLockHold;
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+
+				void lock() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					m_base_mutex.lock();
+					register_sync_holder();
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_write_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+				}
+				bool try_lock() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					if (!m_base_mutex.try_lock()) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_writer_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+					if (!try_register_sync_holder()) {
+						unregister_sync_holder_and(&base_mutex_type::unlock);
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_writer_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_write_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					return true;
+				}
+				template<class _Rep, class _Period>
+				bool try_lock_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+					return (try_lock_until(std::chrono::steady_clock::now() + _Rel_time));
+				}
+				template<class _Clock, class _Duration>
+				bool try_lock_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					if (!m_base_mutex.try_lock_until(_Abs_time)) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_writer_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+					if (!try_register_sync_holder_until(_Abs_time)) {
+						unregister_sync_holder_and(&base_mutex_type::unlock);
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_writer_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_write_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					return true;
+				}
+				void unlock() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_write_lock_release();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					unregister_sync_holder_and(&base_mutex_type::unlock);
+				}
+
+				void lock_shared() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					m_base_mutex.lock_shared();
+					register_sync_holder();
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_read_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+				}
+				bool try_lock_shared() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					if (!m_base_mutex.try_lock_shared()) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_reader_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+					if (!try_register_sync_holder()) {
+						unregister_sync_holder_and(&base_mutex_type::unlock_shared);
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_reader_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_read_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					return true;
+				}
+				template<class _Rep, class _Period>
+				bool try_lock_shared_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+					return (try_lock_shared_until(std::chrono::steady_clock::now() + _Rel_time));
+				}
+				template<class _Clock, class _Duration>
+				bool try_lock_shared_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					if (!m_base_mutex.try_lock_shared_until(_Abs_time)) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_reader_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+					if (!try_register_sync_holder_until(_Abs_time)) {
+						unregister_sync_holder_and(&base_mutex_type::unlock_shared);
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+						m_stats.m_reader_stats.note_failed_try();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+						return false;
+					}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_read_lock_acquired(wait_start_time);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					return true;
+				}
+				void unlock_shared() {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					note_read_lock_release();
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					unregister_sync_holder_and(&base_mutex_type::unlock_shared);
+				}
+
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				/* Queues a request for (exclusive) access. grant_function will be called once the request reaches the
+				front of the queue and the lock is available. */
+				void async_lock(grant_function_type grant_function) {
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					const auto wait_start_time = async_shared_lock_stats_clock::now();
+					grant_function = [this, wait_start_time, grant_function](std::shared_ptr<CAsyncLockHold> async_lock_hold_shptr) {
+						m_stats.m_writer_stats.note_acquisition(async_shared_lock_stats_elapsed_nanoseconds(wait_start_time, async_shared_lock_stats_clock::now()));
+						grant_function(std::move(async_lock_hold_shptr));
+					};
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					{
+						std::lock_guard<std::mutex> lock1(m_queue_mutex);
+						m_waiters.push_back(std::move(grant_function));
+						m_num_waiters.fetch_add(1);
+					}
+					dispatch();
+				}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+
+			private:
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				void register_sync_holder() {
+					m_num_sync_holders.fetch_add(1);
+					if (m_async_lock_held.load()) {
+						std::unique_lock<std::mutex> lock1(m_queue_mutex);
+						m_queue_cv.wait(lock1, [this]() { return !m_async_lock_held.load(); });
+					}
+				}
+				bool try_register_sync_holder() {
+					m_num_sync_holders.fetch_add(1);
+					return !m_async_lock_held.load();
+				}
+				template<class _Clock, class _Duration>
+				bool try_register_sync_holder_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+					m_num_sync_holders.fetch_add(1);
+					if (m_async_lock_held.load()) {
+						std::unique_lock<std::mutex> lock1(m_queue_mutex);
+						return m_queue_cv.wait_until(lock1, _Abs_time, [this]() { return !m_async_lock_held.load(); });
+					}
+					return true;
+				}
+				void unregister_sync_holder_and(void (base_mutex_type::*unlock_member_function)()) {
+					m_num_sync_holders.fetch_sub(1);
+					(m_base_mutex.*unlock_member_function)();
+					if (0 != m_num_waiters.load()) {
+						dispatch();
+					}
+				}
+
+				void release_async_lock() {
+					{
+						std::lock_guard<std::mutex> lock1(m_queue_mutex);
+						m_async_lock_held.store(false);
+					}
+					m_queue_cv.notify_all();
+					dispatch();
+				}
+
+				/* Grants queued requests (in order) for as long as the lock is available. Only one thread dispatches at a time,
+				and a dispatch requested (by another thread, or reentrantly by a grant function) while one is in progress is
+				left to the dispatching thread, which re-examines the queue after each grant. */
+				void dispatch() {
+					{
+						std::lock_guard<std::mutex> lock1(m_queue_mutex);
+						if (m_dispatch_in_progress) {
+							return;
+						}
+						m_dispatch_in_progress = true;
+					}
+					while (true) {
+						grant_function_type grant_function;
+						{
+							std::lock_guard<std::mutex> lock1(m_queue_mutex);
+							if (m_waiters.empty() || m_async_lock_held.load()) {
+								m_dispatch_in_progress = false;
+								return;
+							}
+							m_async_lock_held.store(true);
+							if (0 != m_num_sync_holders.load()) {
+								/* A synchronous lock holder got in first. The queue will be dispatched again when it unlocks. */
+								m_async_lock_held.store(false);
+								m_queue_cv.notify_all();
+								m_dispatch_in_progress = false;
+								return;
+							}
+							grant_function = std::move(m_waiters.front());
+							m_waiters.pop_front();
+							m_num_waiters.fetch_sub(1);
+						}
+						try {
+							grant_function(std::make_shared<CAsyncLockHold>(*this));
+						}
+						catch (...) {
+							/* The exception isn't propagated into the (unrelated) operation that made the lock available. The
+							lock hold was released during unwinding, so we just move on to the next request. */
+						}
+					}
+				}
+#else // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				void register_sync_holder() {}
+				bool try_register_sync_holder() { return true; }
+				template<class _Clock, class _Duration>
+				bool try_register_sync_holder_until(const std::chrono::time_point<_Clock, _Duration>&) { return true; }
+				void unregister_sync_holder_and(void (base_mutex_type::*unlock_member_function)()) {
+					(m_base_mutex.*unlock_member_function)();
+				}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+				/* Write locks are only held by one thread at a time, so m_write_lock_count and m_write_lock_acquisition_time
+				are only accessed by the holder. Read lock hold times are tracked per thread. */
+				void note_write_lock_acquired(const async_shared_lock_stats_clock::time_point& wait_start_time) {
+					const auto now = async_shared_lock_stats_clock::now();
+					m_stats.m_writer_stats.note_acquisition(async_shared_lock_stats_elapsed_nanoseconds(wait_start_time, now));
+					if (0 == m_write_lock_count) {
+						m_write_lock_acquisition_time = now;
+					}
+					m_write_lock_count += 1;
+				}
+				void note_write_lock_release() {
+					m_write_lock_count -= 1;
+					if (0 == m_write_lock_count) {
+						m_stats.m_writer_stats.note_hold(async_shared_lock_stats_elapsed_nanoseconds(m_write_lock_acquisition_time, async_shared_lock_stats_clock::now()));
+					}
+				}
+				void note_read_lock_acquired(const async_shared_lock_stats_clock::time_point& wait_start_time) {
+					const auto now = async_shared_lock_stats_clock::now();
+					m_stats.m_reader_stats.note_acquisition(async_shared_lock_stats_elapsed_nanoseconds(wait_start_time, now));
+					auto& records_ref = async_shared_thread_read_hold_records();
+					for (auto& record_ref : records_ref) {
+						if (this == record_ref.m_mutex_address) {
+							record_ref.m_count += 1;
+							return;
+						}
+					}
+					records_ref.push_back(CAsyncSharedReadHoldRecord{ this, 1, now });
+				}
+				void note_read_lock_release() {
+					auto& records_ref = async_shared_thread_read_hold_records();
+					for (auto it = records_ref.begin(); records_ref.end() != it; it++) {
+						if (this == (*it).m_mutex_address) {
+							(*it).m_count -= 1;
+							if (0 == (*it).m_count) {
+								m_stats.m_reader_stats.note_hold(async_shared_lock_stats_elapsed_nanoseconds((*it).m_acquisition_time, async_shared_lock_stats_clock::now()));
+								records_ref.erase(it);
+							}
+							return;
+						}
+					}
+				}
+
+				CAsyncSharedLockStats m_stats{ this };
+				int m_write_lock_count = 0;
+				async_shared_lock_stats_clock::time_point m_write_lock_acquisition_time;
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+
+				base_mutex_type m_base_mutex;
+
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+				std::atomic<int> m_num_sync_holders{ 0 };
+				std::atomic<bool> m_async_lock_held{ false };
+				std::atomic<int> m_num_waiters{ 0 };
+				std::mutex m_queue_mutex;
+				std::condition_variable m_queue_cv;
+				std::deque<grant_function_type> m_waiters;
+				bool m_dispatch_in_progress = false;
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+			};
+
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+			/* Calls the given function, storing any exception it throws in the given promise (unless the promise has
+			already been satisfied). */
+			template<class _TPromise, class _TFunction>
+			void async_lock_grant_forwarding_exceptions(_TPromise& promise_ref, const _TFunction& function) {
+				try {
+					function();
+				}
+				catch (...) {
+					try {
+						promise_ref.set_exception(std::current_exception());
+					}
+					catch (...) {}
+				}
+			}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+		}
+	}
+
+#ifdef MSE_ASYNCSHARED_USE_DISTRIBUTED_MUTEX
+	typedef distributed_recursive_shared_timed_mutex async_shared_timed_base_mutex_type;
+#else // MSE_ASYNCSHARED_USE_DISTRIBUTED_MUTEX
+	//typedef std::shared_timed_mutex async_shared_timed_base_mutex_type;
+	typedef recursive_shared_timed_mutex async_shared_timed_base_mutex_type;
+#endif // MSE_ASYNCSHARED_USE_DISTRIBUTED_MUTEX
+	/* Defining MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS enables the asynchronous lock requests of TAsyncSharedReadWriteAccessRequester
+	(async_writelock_ptr() and async_readlock_ptr()), at the cost of every synchronous lock and unlock also updating a
+	counter shared by all threads. */
+	typedef us::impl::TAsyncLockQueueMutex<async_shared_timed_base_mutex_type> async_shared_timed_mutex_type;
+
+	namespace us {
+		namespace impl {
+			struct CAsyncSharedLockOrderingKeyGetter;
+			struct CAsyncSharedSeqLockLeaseGetter;
+		}
+	}
 
 	template<typename _Ty> class TAsyncSharedReadWriteAccessRequester;
 	template<typename _Ty> class TAsyncSharedReadWritePointer;
@@ -290,11 +1127,12 @@ namespace mse {
 	template<typename _Ty> class TAsyncSharedReadOnlyAccessRequester;
 	template<typename _Ty> class TAsyncSharedReadOnlyConstPointer;
 
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer;
+	/* The second template parameter selects the (lock-free) specializations for small, trivially copyable types. */
+	template<typename _Ty, typename = void> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester;
+	template<typename _Ty, typename = void> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer;
+	template<typename _Ty, typename = void> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
+	template<typename _Ty, typename = void> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester;
+	template<typename _Ty, typename = void> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer;
 
 	/* TAsyncSharedObj is intended as a transparent wrapper for other classes/objects. */
 	template<typename _TROy>
@@ -341,7 +1179,11 @@ namespace mse {
 	template<typename _Ty>
 	class TAsyncSharedReadWritePointer {
 	public:
-		TAsyncSharedReadWritePointer(const TAsyncSharedReadWritePointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {}
+		TAsyncSharedReadWritePointer(const TAsyncSharedReadWritePointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1, std::defer_lock), m_async_lock_hold_shptr(src.m_async_lock_hold_shptr) {
+			if (!m_async_lock_hold_shptr) {
+				m_unique_lock.lock();
+			}
+		}
 		TAsyncSharedReadWritePointer(TAsyncSharedReadWritePointer&& src) = default;
 		virtual ~TAsyncSharedReadWritePointer() {}
 
@@ -361,21 +1203,24 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		/* Constructs a pointer that shares an asynchronously granted lock. */
+		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr)
+			: m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock), m_async_lock_hold_shptr(std::move(async_lock_hold_shptr)) {}
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadWritePointer<_Ty>& operator=(const TAsyncSharedReadWritePointer<_Ty>& _Right_cref) = delete;
@@ -390,6 +1235,7 @@ namespace mse {
 
 		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
 		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
+		std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> m_async_lock_hold_shptr;
 
 		friend class TAsyncSharedReadWriteAccessRequester<_Ty>;
 		friend class TAsyncSharedReadWriteConstPointer<_Ty>;
@@ -398,9 +1244,17 @@ namespace mse {
 	template<typename _Ty>
 	class TAsyncSharedReadWriteConstPointer {
 	public:
-		TAsyncSharedReadWriteConstPointer(const TAsyncSharedReadWriteConstPointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {}
+		TAsyncSharedReadWriteConstPointer(const TAsyncSharedReadWriteConstPointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1, std::defer_lock), m_async_lock_hold_shptr(src.m_async_lock_hold_shptr) {
+			if (!m_async_lock_hold_shptr) {
+				m_unique_lock.lock();
+			}
+		}
 		TAsyncSharedReadWriteConstPointer(TAsyncSharedReadWriteConstPointer&& src) = default;
-		TAsyncSharedReadWriteConstPointer(const TAsyncSharedReadWritePointer<_Ty>& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {}
+		TAsyncSharedReadWriteConstPointer(const TAsyncSharedReadWritePointer<_Ty>& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1, std::defer_lock), m_async_lock_hold_shptr(src.m_async_lock_hold_shptr) {
+			if (!m_async_lock_hold_shptr) {
+				m_unique_lock.lock();
+			}
+		}
 		virtual ~TAsyncSharedReadWriteConstPointer() {}
 
 		operator bool() const {
@@ -419,21 +1273,24 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		/* Constructs a pointer that shares an asynchronously granted lock. */
+		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr)
+			: m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock), m_async_lock_hold_shptr(std::move(async_lock_hold_shptr)) {}
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadWriteConstPointer<_Ty>& operator=(const TAsyncSharedReadWriteConstPointer<_Ty>& _Right_cref) = delete;
@@ -448,6 +1305,7 @@ namespace mse {
 
 		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
 		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
+		std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> m_async_lock_hold_shptr;
 
 		friend class TAsyncSharedReadWriteAccessRequester<_Ty>;
 	};
@@ -510,6 +1368,65 @@ namespace mse {
 			return retval;
 		}
 
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+		/* The "async" versions (available when MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS is defined) don't block the calling
+		thread. Requests are queued (in FIFO order) and granted when the object becomes available. The returned future
+		becomes ready, or the given callback is called (with the pointer as its argument), at that point. Callbacks are called
+		from whichever thread makes the object available, so they should be brief (or hand the pointer off to, say, a thread
+		pool). The future returned by the callback versions becomes ready once the callback returns, and holds the exception
+		if the callback throws. Unlike the ones returned by writelock_ptr(), these pointers can be passed to, and released by,
+		other threads. */
+		std::future<TAsyncSharedReadWritePointer<_Ty>> async_writelock_ptr() {
+			auto promise_shptr = std::make_shared<std::promise<TAsyncSharedReadWritePointer<_Ty>>>();
+			auto retval = promise_shptr->get_future();
+			auto shptr = m_shptr;
+			m_shptr->m_mutex1.async_lock([promise_shptr, shptr](std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr) {
+				us::impl::async_lock_grant_forwarding_exceptions(*promise_shptr, [&]() {
+					promise_shptr->set_value(TAsyncSharedReadWritePointer<_Ty>(shptr, std::move(async_lock_hold_shptr)));
+				});
+			});
+			return retval;
+		}
+		template<class _TCallback>
+		std::future<void> async_writelock_ptr(const _TCallback& callback) {
+			auto promise_shptr = std::make_shared<std::promise<void>>();
+			auto retval = promise_shptr->get_future();
+			auto shptr = m_shptr;
+			m_shptr->m_mutex1.async_lock([callback, promise_shptr, shptr](std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr) {
+				us::impl::async_lock_grant_forwarding_exceptions(*promise_shptr, [&]() {
+					callback(TAsyncSharedReadWritePointer<_Ty>(shptr, std::move(async_lock_hold_shptr)));
+					promise_shptr->set_value();
+				});
+			});
+			return retval;
+		}
+		/* As with readlock_ptr(), read access is exclusive (the object might have unprotected mutable members). */
+		std::future<TAsyncSharedReadWriteConstPointer<_Ty>> async_readlock_ptr() {
+			auto promise_shptr = std::make_shared<std::promise<TAsyncSharedReadWriteConstPointer<_Ty>>>();
+			auto retval = promise_shptr->get_future();
+			auto shptr = m_shptr;
+			m_shptr->m_mutex1.async_lock([promise_shptr, shptr](std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr) {
+				us::impl::async_lock_grant_forwarding_exceptions(*promise_shptr, [&]() {
+					promise_shptr->set_value(TAsyncSharedReadWriteConstPointer<_Ty>(shptr, std::move(async_lock_hold_shptr)));
+				});
+			});
+			return retval;
+		}
+		template<class _TCallback>
+		std::future<void> async_readlock_ptr(const _TCallback& callback) {
+			auto promise_shptr = std::make_shared<std::promise<void>>();
+			auto retval = promise_shptr->get_future();
+			auto shptr = m_shptr;
+			m_shptr->m_mutex1.async_lock([callback, promise_shptr, shptr](std::shared_ptr<async_shared_timed_mutex_type::CAsyncLockHold> async_lock_hold_shptr) {
+				us::impl::async_lock_grant_forwarding_exceptions(*promise_shptr, [&]() {
+					callback(TAsyncSharedReadWriteConstPointer<_Ty>(shptr, std::move(async_lock_hold_shptr)));
+					promise_shptr->set_value();
+				});
+			});
+			return retval;
+		}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+
 		template <class... Args>
 		static TAsyncSharedReadWriteAccessRequester make(Args&&... args) {
 			//auto shptr = std::make_shared<TAsyncSharedObj<_Ty>>(std::forward<Args>(args)...);
@@ -527,6 +1444,7 @@ namespace mse {
 		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
 
 		friend class TAsyncSharedReadOnlyAccessRequester<_Ty>;
+		friend struct us::impl::CAsyncSharedLockOrderingKeyGetter;
 	};
 
 	template <class X, class... Args>
@@ -560,19 +1478,19 @@ namespace mse {
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadOnlyConstPointer<_Ty>& operator=(const TAsyncSharedReadOnlyConstPointer<_Ty>& _Right_cref) = delete;
@@ -647,9 +1565,7 @@ namespace mse {
 	}
 
 
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
-
-	template<typename _Ty>
+	template<typename _Ty, typename>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {}
@@ -674,19 +1590,19 @@ namespace mse {
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& _Right_cref) = delete;
@@ -706,7 +1622,7 @@ namespace mse {
 		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, typename>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
@@ -732,19 +1648,19 @@ namespace mse {
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& _Right_cref) = delete;
@@ -763,7 +1679,7 @@ namespace mse {
 		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, typename>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester& src_cref) = default;
@@ -836,6 +1752,9 @@ namespace mse {
 		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>* operator&() const { return this; }
 
 		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
+
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>;
+		friend struct us::impl::CAsyncSharedLockOrderingKeyGetter;
 	};
 
 	template <class X, class... Args>
@@ -844,10 +1763,14 @@ namespace mse {
 	}
 
 
-	template<typename _Ty>
+	template<typename _Ty, typename>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer {
 	public:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1, std::defer_lock) {
+			if (src.m_shared_lock.owns_lock()) {
+				m_shared_lock.lock();
+			}
+		}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer&& src) = default;
 		virtual ~TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer() {}
 
@@ -867,21 +1790,23 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		/* An object that can never be modified doesn't need to be locked. */
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr, us::impl::immutable_payload_tag) : m_shptr(shptr) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& _Right_cref) = delete;
@@ -900,16 +1825,22 @@ namespace mse {
 		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, typename>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester& src_cref) = default;
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>& src_cref) : m_shptr(src_cref.m_shptr) {}
 
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty> readlock_ptr() {
+			if (m_payload_is_immutable) {
+				return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, us::impl::immutable_payload_tag());
+			}
 			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr);
 		}
 		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr() {
+			if (m_payload_is_immutable) {
+				return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>>(readlock_ptr());
+			}
 			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock));
 			if (!((*retval).is_valid())) {
 				return{};
@@ -918,6 +1849,9 @@ namespace mse {
 		}
 		template<class _Rep, class _Period>
 		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			if (m_payload_is_immutable) {
+				return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>>(readlock_ptr());
+			}
 			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock, _Rel_time));
 			if (!((*retval).is_valid())) {
 				return{};
@@ -926,6 +1860,9 @@ namespace mse {
 		}
 		template<class _Clock, class _Duration>
 		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			if (m_payload_is_immutable) {
+				return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>>(readlock_ptr());
+			}
 			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock, _Abs_time));
 			if (!((*retval).is_valid())) {
 				return{};
@@ -938,6 +1875,8 @@ namespace mse {
 			//auto shptr = std::make_shared<const TAsyncSharedObj<_Ty>>(std::forward<Args>(args)...);
 			std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr(new const TAsyncSharedObj<_Ty>(std::forward<Args>(args)...));
 			TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester retval(shptr);
+			/* No read-write access requester refers to this object, so it will never be modified. */
+			retval.m_payload_is_immutable = true;
 			return retval;
 		}
 
@@ -948,6 +1887,7 @@ namespace mse {
 		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>* operator&() const { return this; }
 
 		std::shared_ptr<const TAsyncSharedObj<_Ty>> m_shptr;
+		bool m_payload_is_immutable = false;
 	};
 
 	template <class X, class... Args>
@@ -956,25 +1896,393 @@ namespace mse {
 	}
 
 
-	/* For "read-only" situations when you need, or want, the shared object to be managed by std::shared_ptrs we provide a
-	slightly safety enhanced std::shared_ptr wrapper. The wrapper enforces "const"ness and tries to ensure that it always
-	points to a validly allocated object. Use mse::make_stdsharedimmutable<>() to construct an
-	mse::TStdSharedImmutableFixedPointer. And again, beware of sharing objects with mutable members. */
-	template<typename _Ty>
-	class TStdSharedImmutableFixedPointer : public std::shared_ptr<const _Ty> {
-	public:
-		TStdSharedImmutableFixedPointer(const TStdSharedImmutableFixedPointer& src_cref) : std::shared_ptr<const _Ty>(src_cref) {}
-		virtual ~TStdSharedImmutableFixedPointer() {}
-		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
-		explicit operator const _Ty*() const { return std::shared_ptr<const _Ty>::operator _Ty*(); }
-
-		template <class... Args>
-		static TStdSharedImmutableFixedPointer make(Args&&... args) {
-			TStdSharedImmutableFixedPointer retval(std::make_shared<const _Ty>(std::forward<Args>(args)...));
-			return retval;
-		}
+	/* Small trivially copyable objects don't need a mutex. For them, the "ThatYouAreSureHasNoUnprotectedMutables" access
+	requesters are specialized to keep the (committed) value in a sequence lock. A read pointer holds its own snapshot
+	copy of the value, obtained without any locking (a reader only retries if it overlaps with the brief commit of a
+	write). A write pointer holds exclusive write access, obtained with an atomic exchange rather than a mutex, and
+	modifies a private copy of the value, which is committed when the (last copy of the) write pointer is destroyed. So
+	readers never wait for writers (they just see the last committed value) and writers never wait for readers. As with
+	the mutex based versions, write pointers shouldn't be passed to other threads. */
+	namespace us {
+		namespace impl {
+			template<typename _Ty>
+			struct is_async_shared_seqlock_eligible : std::integral_constant<bool, std::is_trivially_copyable<_Ty>::value
+				&& (16 >= sizeof(_Ty)) && (!std::is_const<_Ty>::value)> {};
+
+			template<typename _Ty>
+			class TAsyncSharedSeqLockState : public std::enable_shared_from_this<TAsyncSharedSeqLockState<_Ty>> {
+			public:
+				template <class... Args>
+				TAsyncSharedSeqLockState(Args&&... args) {
+					store_value(_Ty(std::forward<Args>(args)...));
+				}
 
-	private:
+				_Ty load() const {
+					word_t words[sc_num_words];
+					for (int spin_count = 0; ; spin_count += 1) {
+						const auto sequence1 = m_sequence.load(std::memory_order_acquire);
+						if (0 == (sequence1 & 1)) {
+							for (size_t i = 0; i < sc_num_words; i += 1) {
+								words[i] = m_words[i].load(std::memory_order_relaxed);
+							}
+							std::atomic_thread_fence(std::memory_order_acquire);
+							if (m_sequence.load(std::memory_order_relaxed) == sequence1) {
+								break;
+							}
+						}
+						if (64 <= spin_count) {
+							std::this_thread::yield();
+						}
+					}
+					typename std::aligned_storage<sizeof(_Ty), std::alignment_of<_Ty>::value>::type storage;
+					std::memcpy(std::addressof(storage), words, sizeof(_Ty));
+					return *reinterpret_cast<const _Ty*>(std::addressof(storage));
+				}
+
+				/* A write session holds exclusive write access and the (pending) value being modified. The value is
+				committed when the session is destroyed. */
+				class CWriteSession {
+				public:
+					CWriteSession(const std::shared_ptr<TAsyncSharedSeqLockState>& state_shptr) : m_state_shptr(state_shptr), m_value(state_shptr->load()) {}
+					~CWriteSession() {
+						m_state_shptr->end_write_session(m_value);
+					}
+
+					std::shared_ptr<TAsyncSharedSeqLockState> m_state_shptr;
+					_Ty m_value;
+				};
+
+				std::shared_ptr<CWriteSession> write_session() {
+					auto retval = joined_write_session();
+					if (!retval) {
+						for (int spin_count = 0; !try_acquire_writer(); spin_count += 1) {
+							backoff(spin_count);
+						}
+						retval = begin_write_session();
+					}
+					return retval;
+				}
+				/* Returns null if exclusive write access couldn't be obtained. */
+				std::shared_ptr<CWriteSession> try_write_session() {
+					auto retval = joined_write_session();
+					if ((!retval) && try_acquire_writer()) {
+						retval = begin_write_session();
+					}
+					return retval;
+				}
+				template<class _Clock, class _Duration>
+				std::shared_ptr<CWriteSession> try_write_session_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+					auto retval = joined_write_session();
+					if (!retval) {
+						for (int spin_count = 0; !try_acquire_writer(); spin_count += 1) {
+							if (_Clock::now() >= _Abs_time) {
+								return retval;
+							}
+							backoff(spin_count);
+						}
+						retval = begin_write_session();
+					}
+					return retval;
+				}
+
+			private:
+				typedef std::uint64_t word_t;
+				static const size_t sc_num_words = (sizeof(_Ty) + sizeof(word_t) - 1) / sizeof(word_t);
+
+				/* Must only be called by the holder of exclusive write access (or the constructor). */
+				void store_value(const _Ty& value) {
+					word_t words[sc_num_words] = {};
+					std::memcpy(words, std::addressof(value), sizeof(_Ty));
+					const auto sequence = m_sequence.load(std::memory_order_relaxed);
+					m_sequence.store(sequence + 1, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_release);
+					for (size_t i = 0; i < sc_num_words; i += 1) {
+						m_words[i].store(words[i], std::memory_order_relaxed);
+					}
+					m_sequence.store(sequence + 2, std::memory_order_release);
+				}
+
+				bool try_acquire_writer() {
+					bool expected = false;
+					if (m_writer_flag.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+						m_writer_thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+						return true;
+					}
+					return false;
+				}
+				static void backoff(int spin_count) {
+					if (64 > spin_count) {
+						std::this_thread::yield();
+					}
+					else {
+						std::this_thread::sleep_for(std::chrono::microseconds(50));
+					}
+				}
+				/* Write access is recursive. A thread that already has a write session just gets another reference to it. */
+				std::shared_ptr<CWriteSession> joined_write_session() {
+					if (std::this_thread::get_id() == m_writer_thread_id.load(std::memory_order_relaxed)) {
+						return m_session_wptr.lock();
+					}
+					return nullptr;
+				}
+				std::shared_ptr<CWriteSession> begin_write_session() {
+					try {
+						auto retval = std::make_shared<CWriteSession>(this->shared_from_this());
+						m_session_wptr = retval;
+						return retval;
+					}
+					catch (...) {
+						m_writer_thread_id.store(std::thread::id(), std::memory_order_relaxed);
+						m_writer_flag.store(false, std::memory_order_release);
+						throw;
+					}
+				}
+				void end_write_session(const _Ty& value) {
+					store_value(value);
+					m_session_wptr.reset();
+					m_writer_thread_id.store(std::thread::id(), std::memory_order_relaxed);
+					m_writer_flag.store(false, std::memory_order_release);
+				}
+
+				std::atomic<std::uint64_t> m_sequence{ 0 };
+				std::atomic<word_t> m_words[sc_num_words];
+
+				std::atomic<bool> m_writer_flag{ false };
+				std::atomic<std::thread::id> m_writer_thread_id{ std::thread::id() };
+				std::weak_ptr<CWriteSession> m_session_wptr;
+			};
+		}
+	}
+
+	template<typename _Ty>
+	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, typename std::enable_if<us::impl::is_async_shared_seqlock_eligible<_Ty>::value>::type> {
+	public:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer& src) = default;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer&& src) = default;
+		virtual ~TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer() {}
+
+		operator bool() const {
+			return m_session_shptr.operator bool();
+		}
+		_Ty& operator*() const {
+			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer")); }
+			return (*m_session_shptr).m_value;
+		}
+		_Ty* operator->() const {
+			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer")); }
+			return std::addressof((*m_session_shptr).m_value);
+		}
+	private:
+		typedef typename us::impl::TAsyncSharedSeqLockState<_Ty>::CWriteSession write_session_type;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<write_session_type> session_shptr) : m_session_shptr(std::move(session_shptr)) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>&& _Right) = delete;
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>* operator&() const { return this; }
+		bool is_valid() const {
+			bool retval = m_session_shptr.operator bool();
+			return retval;
+		}
+
+		std::shared_ptr<write_session_type> m_session_shptr;
+
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, typename std::enable_if<us::impl::is_async_shared_seqlock_eligible<_Ty>::value>::type> {
+	public:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer& src) = default;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer&& src) = default;
+		/* A const pointer obtained from a write pointer refers to the write pointer's (pending) value. */
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& src) : m_session_shptr(src.m_session_shptr) {}
+		virtual ~TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer() {}
+
+		operator bool() const {
+			return true;
+		}
+		const _Ty& operator*() const {
+			return m_session_shptr ? (*m_session_shptr).m_value : m_snapshot;
+		}
+		const _Ty* operator->() const {
+			return std::addressof(operator*());
+		}
+	private:
+		typedef typename us::impl::TAsyncSharedSeqLockState<_Ty>::CWriteSession write_session_type;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const _Ty& snapshot) : m_snapshot(snapshot) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>&& _Right) = delete;
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>* operator&() const { return this; }
+
+		/* Unlike the snapshot, the pending value of a write session stays put when the pointer is copied. */
+		std::shared_ptr<const _Ty> stable_value_shptr() const {
+			if (m_session_shptr) {
+				return std::shared_ptr<const _Ty>(m_session_shptr, std::addressof((*m_session_shptr).m_value));
+			}
+			return std::make_shared<const _Ty>(m_snapshot);
+		}
+
+		std::shared_ptr<write_session_type> m_session_shptr;
+		_Ty m_snapshot;
+
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>;
+		friend struct us::impl::CAsyncSharedSeqLockLeaseGetter;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, typename std::enable_if<us::impl::is_async_shared_seqlock_eligible<_Ty>::value>::type> {
+	public:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester& src_cref) = default;
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty> writelock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(m_shptr->write_session());
+		}
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr() {
+			auto session_shptr = m_shptr->try_write_session();
+			if (!session_shptr) {
+				return{};
+			}
+			return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>>(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(std::move(session_shptr)));
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_writelock_ptr_until(std::chrono::steady_clock::now() + _Rel_time);
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			auto session_shptr = m_shptr->try_write_session_until(_Abs_time);
+			if (!session_shptr) {
+				return{};
+			}
+			return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>>(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(std::move(session_shptr)));
+		}
+		/* Read pointers never block, so the "try" versions always succeed. */
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty> readlock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>(m_shptr->load());
+		}
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr() {
+			return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>>(readlock_ptr());
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_readlock_ptr();
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			return try_readlock_ptr();
+		}
+
+		template <class... Args>
+		static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester make(Args&&... args) {
+			TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester retval(std::make_shared<us::impl::TAsyncSharedSeqLockState<_Ty>>(std::forward<Args>(args)...));
+			return retval;
+		}
+
+	private:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(std::shared_ptr<us::impl::TAsyncSharedSeqLockState<_Ty>> shptr) : m_shptr(shptr) {}
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<us::impl::TAsyncSharedSeqLockState<_Ty>> m_shptr;
+
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>;
+		friend struct us::impl::CAsyncSharedLockOrderingKeyGetter;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, typename std::enable_if<us::impl::is_async_shared_seqlock_eligible<_Ty>::value>::type> {
+	public:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer& src) = default;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer&& src) = default;
+		virtual ~TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer() {}
+
+		operator bool() const {
+			return true;
+		}
+		const _Ty& operator*() const {
+			return m_snapshot;
+		}
+		const _Ty* operator->() const {
+			return std::addressof(m_snapshot);
+		}
+	private:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(const _Ty& snapshot) : m_snapshot(snapshot) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>&& _Right) = delete;
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<const _Ty> stable_value_shptr() const { return std::make_shared<const _Ty>(m_snapshot); }
+
+		_Ty m_snapshot;
+
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>;
+		friend struct us::impl::CAsyncSharedSeqLockLeaseGetter;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, typename std::enable_if<us::impl::is_async_shared_seqlock_eligible<_Ty>::value>::type> {
+	public:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester& src_cref) = default;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>& src_cref) : m_shptr(src_cref.m_shptr) {}
+
+		/* Read pointers never block, so the "try" versions always succeed. */
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty> readlock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr->load());
+		}
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr() {
+			return mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>>(readlock_ptr());
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_readlock_ptr();
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			return try_readlock_ptr();
+		}
+
+		template <class... Args>
+		static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester make(Args&&... args) {
+			TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester retval(std::make_shared<us::impl::TAsyncSharedSeqLockState<_Ty>>(std::forward<Args>(args)...));
+			return retval;
+		}
+
+	private:
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(std::shared_ptr<us::impl::TAsyncSharedSeqLockState<_Ty>> shptr) : m_shptr(shptr) {}
+
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<us::impl::TAsyncSharedSeqLockState<_Ty>> m_shptr;
+	};
+
+
+	/* For "read-only" situations when you need, or want, the shared object to be managed by std::shared_ptrs we provide a
+	slightly safety enhanced std::shared_ptr wrapper. The wrapper enforces "const"ness and tries to ensure that it always
+	points to a validly allocated object. Use mse::make_stdsharedimmutable<>() to construct an
+	mse::TStdSharedImmutableFixedPointer. And again, beware of sharing objects with mutable members. */
+	template<typename _Ty>
+	class TStdSharedImmutableFixedPointer : public std::shared_ptr<const _Ty> {
+	public:
+		TStdSharedImmutableFixedPointer(const TStdSharedImmutableFixedPointer& src_cref) : std::shared_ptr<const _Ty>(src_cref) {}
+		virtual ~TStdSharedImmutableFixedPointer() {}
+		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
+		explicit operator const _Ty*() const { return std::shared_ptr<const _Ty>::operator _Ty*(); }
+
+		template <class... Args>
+		static TStdSharedImmutableFixedPointer make(Args&&... args) {
+			TStdSharedImmutableFixedPointer retval(std::make_shared<const _Ty>(std::forward<Args>(args)...));
+			return retval;
+		}
+
+	private:
 		TStdSharedImmutableFixedPointer(std::shared_ptr<const _Ty> shptr) : std::shared_ptr<const _Ty>(shptr) {}
 		TStdSharedImmutableFixedPointer<_Ty>& operator=(const TStdSharedImmutableFixedPointer<_Ty>& _Right_cref) = delete;
 
@@ -995,6 +2303,345 @@ namespace mse {
 	}
 
 
+	/* TAsyncSharedRCUAccessRequester is an RCU ("read-copy-update") style alternative to
+	TAsyncSharedReadOnlyAccessRequester, intended for read-mostly objects (configuration, routing tables, etc.) that
+	are read by many threads and only occasionally replaced. Obtaining a read pointer doesn't involve any mutex. Instead
+	readlock_ptr() (wait-free) returns a snapshot pointer to the current version of the object. Published versions are
+	never modified. Writers publish a whole new version (via publish() or update()), and a superseded version is
+	destroyed once the last snapshot pointer referring to it is gone. Since the versions are shared without any locking,
+	beware of sharing objects with (unprotected) mutable members. */
+
+	template<typename _Ty> class TAsyncSharedRCUAccessRequester;
+	template<typename _Ty> class TAsyncSharedRCUReadOnlyAccessRequester;
+	template<typename _Ty> class TAsyncSharedRCUConstPointer;
+
+	namespace us {
+		namespace impl {
+			template<typename _Ty>
+			class TAsyncSharedRCUVersion {
+			public:
+				template <class... Args>
+				TAsyncSharedRCUVersion(Args&&... args) : m_value(std::forward<Args>(args)...) {}
+				TAsyncSharedRCUVersion(const TAsyncSharedRCUVersion&) = delete;
+
+				void add_ref() { m_ref_count.fetch_add(1, std::memory_order_relaxed); }
+				void release() {
+					if (1 == m_ref_count.fetch_sub(1, std::memory_order_acq_rel)) {
+						delete this;
+					}
+				}
+
+				const _Ty m_value;
+
+			private:
+				/* The initial reference is the one held on behalf of the publisher. It is released only after the version
+				has been superseded and all readers that might have obtained (but not yet counted) it have moved on. */
+				std::atomic<long> m_ref_count{ 1 };
+			};
+
+			template<typename _Ty>
+			class TAsyncSharedRCUState {
+			public:
+				typedef TAsyncSharedRCUVersion<_Ty> version_type;
+
+				template <class... Args>
+				TAsyncSharedRCUState(Args&&... args) : m_current_ptr(new version_type(std::forward<Args>(args)...)) {}
+				~TAsyncSharedRCUState() {
+					m_current_ptr.load()->release();
+				}
+
+				/* Returns the current version with a reference added on behalf of the caller. The reader's "critical
+				section" is just long enough to add that reference, and is recorded in a (per-thread) reader slot rather
+				than in any shared lock. */
+				version_type* acquire_current() {
+					auto& slot = m_reader_slots[async_shared_reader_slot_index()];
+					const auto parity = m_parity.load();
+					slot.m_num_readers[parity].fetch_add(1);
+					version_type* retval = m_current_ptr.load();
+					retval->add_ref();
+					slot.m_num_readers[parity].fetch_sub(1, std::memory_order_release);
+					return retval;
+				}
+
+				template <class... Args>
+				void publish(Args&&... args) {
+					std::unique_ptr<version_type> new_version_uqptr(new version_type(std::forward<Args>(args)...));
+					std::lock_guard<std::mutex> lock1(m_write_mutex);
+					replace_current(new_version_uqptr.release());
+				}
+				template<class _TFunction>
+				void update(const _TFunction& func) {
+					std::lock_guard<std::mutex> lock1(m_write_mutex);
+					_Ty new_value(m_current_ptr.load()->m_value);
+					func(new_value);
+					replace_current(new version_type(std::move(new_value)));
+				}
+
+			private:
+				/* Must be called with m_write_mutex held. */
+				void replace_current(version_type* new_version_ptr) {
+					version_type* old_version_ptr = m_current_ptr.exchange(new_version_ptr);
+					/* Any reader that obtained the old version without (yet) adding a reference is still registered
+					in one of the reader slots. We flip the parity (twice) so that new readers don't hold up the wait. */
+					wait_for_readers();
+					wait_for_readers();
+					old_version_ptr->release();
+				}
+				void wait_for_readers() {
+					const auto old_parity = m_parity.load();
+					m_parity.store(1 - old_parity);
+					for (auto& slot : m_reader_slots) {
+						while (0 != slot.m_num_readers[old_parity].load()) {
+							std::this_thread::yield();
+						}
+					}
+				}
+
+				struct CReaderSlot {
+					std::atomic<long> m_num_readers[2] = { {0}, {0} };
+					/* Padding to keep different threads' slots out of each others' cache lines. */
+					char m_padding[64 - 2 * sizeof(std::atomic<long>)];
+				};
+
+				std::atomic<version_type*> m_current_ptr;
+				std::atomic<int> m_parity{ 0 };
+				CReaderSlot m_reader_slots[sc_async_shared_num_reader_slots];
+				std::mutex m_write_mutex;
+			};
+		}
+	}
+
+	template<typename _Ty>
+	class TAsyncSharedRCUConstPointer {
+	public:
+		TAsyncSharedRCUConstPointer(const TAsyncSharedRCUConstPointer& src) : m_version_ptr(src.m_version_ptr) {
+			if (m_version_ptr) { m_version_ptr->add_ref(); }
+		}
+		TAsyncSharedRCUConstPointer(TAsyncSharedRCUConstPointer&& src) : m_version_ptr(src.m_version_ptr) {
+			src.m_version_ptr = nullptr;
+		}
+		virtual ~TAsyncSharedRCUConstPointer() {
+			if (m_version_ptr) { m_version_ptr->release(); }
+		}
+
+		operator bool() const {
+			return (nullptr != m_version_ptr);
+		}
+		const _Ty& operator*() const {
+			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedRCUConstPointer")); }
+			return m_version_ptr->m_value;
+		}
+		const _Ty* operator->() const {
+			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedRCUConstPointer")); }
+			return std::addressof(m_version_ptr->m_value);
+		}
+	private:
+		typedef us::impl::TAsyncSharedRCUVersion<_Ty> version_type;
+		/* Takes ownership of a reference that has already been added. */
+		TAsyncSharedRCUConstPointer(version_type* version_ptr) : m_version_ptr(version_ptr) {}
+		TAsyncSharedRCUConstPointer<_Ty>& operator=(const TAsyncSharedRCUConstPointer<_Ty>& _Right_cref) = delete;
+		TAsyncSharedRCUConstPointer<_Ty>& operator=(TAsyncSharedRCUConstPointer<_Ty>&& _Right) = delete;
+
+		TAsyncSharedRCUConstPointer<_Ty>* operator&() { return this; }
+		const TAsyncSharedRCUConstPointer<_Ty>* operator&() const { return this; }
+		bool is_valid() const {
+			return (nullptr != m_version_ptr);
+		}
+
+		version_type* m_version_ptr = nullptr;
+
+		friend class TAsyncSharedRCUAccessRequester<_Ty>;
+		friend class TAsyncSharedRCUReadOnlyAccessRequester<_Ty>;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedRCUReadOnlyAccessRequester {
+	public:
+		TAsyncSharedRCUReadOnlyAccessRequester(const TAsyncSharedRCUReadOnlyAccessRequester& src_cref) = default;
+		TAsyncSharedRCUReadOnlyAccessRequester(const TAsyncSharedRCUAccessRequester<_Ty>& src_cref) : m_shptr(src_cref.m_shptr) {}
+
+		/* Never blocks. The returned pointer refers to the version that was current at the time of the call, and
+		continues to do so (even if a newer version is published) for as long as it exists. */
+		TAsyncSharedRCUConstPointer<_Ty> readlock_ptr() {
+			return TAsyncSharedRCUConstPointer<_Ty>(m_shptr->acquire_current());
+		}
+		/* The "try" versions are provided for interface compatibility with the other access requesters. They always succeed. */
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr() {
+			return mse::optional<TAsyncSharedRCUConstPointer<_Ty>>(readlock_ptr());
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_readlock_ptr();
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			return try_readlock_ptr();
+		}
+
+	private:
+		TAsyncSharedRCUReadOnlyAccessRequester<_Ty>* operator&() { return this; }
+		const TAsyncSharedRCUReadOnlyAccessRequester<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<us::impl::TAsyncSharedRCUState<_Ty>> m_shptr;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedRCUAccessRequester {
+	public:
+		TAsyncSharedRCUAccessRequester(const TAsyncSharedRCUAccessRequester& src_cref) = default;
+
+		/* Never blocks. The returned pointer refers to the version that was current at the time of the call, and
+		continues to do so (even if a newer version is published) for as long as it exists. */
+		TAsyncSharedRCUConstPointer<_Ty> readlock_ptr() {
+			return TAsyncSharedRCUConstPointer<_Ty>(m_shptr->acquire_current());
+		}
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr() {
+			return mse::optional<TAsyncSharedRCUConstPointer<_Ty>>(readlock_ptr());
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_readlock_ptr();
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedRCUConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			return try_readlock_ptr();
+		}
+
+		/* Constructs a new version of the object and makes it the current one. Writers are serialized with respect to
+		each other, and each waits (briefly) for any readers in the middle of obtaining the superseded version. */
+		template <class... Args>
+		void publish(Args&&... args) {
+			m_shptr->publish(std::forward<Args>(args)...);
+		}
+		/* Publishes a modified copy of the current version. The function is called with a (non-const) reference to the
+		copy. Concurrent update()s (and publish()es) are serialized, so no modification is lost. */
+		template<class _TFunction>
+		void update(const _TFunction& func) {
+			m_shptr->update(func);
+		}
+
+		template <class... Args>
+		static TAsyncSharedRCUAccessRequester make(Args&&... args) {
+			TAsyncSharedRCUAccessRequester retval(std::make_shared<us::impl::TAsyncSharedRCUState<_Ty>>(std::forward<Args>(args)...));
+			return retval;
+		}
+
+	private:
+		TAsyncSharedRCUAccessRequester(std::shared_ptr<us::impl::TAsyncSharedRCUState<_Ty>> shptr) : m_shptr(shptr) {}
+
+		TAsyncSharedRCUAccessRequester<_Ty>* operator&() { return this; }
+		const TAsyncSharedRCUAccessRequester<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<us::impl::TAsyncSharedRCUState<_Ty>> m_shptr;
+
+		friend class TAsyncSharedRCUReadOnlyAccessRequester<_Ty>;
+	};
+
+	template <class X, class... Args>
+	TAsyncSharedRCUAccessRequester<X> make_asyncsharedrcu(Args&&... args) {
+		return TAsyncSharedRCUAccessRequester<X>::make(std::forward<Args>(args)...);
+	}
+
+	namespace us {
+		namespace impl {
+			/* Lock acquisition order is determined by the address of the shared object (state). */
+			struct CAsyncSharedLockOrderingKeyGetter {
+				template<class _TAccessRequester>
+				static const void* key(const _TAccessRequester& access_requester) {
+					return static_cast<const void*>(access_requester.m_shptr.get());
+				}
+			};
+
+			struct CAsyncSharedSeqLockLeaseGetter {
+				template<class _TSeqLockConstPointer>
+				static auto stable_value_shptr(const _TSeqLockConstPointer& const_pointer) -> decltype(const_pointer.stable_value_shptr()) {
+					return const_pointer.stable_value_shptr();
+				}
+			};
+
+			template<class _TAccessRequester>
+			using async_shared_writelock_ptr_t = decltype(std::declval<typename std::remove_reference<_TAccessRequester>::type&>().writelock_ptr());
+
+			/* Calls function with std::integral_constant<size_t, index>. */
+			template<size_t I, size_t N, class _TFunction>
+			typename std::enable_if<(I >= N)>::type apply_at_index(size_t /*index*/, _TFunction& /*function*/) {}
+			template<size_t I, size_t N, class _TFunction>
+			typename std::enable_if<(I < N)>::type apply_at_index(size_t index, _TFunction& function) {
+				if (I == index) {
+					function(std::integral_constant<size_t, I>());
+				}
+				else {
+					apply_at_index<I + 1, N>(index, function);
+				}
+			}
+
+			template<class _TRequesterRefTuple, class _TOptionalPtrTuple, size_t... Is>
+			auto writelock_ptrs_helper(_TRequesterRefTuple& requesters, _TOptionalPtrTuple& optional_ptrs, std::index_sequence<Is...>)
+				-> std::tuple<async_shared_writelock_ptr_t<typename std::tuple_element<Is, _TRequesterRefTuple>::type>...> {
+				constexpr size_t N = sizeof...(Is);
+				const std::array<const void*, N> keys = { { CAsyncSharedLockOrderingKeyGetter::key(std::get<Is>(requesters))... } };
+				std::array<size_t, N> order;
+				for (size_t i = 0; N > i; i += 1) {
+					order[i] = i;
+				}
+				std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return std::less<const void*>()(keys[a], keys[b]); });
+
+				/* Like std::lock(), we block on one lock and only "try" the others. If one of the others isn't available, we
+				release everything and next time block on the one that wasn't available. The first time around we block on
+				the lowest addressed object and try the rest in address order, so that (uncontended) simultaneous callers
+				acquire the locks in a consistent order. */
+				size_t blocking_position = 0;
+				while (true) {
+					auto lock_one = [&](auto I) {
+						std::get<decltype(I)::value>(optional_ptrs).emplace(std::get<decltype(I)::value>(requesters).writelock_ptr());
+					};
+					apply_at_index<0, N>(order[blocking_position], lock_one);
+
+					bool all_acquired = true;
+					for (size_t position = 0; N > position; position += 1) {
+						if (blocking_position == position) {
+							continue;
+						}
+						bool acquired = false;
+						auto try_lock_one = [&](auto I) {
+							auto maybe_ptr = std::get<decltype(I)::value>(requesters).try_writelock_ptr();
+							if (maybe_ptr) {
+								std::get<decltype(I)::value>(optional_ptrs).emplace(std::move(*maybe_ptr));
+								acquired = true;
+							}
+						};
+						apply_at_index<0, N>(order[position], try_lock_one);
+						if (!acquired) {
+							all_acquired = false;
+							blocking_position = position;
+							break;
+						}
+					}
+					if (all_acquired) {
+						break;
+					}
+					auto release_one = [&](auto I) { std::get<decltype(I)::value>(optional_ptrs).reset(); };
+					for (size_t i = 0; N > i; i += 1) {
+						apply_at_index<0, N>(i, release_one);
+					}
+					std::this_thread::yield();
+				}
+				return std::tuple<async_shared_writelock_ptr_t<typename std::tuple_element<Is, _TRequesterRefTuple>::type>...>(std::move(*std::get<Is>(optional_ptrs))...);
+			}
+		}
+	}
+
+	/* Acquires write locks on all the given (read-write) access requesters' objects, without risk of deadlock (among
+	callers of this function), and returns a tuple of the write pointers. */
+	template<class... _TAccessRequesters>
+	auto writelock_ptrs(_TAccessRequesters&&... access_requesters)
+		-> std::tuple<us::impl::async_shared_writelock_ptr_t<_TAccessRequesters>...> {
+		auto requesters = std::forward_as_tuple(access_requesters...);
+		std::tuple<mse::optional<us::impl::async_shared_writelock_ptr_t<_TAccessRequesters>>...> optional_ptrs;
+		return us::impl::writelock_ptrs_helper(requesters, optional_ptrs, std::index_sequence_for<_TAccessRequesters...>());
+	}
+
+
 #if defined(MSEREFCOUNTING_H_)
 	template<class _TTargetType, class _Ty>
 	TStrongFixedPointer<_TTargetType, TAsyncSharedReadWritePointer<_Ty>> make_pointer_to_member(_TTargetType& target, const TAsyncSharedReadWritePointer<_Ty> &lease_pointer) {
@@ -1008,18 +2655,41 @@ namespace mse {
 	TStrongFixedConstPointer<_TTargetType, TAsyncSharedReadOnlyConstPointer<_Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedReadOnlyConstPointer<_Ty> &lease_pointer) {
 		return TStrongFixedConstPointer<_TTargetType, TAsyncSharedReadOnlyConstPointer<_Ty>>::make(target, lease_pointer);
 	}
+	template<class _TTargetType, class _Ty>
+	TStrongFixedConstPointer<_TTargetType, TAsyncSharedRCUConstPointer<_Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedRCUConstPointer<_Ty> &lease_pointer) {
+		return TStrongFixedConstPointer<_TTargetType, TAsyncSharedRCUConstPointer<_Ty>>::make(target, lease_pointer);
+	}
 
 	template<class _TTargetType, class _Ty>
 	TStrongFixedPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> make_pointer_to_member(_TTargetType& target, const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty> &lease_pointer) {
 		return TStrongFixedPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>>::make(target, lease_pointer);
 	}
+
+	namespace us {
+		namespace impl {
+			/* The seqlock read pointers hold their snapshot by value, so a copy of the read pointer wouldn't keep the member
+			alive at the same address. So instead the lease is a shared copy of the snapshot, and the target is relocated into it. */
+			template<class _TTargetType, class _TSeqLockConstPointer>
+			auto make_const_pointer_to_seqlock_snapshot_member(const _TTargetType& target, const _TSeqLockConstPointer &lease_pointer) {
+				auto value_shptr = CAsyncSharedSeqLockLeaseGetter::stable_value_shptr(lease_pointer);
+				typedef TStrongFixedConstPointer<_TTargetType, decltype(value_shptr)> strong_pointer_type;
+				const auto snapshot_begin = reinterpret_cast<const char*>(std::addressof(*lease_pointer));
+				const auto target_begin = reinterpret_cast<const char*>(std::addressof(target));
+				if ((snapshot_begin <= target_begin) && (snapshot_begin + sizeof(*lease_pointer) >= target_begin + sizeof(_TTargetType))) {
+					const auto relocated_target_begin = reinterpret_cast<const char*>(value_shptr.get()) + (target_begin - snapshot_begin);
+					return strong_pointer_type::make(*reinterpret_cast<const _TTargetType*>(relocated_target_begin), value_shptr);
+				}
+				return strong_pointer_type::make(target, value_shptr);
+			}
+		}
+	}
 	template<class _TTargetType, class _Ty>
-	TStrongFixedConstPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty> &lease_pointer) {
-		return TStrongFixedConstPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>>::make(target, lease_pointer);
+	TStrongFixedConstPointer<_TTargetType, std::shared_ptr<const _Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty> &lease_pointer) {
+		return us::impl::make_const_pointer_to_seqlock_snapshot_member(target, lease_pointer);
 	}
 	template<class _TTargetType, class _Ty>
-	TStrongFixedConstPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty> &lease_pointer) {
-		return TStrongFixedConstPointer<_TTargetType, TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>>::make(target, lease_pointer);
+	TStrongFixedConstPointer<_TTargetType, std::shared_ptr<const _Ty>> make_const_pointer_to_member(const _TTargetType& target, const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty> &lease_pointer) {
+		return us::impl::make_const_pointer_to_seqlock_snapshot_member(target, lease_pointer);
 	}
 #endif // defined(MSEREFCOUNTING_H_)
 
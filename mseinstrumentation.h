@@ -0,0 +1,233 @@
+
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef MSEINSTRUMENTATION_H
+#define MSEINSTRUMENTATION_H
+
+/* With MSE_SAFETY_CHECK_INSTRUMENTATION1 defined, the library counts (per pointer/container type) the run-time safety
+mechanism events listed below, so you can see which ones cost the most (and maybe decide where to use the corresponding
+MSE_*_DISABLED macros). The counters are kept per thread, aggregated on demand by safety_check_counts(), and written (in
+JSON format) to the file named by MSE_SAFETY_CHECK_COUNTS_JSON_FILENAME at program exit. Without
+MSE_SAFETY_CHECK_INSTRUMENTATION1 defined, MSE_SAFETY_CHECK_COUNT() expands to nothing.
+Note that constexpr functions can't be counted (the counter needs a static variable), so msearray's "bounds_checks"
+count only includes its non-const element accesses (operator[] and at()), not the const ones. */
+
+#ifdef MSE_SAFETY_CHECK_INSTRUMENTATION1
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <array>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <ostream>
+#include <fstream>
+
+#ifndef MSE_SAFETY_CHECK_COUNTS_JSON_FILENAME
+#define MSE_SAFETY_CHECK_COUNTS_JSON_FILENAME "mse_safety_check_counts.json"
+#endif // !MSE_SAFETY_CHECK_COUNTS_JSON_FILENAME
+
+namespace mse {
+	namespace us {
+		namespace impl {
+			static const size_t sc_safety_check_event_registration = 0;
+			static const size_t sc_safety_check_event_unregistration = 1;
+			static const size_t sc_safety_check_event_fast_to_slow_mode_transition = 2;
+			static const size_t sc_safety_check_event_bounds_check = 3;
+			static const size_t sc_safety_check_event_iterator_set_shift = 4;
+			static const size_t sc_safety_check_event_null_check = 5;
+			static const size_t sc_safety_check_num_events = 6;
+
+			inline const char* safety_check_event_name(size_t event_index) {
+				static const char* const s_names[sc_safety_check_num_events] = { "registrations", "unregistrations"
+					, "fast_to_slow_mode_transitions", "bounds_checks", "iterator_set_shifts", "null_checks" };
+				return s_names[event_index];
+			}
+
+			/* Types beyond this number share the last slot. */
+			static const size_t sc_safety_check_max_num_types = 64;
+		}
+	}
+
+	class CSafetyCheckCounts {
+	public:
+		uint64_t total() const {
+			uint64_t retval = 0;
+			for (auto count : m_counts) {
+				retval += count;
+			}
+			return retval;
+		}
+
+		std::string m_type_name;
+		/* Indexed by event (us::impl::sc_safety_check_event_*). */
+		std::array<uint64_t, us::impl::sc_safety_check_num_events> m_counts = {};
+	};
+
+	namespace us {
+		namespace impl {
+			class CSafetyCheckCounterRegistry;
+
+			/* Each thread has its own block of counters. Only the owning thread modifies them, so they can be incremented
+			with a relaxed load and store rather than an atomic read-modify-write. */
+			class CSafetyCheckThreadCounters {
+			public:
+				inline CSafetyCheckThreadCounters();
+				inline ~CSafetyCheckThreadCounters();
+				void increment(size_t type_index, size_t event_index) {
+					auto& counter_ref = m_counters[type_index][event_index];
+					counter_ref.store(counter_ref.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+				uint64_t count(size_t type_index, size_t event_index) const {
+					return m_counters[type_index][event_index].load(std::memory_order_relaxed);
+				}
+
+			private:
+				std::atomic<uint64_t> m_counters[sc_safety_check_max_num_types][sc_safety_check_num_events];
+			};
+
+			/* The registry is intentionally never destroyed, as (detached) threads may still be counting at exit. */
+			class CSafetyCheckCounterRegistry {
+			public:
+				static CSafetyCheckCounterRegistry& instance() {
+					static CSafetyCheckCounterRegistry* s_instance_ptr = new CSafetyCheckCounterRegistry();
+					return *s_instance_ptr;
+				}
+
+				size_t type_index(const char* type_name) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					for (size_t i = 0; m_type_names.size() > i; i += 1) {
+						if (0 == std::strcmp(type_name, m_type_names[i])) {
+							return i;
+						}
+					}
+					if (sc_safety_check_max_num_types <= m_type_names.size()) {
+						return sc_safety_check_max_num_types - 1;
+					}
+					m_type_names.push_back(type_name);
+					return m_type_names.size() - 1;
+				}
+
+				void register_thread_counters(const CSafetyCheckThreadCounters* counters_ptr) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					m_thread_counters_ptrs.push_back(counters_ptr);
+				}
+				/* The counts of exiting threads are retained. */
+				void retire_thread_counters(const CSafetyCheckThreadCounters* counters_ptr) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					for (size_t i = 0; sc_safety_check_max_num_types > i; i += 1) {
+						for (size_t j = 0; sc_safety_check_num_events > j; j += 1) {
+							m_retired_counts[i][j] += counters_ptr->count(i, j);
+						}
+					}
+					for (auto it = m_thread_counters_ptrs.begin(); m_thread_counters_ptrs.end() != it; it++) {
+						if (counters_ptr == (*it)) {
+							m_thread_counters_ptrs.erase(it);
+							break;
+						}
+					}
+				}
+
+				std::vector<CSafetyCheckCounts> counts() const {
+					std::vector<CSafetyCheckCounts> retval;
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					for (size_t i = 0; m_type_names.size() > i; i += 1) {
+						CSafetyCheckCounts type_counts;
+						type_counts.m_type_name = m_type_names[i];
+						for (size_t j = 0; sc_safety_check_num_events > j; j += 1) {
+							type_counts.m_counts[j] = m_retired_counts[i][j];
+							for (const auto counters_ptr : m_thread_counters_ptrs) {
+								type_counts.m_counts[j] += counters_ptr->count(i, j);
+							}
+						}
+						retval.push_back(type_counts);
+					}
+					return retval;
+				}
+
+			private:
+				inline CSafetyCheckCounterRegistry();
+
+				mutable std::mutex m_mutex;
+				std::vector<const char*> m_type_names;
+				std::vector<const CSafetyCheckThreadCounters*> m_thread_counters_ptrs;
+				uint64_t m_retired_counts[sc_safety_check_max_num_types][sc_safety_check_num_events] = {};
+			};
+
+			inline CSafetyCheckThreadCounters::CSafetyCheckThreadCounters() {
+				for (auto& type_counters : m_counters) {
+					for (auto& counter_ref : type_counters) {
+						counter_ref.store(0, std::memory_order_relaxed);
+					}
+				}
+				CSafetyCheckCounterRegistry::instance().register_thread_counters(this);
+			}
+			inline CSafetyCheckThreadCounters::~CSafetyCheckThreadCounters() {
+				CSafetyCheckCounterRegistry::instance().retire_thread_counters(this);
+			}
+
+			inline CSafetyCheckThreadCounters& safety_check_thread_counters() {
+				thread_local CSafetyCheckThreadCounters tl_counters;
+				return tl_counters;
+			}
+		}
+	}
+
+	/* Returns the event counts (aggregated over all threads) of each type, most events first. */
+	inline std::vector<CSafetyCheckCounts> safety_check_counts() {
+		auto retval = us::impl::CSafetyCheckCounterRegistry::instance().counts();
+		std::sort(retval.begin(), retval.end(), [](const CSafetyCheckCounts& a, const CSafetyCheckCounts& b) { return a.total() > b.total(); });
+		return retval;
+	}
+
+	inline void write_safety_check_counts_json(std::ostream& os) {
+		os << "{\n\t\"safety_check_counts\": [";
+		bool first = true;
+		for (const auto& type_counts : safety_check_counts()) {
+			os << (first ? "\n" : ",\n") << "\t\t{ \"type\": \"" << type_counts.m_type_name << "\"";
+			for (size_t j = 0; us::impl::sc_safety_check_num_events > j; j += 1) {
+				os << ", \"" << us::impl::safety_check_event_name(j) << "\": " << type_counts.m_counts[j];
+			}
+			os << " }";
+			first = false;
+		}
+		os << "\n\t]\n}\n";
+	}
+
+	namespace us {
+		namespace impl {
+			inline void write_safety_check_counts_json_file_at_exit() {
+				std::ofstream ofs(MSE_SAFETY_CHECK_COUNTS_JSON_FILENAME);
+				if (ofs) {
+					write_safety_check_counts_json(ofs);
+				}
+			}
+			inline CSafetyCheckCounterRegistry::CSafetyCheckCounterRegistry() {
+				std::atexit(write_safety_check_counts_json_file_at_exit);
+			}
+		}
+	}
+}
+
+/* type_name should be a string literal. event is one of registration, unregistration, fast_to_slow_mode_transition,
+bounds_check, iterator_set_shift and null_check. */
+#define MSE_SAFETY_CHECK_COUNT(type_name, event) \
+	{ \
+		static const size_t l_mse_safety_check_type_index = mse::us::impl::CSafetyCheckCounterRegistry::instance().type_index(type_name); \
+		mse::us::impl::safety_check_thread_counters().increment(l_mse_safety_check_type_index, mse::us::impl::sc_safety_check_event_##event); \
+	}
+
+#else // MSE_SAFETY_CHECK_INSTRUMENTATION1
+
+#define MSE_SAFETY_CHECK_COUNT(type_name, event)
+
+#endif // MSE_SAFETY_CHECK_INSTRUMENTATION1
+
+#endif // MSEINSTRUMENTATION_H
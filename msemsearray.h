@@ -31,6 +31,7 @@
 #endif // MSE_MSEARRAY_USE_MSE_PRIMITIVES
 
 #include "msescope.h"
+#include "mseinstrumentation.h"
 #include <array>
 #include <assert.h>
 #include <memory>
@@ -87,7 +88,7 @@ namespace mse {
 	public:
 		msear_pointer() : m_ptr(nullptr) {}
 		msear_pointer(_Ty* ptr) : m_ptr(ptr) {}
-		msear_pointer(const msear_pointer<_Ty>& src) : m_ptr(src.m_ptr) {}
+		msear_pointer(const msear_pointer<_Ty>& src) noexcept : m_ptr(src.m_ptr) {}
 
 		_Ty& operator*() const {
 #ifndef MSE_DISABLE_MSEAR_POINTER_CHECKS
@@ -159,19 +160,19 @@ namespace mse {
 		}
 		typename base_class::reference front() {	// return first element of mutable sequence
 			if (0 == (*this).size()) { MSE_THROW(msearray_range_error("front() on empty - typename base_class::reference front() - msearray")); }
-			return base_class::front();
+			return m_array.front();
 		}
 		_CONST_FUN typename base_class::const_reference front() const {	// return first element of nonmutable sequence
 			if (0 == (*this).size()) { MSE_THROW(msearray_range_error("front() on empty - typename base_class::const_reference front() - msearray")); }
-			return base_class::front();
+			return m_array.front();
 		}
 		typename base_class::reference back() {	// return last element of mutable sequence
 			if (0 == (*this).size()) { MSE_THROW(msearray_range_error("back() on empty - typename base_class::reference back() - msearray")); }
-			return base_class::back();
+			return m_array.back();
 		}
 		_CONST_FUN typename base_class::const_reference back() const {	// return last element of nonmutable sequence
 			if (0 == (*this).size()) { MSE_THROW(msearray_range_error("back() on empty - typename base_class::const_reference back() - msearray")); }
-			return base_class::back();
+			return m_array.back();
 		}
 
 		typedef typename base_class::value_type value_type;
@@ -282,14 +283,45 @@ namespace mse {
 
 		reference at(msear_size_t _Pos)
 		{	// subscript mutable sequence with checking
+			MSE_SAFETY_CHECK_COUNT("msearray", bounds_check);
 			return m_array.at(msear_as_a_size_t(_Pos));
 		}
 
 		_CONST_FUN const_reference at(msear_size_t _Pos) const
 		{	// subscript nonmutable sequence with checking
+			/* (Not counted by MSE_SAFETY_CHECK_COUNT(), as this function is constexpr.) */
 			return m_array.at(msear_as_a_size_t(_Pos));
 		}
 
+		/* Element access with a compile-time index. The index is checked against the size of the array at compile-time (by
+		static_assert), so there's no run-time bounds check. Handy for fixed-size lookup tables in hot loops. Note that when
+		invoked from a template where the array type is dependent, the syntax is "arr.template get<2>()". */
+		template<size_t _Idx>
+		_CONST_FUN reference get() _NOEXCEPT
+		{	// subscript mutable sequence with compile-time checking
+			static_assert(_Idx < _Size, "array index out of bounds");
+			return std::get<_Idx>(m_array);
+		}
+
+		template<size_t _Idx>
+		_CONST_FUN const_reference get() const _NOEXCEPT
+		{	// subscript nonmutable sequence with compile-time checking
+			static_assert(_Idx < _Size, "array index out of bounds");
+			return std::get<_Idx>(m_array);
+		}
+
+		template<size_t _Idx>
+		_CONST_FUN reference at() _NOEXCEPT
+		{	// subscript mutable sequence with compile-time checking
+			return (*this).template get<_Idx>();
+		}
+
+		template<size_t _Idx>
+		_CONST_FUN const_reference at() const _NOEXCEPT
+		{	// subscript nonmutable sequence with compile-time checking
+			return (*this).template get<_Idx>();
+		}
+
 		_Ty *data() _NOEXCEPT
 		{	// return pointer to mutable data array
 			return m_array.data();
@@ -982,6 +1014,24 @@ namespace mse {
 			auto l_tuple_size = std::tuple_size<mse::msearray<int, 3>>::value;
 			std::tuple_element<1, mse::msearray<int, 3>>::type b1 = 5;
 
+			{
+				/* Element access with indexes that are checked at compile-time. */
+				a1.get<0>() = 31;
+				a1.at<2>() = a1.get<0>();
+				assert(31 == a1[2]);
+				//a1.get<3>() = 34; /* would be a compile error */
+
+				/* msearray can be used in constant expressions. */
+				static constexpr mse::msearray<int, 3> ca1 = { 1, 2, 3 };
+				static_assert(2 == ca1.get<1>(), "");
+				static_assert(3 == ca1.at<2>(), "");
+				static_assert((1 == ca1.front()) && (3 == ca1.back()), "");
+#ifndef MSE_MSEARRAY_USE_MSE_PRIMITIVES
+				/* (mse::CSize_t isn't a literal type.) */
+				static_assert((3 == ca1[2]) && (3 == ca1.size()), "");
+#endif // !MSE_MSEARRAY_USE_MSE_PRIMITIVES
+			}
+
 			a1 = a2;
 
 			{
@@ -30,7 +30,9 @@
 #include "mseprimitives.h"
 #endif // MSE_MSEVECTOR_USE_MSE_PRIMITIVES
 
+#include "mseinstrumentation.h"
 #include <vector>
+#include <algorithm>
 #include <assert.h>
 #include <memory>
 #include <unordered_map>
@@ -72,6 +74,9 @@ namespace mse {
 	class msevector_null_dereference_error : public std::logic_error { public:
 		using std::logic_error::logic_error;
 	};
+	class msevector_size_change_lock_error : public std::logic_error { public:
+		using std::logic_error::logic_error;
+	};
 
 	/* msev_pointer behaves similar to native pointers. It's a bit safer in that it initializes to
 	nullptr by default and checks for attempted dereference of null pointers. */
@@ -80,7 +85,7 @@ namespace mse {
 	public:
 		msev_pointer() : m_ptr(nullptr) {}
 		msev_pointer(_Ty* ptr) : m_ptr(ptr) {}
-		msev_pointer(const msev_pointer<_Ty>& src) : m_ptr(src.m_ptr) {}
+		msev_pointer(const msev_pointer<_Ty>& src) noexcept : m_ptr(src.m_ptr) {}
 
 		_Ty& operator*() const {
 #ifndef MSE_DISABLE_MSEAR_POINTER_CHECKS
@@ -129,6 +134,52 @@ namespace mse {
 		}
 	};
 
+	/* Iterator tracking policies for msevector. */
+	class msevector_track_ipointers {
+	public:
+		static const bool sc_tracks_ipointers = true;
+	};
+	class msevector_no_ipointer_tracking {
+	public:
+		static const bool sc_tracks_ipointers = false;
+	};
+
+	/* The number of outstanding ipointers, cipointers and size change locks held against an msevector. The modifying
+	operations take their fast path only when it's zero. */
+	class msevector_size_change_lock_state {
+	public:
+		msev_size_t m_num_registrations = 0;
+		msev_size_t m_num_size_change_locks = 0;
+	};
+
+	/* While a msevector_size_change_lock exists, any operation that would change the size (or move the contents) of the
+	msevector it was obtained from throws an msevector_size_change_lock_error. This allows views (like TXScopeSpan) to hold
+	a raw pointer to the vector's contents without having to re-check it on each access. The lock must not outlive the
+	vector. A default constructed lock doesn't lock anything. */
+	class msevector_size_change_lock {
+	public:
+		msevector_size_change_lock() {}
+		explicit msevector_size_change_lock(msevector_size_change_lock_state& state_ref) : m_state_ptr(&state_ref) { acquire(); }
+		msevector_size_change_lock(const msevector_size_change_lock& src) : m_state_ptr(src.m_state_ptr) { acquire(); }
+		~msevector_size_change_lock() {
+			if (m_state_ptr) {
+				m_state_ptr->m_num_size_change_locks -= 1;
+				m_state_ptr->m_num_registrations -= 1;
+			}
+		}
+
+	private:
+		msevector_size_change_lock& operator=(const msevector_size_change_lock& _Right_cref) = delete;
+		void acquire() {
+			if (m_state_ptr) {
+				m_state_ptr->m_num_size_change_locks += 1;
+				m_state_ptr->m_num_registrations += 1;
+			}
+		}
+
+		msevector_size_change_lock_state* m_state_ptr = nullptr;
+	};
+
 	template<class _Iter>
 	struct _mse_Is_iterator
 	: public integral_constant<bool, !std::is_integral<_Iter>::value>
@@ -146,12 +197,18 @@ namespace mse {
 		with the security/safety goals of msevector. (The remaining part of the std::vector interface may be supported, as a
 		user option, for compatibility.)
 		In particular, keep in mind that std::vector does not have a virtual destructor, so deallocating an msevector as an
-		std::vector would result in memory leaks. */
-	template<class _Ty, class _A = std::allocator<_Ty> >
+		std::vector would result in memory leaks.
+		The optional third template parameter selects whether the vector supports (and so tracks) ipointers. With
+		msevector_no_ipointer_tracking, ipointers and cipointers are unavailable, but the vector retains its bounds checking
+		(and its "safe" ss_ iterators) and the iterator range updates compile away. Either way, each modifying operation
+		still checks (with a single, well predicted branch) for outstanding registrations, as size_change_lock()s are
+		supported regardless of the policy. With msevector_track_ipointers that branch is the only tracking overhead until
+		the first ipointer or cipointer is created. */
+	template<class _Ty, class _A = std::allocator<_Ty>, class _TIteratorTrackingPolicy = msevector_track_ipointers>
 	class msevector : public std::vector<_Ty, _A> {
 	public:
 		typedef std::vector<_Ty, _A> base_class;
-		typedef msevector<_Ty, _A> _Myt;
+		typedef msevector<_Ty, _A, _TIteratorTrackingPolicy> _Myt;
 
 		typedef typename base_class::value_type value_type;
 		//typedef typename base_class::size_type size_type;
@@ -177,7 +234,7 @@ namespace mse {
 		}
 		msevector(base_class&& _X) : base_class(std::move(_X)), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(const base_class& _X) : base_class(_X), m_mmitset(*this) { /*m_debug_size = size();*/ }
-		msevector(_Myt&& _X) : base_class(std::move(_X)), m_mmitset(*this) { /*m_debug_size = size();*/ }
+		msevector(_Myt&& _X) : base_class(std::move(size_change_checked(_X))), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(const _Myt& _X) : base_class(_X), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		typedef typename base_class::const_iterator _It;
 		/* Note that safety cannot be guaranteed when using these constructors that take unsafe typename base_class::iterator and/or pointer parameters. */
@@ -193,12 +250,14 @@ namespace mse {
 		//msevector(_Iter _First, _Iter _Last, const typename base_class::_Alloc& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(_Iter _First, _Iter _Last, const _A& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		_Myt& operator=(const base_class& _X) {
+			size_change_check();
 			base_class::operator =(_X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 			return (*this);
 		}
 		_Myt& operator=(_Myt&& _X) {
+			_X.size_change_check();
 			operator=(std::move(static_cast<base_class&>(_X)));
 			m_mmitset.reset();
 			return (*this);
@@ -210,6 +269,7 @@ namespace mse {
 		}
 		void reserve(size_type _Count)
 		{	// determine new minimum length of allocated storage
+			size_change_check();
 			auto original_capacity = msev_size_t((*this).capacity());
 
 			base_class::reserve(msev_as_a_size_t(_Count));
@@ -221,6 +281,7 @@ namespace mse {
 			}
 		}
 		void shrink_to_fit() {	// reduce capacity
+			size_change_check();
 			auto original_capacity = msev_size_t((*this).capacity());
 
 			base_class::shrink_to_fit();
@@ -232,6 +293,7 @@ namespace mse {
 			}
 		}
 		void resize(size_type _N, const _Ty& _X = _Ty()) {
+			size_change_check();
 			auto original_size = msev_size_t((*this).size());
 			auto original_capacity = msev_size_t((*this).capacity());
 			bool shrinking = (_N < original_size);
@@ -250,9 +312,11 @@ namespace mse {
 			}
 		}
 		typename base_class::const_reference operator[](size_type _P) const {
+			MSE_SAFETY_CHECK_COUNT("msevector", bounds_check);
 			return (*this).at(msev_as_a_size_t(_P));
 		}
 		typename base_class::reference operator[](size_type _P) {
+			MSE_SAFETY_CHECK_COUNT("msevector", bounds_check);
 			return (*this).at(msev_as_a_size_t(_P));
 		}
 		typename base_class::reference front() {	// return first element of mutable sequence
@@ -276,6 +340,7 @@ namespace mse {
 				base_class::push_back(std::move(_X));
 			}
 			else {
+				size_change_check();
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
@@ -296,6 +361,7 @@ namespace mse {
 				base_class::push_back(_X);
 			}
 			else {
+				size_change_check();
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
@@ -316,6 +382,7 @@ namespace mse {
 				base_class::pop_back();
 			}
 			else {
+				size_change_check();
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
@@ -334,17 +401,20 @@ namespace mse {
 			}
 		}
 		void assign(_It _F, _It _L) {
+			size_change_check();
 			base_class::assign(_F, _L);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		template<class _Iter>
 		void assign(_Iter _First, _Iter _Last) {	// assign [_First, _Last)
+			size_change_check();
 			base_class::assign(_First, _Last);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void assign(size_type _N, const _Ty& _X = _Ty()) {
+			size_change_check();
 			base_class::assign(msev_as_a_size_t(_N), _X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
@@ -359,6 +429,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _P);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || (msev_size_t((*this).size()) < di)) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -389,6 +460,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _P);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || ((*this).size() < msev_size_t(di))) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -420,6 +492,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _Where);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || ((*this).size() < msev_size_t(di))) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -450,6 +523,7 @@ namespace mse {
 		void
 			/* g++4.8 seems to be using the c++98 version of this insert function instead of the c++11 version. */
 			insert(typename base_class::/*const_*/iterator _P, size_t _M, const _Ty& _X) {
+				size_change_check();
 				msev_int di = std::distance(base_class::/*c*/begin(), _P);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || (msev_size_t((*this).size()) < di)) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -475,6 +549,7 @@ namespace mse {
 			//>typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type
 			, class = _mse_RequireInputIter<_Iter> > void
 		insert(typename base_class::/*const_*/iterator _Where, _Iter _First, _Iter _Last) {	// insert [_First, _Last) at _Where
+				size_change_check();
 				msev_int di = std::distance(base_class::/*c*/begin(), _Where);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || (msev_size_t((*this).size()) < di)) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -508,6 +583,7 @@ namespace mse {
 				/*m_debug_size = size();*/
 			}
 			else {
+				size_change_check();
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
@@ -538,6 +614,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 
 #if !(defined(GPP4P8_COMPATIBLE))
 				msev_int di = std::distance(base_class::cbegin(), _Where);
@@ -572,6 +649,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _P);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || ((*this).size() < msev_size_t(di))) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator erase() - msevector")); }
@@ -604,6 +682,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _F);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || ((*this).size() < msev_size_t(di))) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator erase() - msevector")); }
@@ -636,16 +715,19 @@ namespace mse {
 			}
 		}
 		void clear() {
+			size_change_check();
 			base_class::clear();
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void swap(base_class& _X) {
+			size_change_check();
 			base_class::swap(_X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void swap(_Myt& _X) {
+			_X.size_change_check();
 			swap(static_cast<base_class&>(_X));
 			m_mmitset.reset();
 		}
@@ -661,6 +743,7 @@ namespace mse {
 			return (*this);
 		}
 		void assign(_XSTD initializer_list<typename base_class::value_type> _Ilist) {	// assign initializer_list
+			size_change_check();
 			base_class::assign(_Ilist);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
@@ -668,6 +751,7 @@ namespace mse {
 #if defined(GPP4P8_COMPATIBLE)
 		/* g++4.8 seems to be (incorrectly) using the c++98 version of this insert function instead of the c++11 version. */
 		/*typename base_class::iterator*/void insert(typename base_class::/*const_*/iterator _Where, _XSTD initializer_list<typename base_class::value_type> _Ilist) {	// insert initializer_list
+			size_change_check();
 			msev_int di = std::distance(base_class::/*c*/begin(), _Where);
 			msev_size_t d = msev_size_t(di);
 			if ((0 > di) || (msev_size_t((*this).size()) < di)) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -697,6 +781,7 @@ namespace mse {
 				return retval;
 			}
 			else {
+				size_change_check();
 				msev_int di = std::distance(base_class::cbegin(), _Where);
 				msev_size_t d = msev_size_t(di);
 				if ((0 > di) || ((*this).size() < msev_size_t(di))) { MSE_THROW(msevector_range_error("index out of range - typename base_class::iterator insert() - msevector")); }
@@ -916,7 +1001,7 @@ namespace mse {
 			msev_size_t m_index = 0;
 			const _Myt* m_owner_cptr = nullptr;
 			friend class mm_iterator_set_type;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 			friend class mm_iterator_type;
 		};
 		/* mm_iterator_type acts much like a list iterator. */
@@ -1110,286 +1195,268 @@ namespace mse {
 			msev_size_t m_index = 0;
 			_Myt* m_owner_ptr = nullptr;
 			friend class mm_iterator_set_type;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 
 	private:
-		typedef std::size_t CHashKey1;
+		/* A handle is just the address of the registry slot that holds the iterator. Slots are allocated individually and
+		recycled rather than freed, so the address remains valid for as long as the handle is held. */
 		class mm_const_iterator_handle_type {
 		public:
-			mm_const_iterator_handle_type(const CHashKey1& key_cref, const std::shared_ptr<mm_const_iterator_type>& shptr_cref) : m_shptr(shptr_cref), m_key(key_cref) {}
+			mm_const_iterator_handle_type(mm_const_iterator_type* ptr) : m_ptr(ptr) {}
 		private:
-			std::shared_ptr<mm_const_iterator_type> m_shptr;
-			CHashKey1 m_key;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			mm_const_iterator_type* m_ptr = nullptr;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 			friend class mm_iterator_set_type;
 		};
 		class mm_iterator_handle_type {
 		public:
-			mm_iterator_handle_type(const CHashKey1& key_cref, const std::shared_ptr<mm_iterator_type>& shptr_ref) : m_shptr(shptr_ref), m_key(key_cref) {}
+			mm_iterator_handle_type(mm_iterator_type* ptr) : m_ptr(ptr) {}
 		private:
-			std::shared_ptr<mm_iterator_type> m_shptr;
-			CHashKey1 m_key;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			mm_iterator_type* m_ptr = nullptr;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 			friend class mm_iterator_set_type;
 		};
 
-		class mm_iterator_set_type {
+		/* mm_iterator_registry_type keeps (pointers to) the registered iterators in a contiguous array sorted by the index
+		they point to. Insertions and removals only affect the iterators pointing into a contiguous range of indices, so
+		those can be found with a binary search and updated in a tight loop without visiting the rest. Because an iterator
+		can be repositioned (through its ipointer) without the registry's knowledge, the ordering is flagged as possibly
+		stale whenever an iterator is handed out for modification (but not for read-only access), and restored before the
+		next range update with an insertion sort, which is cheap when (as is usual) only a few iterators have moved. */
+		template<class _TIterator>
+		class mm_iterator_registry_type {
 		public:
-			class CMMConstIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_const_iterator_type>> {};
-			class CMMIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_iterator_type>> {};
+			mm_iterator_registry_type() {}
 
-			class assignable_CMMConstIterators_value_type : public std::pair<CHashKey1, std::shared_ptr<mm_const_iterator_type>> {
-			public:
-				assignable_CMMConstIterators_value_type() {}
-				assignable_CMMConstIterators_value_type(const typename CMMConstIterators::value_type& src) : std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>>(src.first, src.second) {}
-				assignable_CMMConstIterators_value_type& operator=(const typename CMMConstIterators::value_type& rhs) { (*this).first = rhs.first; (*this).second = rhs.second; return (*this); }
-				operator typename CMMConstIterators::value_type() const { return CMMConstIterators::value_type((*this).first, (*this).second); }
-			};
-			class assignable_CMMIterators_value_type : public std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>> {
-			public:
-				assignable_CMMIterators_value_type() {}
-				assignable_CMMIterators_value_type(const typename CMMIterators::value_type& src) : std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>>(src.first, src.second) {}
-				assignable_CMMIterators_value_type& operator=(const typename CMMIterators::value_type& rhs) { (*this).first = rhs.first; (*this).second = rhs.second; return (*this); }
-				operator typename CMMIterators::value_type() const { return CMMIterators::value_type((*this).first, (*this).second); }
-			};
+			bool is_empty() const { return m_ordered.empty(); }
 
-			~mm_iterator_set_type() {
-				if (!mm_const_fast_mode1()) {
-					delete m_aux_mm_const_iterator_shptrs_ptr;
+			_TIterator* allocate(_Myt& owner_ref) {
+				/* Reserve up front so that nothing below (or the subsequent release()) can throw part way through. */
+				m_ordered.reserve(m_ordered.size() + 1);
+				_TIterator* retval = nullptr;
+				if (!m_free_slots.empty()) {
+					retval = m_free_slots.back();
+					m_free_slots.pop_back();
+					retval->reset();
+					retval->set_to_beginning();
 				}
-				if (!mm_fast_mode1()) {
-					delete m_aux_mm_iterator_shptrs_ptr;
+				else {
+					m_free_slots.reserve(m_slot_storage.size() + 1);
+					m_slot_storage.emplace_back(new _TIterator(owner_ref));
+					retval = m_slot_storage.back().get();
 				}
+				/* A new iterator points to the beginning, so it goes at the front of the ordering. */
+				m_ordered.insert(m_ordered.begin(), retval);
+				return retval;
 			}
-
-			void apply_to_all_mm_const_iterator_shptrs(const std::function<void(std::shared_ptr<mm_const_iterator_type>&)>& func_obj_ref) {
-				if (!mm_const_fast_mode1()) {
-					for (auto it = (*m_aux_mm_const_iterator_shptrs_ptr).begin(); (*m_aux_mm_const_iterator_shptrs_ptr).end() != it; it++) {
-						func_obj_ref((*it).second);
+			bool release(_TIterator* ptr) {
+				auto found_it = m_ordered.end();
+				if (!m_order_may_be_stale) {
+					for (auto it = lower_bound_of_index(m_ordered.begin(), ptr->position()); m_ordered.end() != it; it++) {
+						if (ptr == (*it)) { found_it = it; break; }
+						if (ptr->position() != (*it)->position()) { break; }
 					}
 				}
 				else {
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						func_obj_ref(m_fm1_key_mm_const_it_array[i].second);
+					found_it = std::find(m_ordered.begin(), m_ordered.end(), ptr);
+				}
+				if (m_ordered.end() == found_it) {
+					return false;
+				}
+				m_ordered.erase(found_it);
+				m_free_slots.push_back(ptr);
+				return true;
+			}
+			size_t release_all() {
+				const auto num_released = m_ordered.size();
+				m_free_slots.insert(m_free_slots.end(), m_ordered.begin(), m_ordered.end());
+				m_ordered.clear();
+				m_order_may_be_stale = false;
+				return num_released;
+			}
+			/* For access that may reposition the iterator. */
+			_TIterator& item(_TIterator* ptr) {
+				m_order_may_be_stale = true;
+				return (*ptr);
+			}
+			/* For read-only access, which doesn't affect the ordering. */
+			const _TIterator& citem(const _TIterator* ptr) const {
+				return (*ptr);
+			}
+
+			void reset() {
+				for (auto ptr : m_ordered) {
+					ptr->reset();
+				}
+				/* They all point to the end marker now. */
+				m_order_may_be_stale = false;
+			}
+			void invalidate_inclusive_range(msev_size_t start_index, msev_size_t end_index) {
+				if (m_ordered.empty()) { return; }
+				restore_order();
+				auto range_begin = lower_bound_of_index(m_ordered.begin(), start_index);
+				auto range_end = range_begin;
+				while ((m_ordered.end() != range_end) && (end_index >= (*range_end)->position())) {
+					(*range_end)->invalidate_inclusive_range(start_index, end_index);
+					range_end++;
+				}
+				if (range_begin != range_end) {
+					/* The invalidated iterators all point to the end marker now. We'll move them to the corresponding
+					position in the ordering. */
+					auto new_index = (*range_begin)->position();
+					if (start_index <= new_index) {
+						auto destination = lower_bound_of_index(range_end, new_index);
+						std::rotate(range_begin, range_end, destination);
+					}
+					else {
+						m_order_may_be_stale = true;
 					}
 				}
 			}
-			void apply_to_all_mm_iterator_shptrs(const std::function<void(std::shared_ptr<mm_iterator_type>&)>& func_obj_ref) {
-				if (!mm_fast_mode1()) {
-					for (auto it = (*m_aux_mm_iterator_shptrs_ptr).begin(); (*m_aux_mm_iterator_shptrs_ptr).end() != it; it++) {
-						func_obj_ref((*it).second);
+			void shift_inclusive_range(msev_size_t start_index, msev_size_t end_index, msev_int shift) {
+				if (m_ordered.empty()) { return; }
+				MSE_SAFETY_CHECK_COUNT("msevector", iterator_set_shift);
+				restore_order();
+				auto range_begin = lower_bound_of_index(m_ordered.begin(), start_index);
+				auto range_end = range_begin;
+				while ((m_ordered.end() != range_end) && (end_index >= (*range_end)->position())) {
+					(*range_end)->shift_inclusive_range(start_index, end_index, shift);
+					range_end++;
+				}
+				if (range_begin != range_end) {
+					/* The shifted iterators retain their relative order, so we only need to check the boundaries. */
+					if (((m_ordered.begin() != range_begin) && ((*(range_begin - 1))->position() > (*range_begin)->position()))
+						|| ((m_ordered.end() != range_end) && ((*(range_end - 1))->position() > (*range_end)->position()))) {
+						m_order_may_be_stale = true;
 					}
 				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						func_obj_ref(m_fm1_key_mm_it_array[i].second);
+			}
+
+		private:
+			typedef std::vector<_TIterator*> ordered_type;
+
+			typename ordered_type::iterator lower_bound_of_index(typename ordered_type::iterator first, msev_size_t index) {
+				return std::lower_bound(first, m_ordered.end(), index, [](const _TIterator* a, msev_size_t b) { return a->position() < b; });
+			}
+			void restore_order() {
+				if (m_order_may_be_stale) {
+					const auto num_items = m_ordered.size();
+					for (size_t i = 1; i < num_items; i += 1) {
+						auto ptr = m_ordered[i];
+						const auto index = ptr->position();
+						size_t j = i;
+						while ((0 < j) && (index < m_ordered[j - 1]->position())) {
+							m_ordered[j] = m_ordered[j - 1];
+							j -= 1;
+						}
+						m_ordered[j] = ptr;
 					}
+					m_order_may_be_stale = false;
 				}
 			}
-			mm_iterator_set_type(_Myt& owner_ref) : m_next_available_key(0), m_owner_ptr(&owner_ref) {}
+
+			mm_iterator_registry_type(const mm_iterator_registry_type& src) = delete;
+			mm_iterator_registry_type& operator=(const mm_iterator_registry_type& src) = delete;
+
+			ordered_type m_ordered;
+			bool m_order_may_be_stale = false;
+			std::vector<_TIterator*> m_free_slots;
+			std::vector<std::unique_ptr<_TIterator>> m_slot_storage;
+		};
+
+		/* The registries are only allocated when the first ipointer or cipointer is created. Until then (and whenever none
+		exist) the modifying operations' only tracking overhead is a check of m_state.m_num_registrations. (Which also counts
+		size change locks, so is checked even when the tracking policy is msevector_no_ipointer_tracking.) */
+		class mm_iterator_set_type {
+		public:
+			mm_iterator_set_type(_Myt& owner_ref) : m_owner_ptr(&owner_ref) {}
 			void reset() {
-				/* We can use "static" here because the lambda function does not capture any parameters. */
-				static const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [](std::shared_ptr<mm_const_iterator_type>& a) { a->reset(); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				static const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [](std::shared_ptr<mm_iterator_type>& a) { a->reset(); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if ((!_TIteratorTrackingPolicy::sc_tracks_ipointers) || is_empty() || (!m_registries_ptr)) { return; }
+				m_registries_ptr->m_const_iterators.reset();
+				m_registries_ptr->m_iterators.reset();
 			}
 			void sync_iterators_to_index() {
 				/* No longer used. Relic from when mm_iterator_type contained a "native" iterator. */
-				/* We can use "static" here because the lambda function does not capture any parameters. */
-				/*
-				static const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [](std::shared_ptr<mm_const_iterator_type>& a) { a->sync_const_iterator_to_index(); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				static const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [](std::shared_ptr<mm_iterator_type>& a) { a->sync_iterator_to_index(); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
-				*/
 			}
 			void invalidate_inclusive_range(msev_size_t start_index, msev_size_t end_index) {
-				const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [start_index, end_index](std::shared_ptr<mm_const_iterator_type>& a) { a->invalidate_inclusive_range(start_index, end_index); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [start_index, end_index](std::shared_ptr<mm_iterator_type>& a) { a->invalidate_inclusive_range(start_index, end_index); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if ((!_TIteratorTrackingPolicy::sc_tracks_ipointers) || is_empty() || (!m_registries_ptr)) { return; }
+				m_registries_ptr->m_const_iterators.invalidate_inclusive_range(start_index, end_index);
+				m_registries_ptr->m_iterators.invalidate_inclusive_range(start_index, end_index);
 			}
 			void shift_inclusive_range(msev_size_t start_index, msev_size_t end_index, msev_int shift) {
-				const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [start_index, end_index, shift](std::shared_ptr<mm_const_iterator_type>& a) { a->shift_inclusive_range(start_index, end_index, shift); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [start_index, end_index, shift](std::shared_ptr<mm_iterator_type>& a) { a->shift_inclusive_range(start_index, end_index, shift); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if ((!_TIteratorTrackingPolicy::sc_tracks_ipointers) || is_empty() || (!m_registries_ptr)) { return; }
+				m_registries_ptr->m_const_iterators.shift_inclusive_range(start_index, end_index, shift);
+				m_registries_ptr->m_iterators.shift_inclusive_range(start_index, end_index, shift);
 			}
 			bool is_empty() const {
-				if (mm_const_fast_mode1()) {
-					if (1 <= m_fm1_num_mm_const_iterators) {
-						return false;
-					}
-				}
-				else {
-					if (1 <= m_aux_mm_const_iterator_shptrs_ptr->size()) {
-						return false;
-					}
-				}
-				if (mm_fast_mode1()) {
-					if (1 <= m_fm1_num_mm_iterators) {
-						return false;
-					}
-				}
-				else {
-					if (1 <= m_aux_mm_iterator_shptrs_ptr->size()) {
-						return false;
-					}
-				}
-				return true;
+				return (0 == m_state.m_num_registrations);
+			}
+			bool is_size_change_locked() const {
+				return (0 != m_state.m_num_size_change_locks);
 			}
 
 			mm_const_iterator_handle_type allocate_new_const_item_pointer() {
-				//auto shptr = std::shared_ptr<mm_const_iterator_type>(new mm_const_iterator_type(*m_owner_ptr));
-				auto shptr = std::make_shared<mm_const_iterator_type>(*m_owner_ptr);
-				auto key = m_next_available_key; m_next_available_key++;
-				mm_const_iterator_handle_type retval(key, shptr);
-				typename CMMConstIterators::value_type new_item(key, shptr);
-				if (!mm_const_fast_mode1()) {
-					(*m_aux_mm_const_iterator_shptrs_ptr).insert(new_item);
-				} else {
-					if (sc_fm1_max_mm_iterators == m_fm1_num_mm_const_iterators) {
-						/* Too many items. Initiate and switch to slow mode. */
-						/* Initialize slow storage. */
-						m_aux_mm_const_iterator_shptrs_ptr = new CMMConstIterators();
-						/* First copy the items from fast storage to slow storage. */
-						for (int i = 0; i < sc_fm1_max_mm_iterators; i += 1) {
-							(*m_aux_mm_const_iterator_shptrs_ptr).insert(m_fm1_key_mm_const_it_array[i]);
-						}
-						/* Add the new items to slow storage. */
-						(*m_aux_mm_const_iterator_shptrs_ptr).insert(new_item);
-					}
-					else {
-						m_fm1_key_mm_const_it_array[m_fm1_num_mm_const_iterators] = new_item;
-						m_fm1_num_mm_const_iterators += 1;
-					}
-				}
-				return retval;
+				auto ptr = registries().m_const_iterators.allocate(*m_owner_ptr);
+				m_state.m_num_registrations += 1;
+				return mm_const_iterator_handle_type(ptr);
 			}
 			void release_const_item_pointer(mm_const_iterator_handle_type handle) {
-				if (!mm_const_fast_mode1()) {
-					auto it = (*m_aux_mm_const_iterator_shptrs_ptr).find(handle.m_key);
-					if ((*m_aux_mm_const_iterator_shptrs_ptr).end() != it) {
-						(*m_aux_mm_const_iterator_shptrs_ptr).erase(it);
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_const_iterator(mm_const_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
-				}
-				else {
-					int found_index = -1;
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						if (handle.m_key == m_fm1_key_mm_const_it_array[i].first) {
-							found_index = i;
-							break;
-						}
-					}
-					if (0 <= found_index) {
-						m_fm1_num_mm_const_iterators -= 1;
-						assert(0 <= m_fm1_num_mm_const_iterators);
-						for (int j = found_index; j < m_fm1_num_mm_const_iterators; j += 1) {
-							m_fm1_key_mm_const_it_array[j] = m_fm1_key_mm_const_it_array[j + 1];
-						}
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_const_iterator(mm_const_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
+				if ((!m_registries_ptr) || (!m_registries_ptr->m_const_iterators.release(handle.m_ptr))) {
+					/* Do we need to throw here? */
+					MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_const_iterator(mm_const_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
 				}
+				m_state.m_num_registrations -= 1;
 			}
 
 			mm_iterator_handle_type allocate_new_item_pointer() {
-				//auto shptr = std::shared_ptr<mm_iterator_type>(new mm_iterator_type(*m_owner_ptr));
-				auto shptr = std::make_shared<mm_iterator_type>(*m_owner_ptr);
-				auto key = m_next_available_key; m_next_available_key++;
-				mm_iterator_handle_type retval(key, shptr);
-				typename CMMIterators::value_type new_item(key, shptr);
-				if (!mm_fast_mode1()) {
-					(*m_aux_mm_iterator_shptrs_ptr).insert(new_item);
-				}
-				else {
-					if (sc_fm1_max_mm_iterators == m_fm1_num_mm_iterators) {
-						/* Too many items. Initiate and switch to slow mode. */
-						/* Initialize slow storage. */
-						m_aux_mm_iterator_shptrs_ptr = new CMMIterators();
-						/* First copy the items from fast storage to slow storage. */
-						for (int i = 0; i < sc_fm1_max_mm_iterators; i += 1) {
-							(*m_aux_mm_iterator_shptrs_ptr).insert(m_fm1_key_mm_it_array[i]);
-						}
-						/* Add the new items to slow storage. */
-						(*m_aux_mm_iterator_shptrs_ptr).insert(new_item);
-					}
-					else {
-						m_fm1_key_mm_it_array[m_fm1_num_mm_iterators] = new_item;
-						m_fm1_num_mm_iterators += 1;
-					}
-				}
-				return retval;
+				auto ptr = registries().m_iterators.allocate(*m_owner_ptr);
+				m_state.m_num_registrations += 1;
+				return mm_iterator_handle_type(ptr);
 			}
 			void release_item_pointer(mm_iterator_handle_type handle) {
-				if (!mm_fast_mode1()) {
-					auto it = (*m_aux_mm_iterator_shptrs_ptr).find(handle.m_key);
-					if ((*m_aux_mm_iterator_shptrs_ptr).end() != it) {
-						(*m_aux_mm_iterator_shptrs_ptr).erase(it);
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_iterator(mm_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
-				}
-				else {
-					int found_index = -1;
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						if (handle.m_key == m_fm1_key_mm_it_array[i].first) {
-							found_index = i;
-							break;
-						}
-					}
-					if (0 <= found_index) {
-						m_fm1_num_mm_iterators -= 1;
-						assert(0 <= m_fm1_num_mm_iterators);
-						for (int j = found_index; j < m_fm1_num_mm_iterators; j += 1) {
-							m_fm1_key_mm_it_array[j] = m_fm1_key_mm_it_array[j + 1];
-						}
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_iterator(mm_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
+				if ((!m_registries_ptr) || (!m_registries_ptr->m_iterators.release(handle.m_ptr))) {
+					/* Do we need to throw here? */
+					MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_iterator(mm_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
 				}
+				m_state.m_num_registrations -= 1;
 			}
 			void release_all_item_pointers() {
-				if (!mm_fast_mode1()) {
-					(*m_aux_mm_iterator_shptrs_ptr).clear();
-				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						m_fm1_key_mm_it_array[i] = assignable_CMMIterators_value_type();
-					}
-					m_fm1_num_mm_iterators = 0;
+				if (m_registries_ptr) {
+					m_state.m_num_registrations -= m_registries_ptr->m_iterators.release_all();
 				}
 			}
-			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
-				return (*(handle.m_shptr));
+			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) {
+				return m_registries_ptr->m_const_iterators.item(handle.m_ptr);
 			}
 			mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
-				return (*(handle.m_shptr));
+				return m_registries_ptr->m_iterators.item(handle.m_ptr);
+			}
+			const mm_const_iterator_type &const_item_pointer_cref(mm_const_iterator_handle_type handle) const {
+				return m_registries_ptr->m_const_iterators.citem(handle.m_ptr);
+			}
+			const mm_iterator_type &item_pointer_cref(mm_iterator_handle_type handle) const {
+				return m_registries_ptr->m_iterators.citem(handle.m_ptr);
 			}
 
 		private:
 			void release_all_const_item_pointers() {
-				if (!mm_const_fast_mode1()) {
-					(*m_aux_mm_const_iterator_shptrs_ptr).clear();
+				if (m_registries_ptr) {
+					m_state.m_num_registrations -= m_registries_ptr->m_const_iterators.release_all();
 				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						m_fm1_key_mm_const_it_array[i] = assignable_CMMConstIterators_value_type();
-					}
-					m_fm1_num_mm_const_iterators = 0;
+			}
+
+			class registries_type {
+			public:
+				mm_iterator_registry_type<mm_const_iterator_type> m_const_iterators;
+				mm_iterator_registry_type<mm_iterator_type> m_iterators;
+			};
+			registries_type& registries() {
+				static_assert(_TIteratorTrackingPolicy::sc_tracks_ipointers, "ipointers and cipointers are not supported by msevectors whose iterator tracking policy is msevector_no_ipointer_tracking");
+				if (!m_registries_ptr) {
+					m_registries_ptr.reset(new registries_type());
 				}
+				return (*m_registries_ptr);
 			}
 
 			mm_iterator_set_type& operator=(const mm_iterator_set_type& src_cref) {
@@ -1404,23 +1471,12 @@ namespace mse {
 			mm_iterator_set_type(const mm_iterator_set_type& src) { /* see above */ }
 			mm_iterator_set_type(const mm_iterator_set_type&& src) { /* see above */ }
 
-			CHashKey1 m_next_available_key = 0;
-
-			static const int sc_fm1_max_mm_iterators = 6/*arbitrary*/;
-
-			bool mm_const_fast_mode1() const { return (nullptr == m_aux_mm_const_iterator_shptrs_ptr); }
-			int m_fm1_num_mm_const_iterators = 0;
-			assignable_CMMConstIterators_value_type m_fm1_key_mm_const_it_array[sc_fm1_max_mm_iterators];
-			CMMConstIterators* m_aux_mm_const_iterator_shptrs_ptr = nullptr;
-
-			bool mm_fast_mode1() const { return (nullptr == m_aux_mm_iterator_shptrs_ptr); }
-			int m_fm1_num_mm_iterators = 0;
-			assignable_CMMIterators_value_type m_fm1_key_mm_it_array[sc_fm1_max_mm_iterators];
-			CMMIterators* m_aux_mm_iterator_shptrs_ptr = nullptr;
+			msevector_size_change_lock_state m_state;
+			std::unique_ptr<registries_type> m_registries_ptr;
 
 			_Myt* m_owner_ptr = nullptr;
 
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 		mutable mm_iterator_set_type m_mmitset;
 
@@ -1433,6 +1489,13 @@ namespace mse {
 		}
 
 	private:
+		/* Read-only access to the registered iterators doesn't (potentially) disturb the registry's ordering. */
+		const mm_const_iterator_type &const_item_pointer_cref(mm_const_iterator_handle_type handle) const {
+			return m_mmitset.const_item_pointer_cref(handle);
+		}
+		const mm_iterator_type &item_pointer_cref(mm_iterator_handle_type handle) const {
+			return m_mmitset.item_pointer_cref(handle);
+		}
 		mm_const_iterator_handle_type allocate_new_const_item_pointer() const { return m_mmitset.allocate_new_const_item_pointer(); }
 		void release_const_item_pointer(mm_const_iterator_handle_type handle) const { m_mmitset.release_const_item_pointer(handle); }
 		void release_all_const_item_pointers() const { m_mmitset.release_all_const_item_pointers(); }
@@ -1440,6 +1503,18 @@ namespace mse {
 		void release_item_pointer(mm_iterator_handle_type handle) const { m_mmitset.release_item_pointer(handle); }
 		void release_all_item_pointers() const { m_mmitset.release_all_item_pointers(); }
 
+		void size_change_check() const {
+			if (m_mmitset.is_size_change_locked()) {
+				MSE_THROW(msevector_size_change_lock_error("attempt to change the size of a size change locked vector - msevector"));
+			}
+		}
+		static _Myt& size_change_checked(_Myt& _X) { _X.size_change_check(); return _X; }
+
+	public:
+		/* Returns a lock that, while it exists, causes any operation that would change the size (or location) of the vector's
+		contents to throw an msevector_size_change_lock_error. It must not outlive the vector. */
+		msevector_size_change_lock size_change_lock() const { return msevector_size_change_lock(m_mmitset.m_state); }
+
 	public:
 		class cipointer {
 		public:
@@ -1452,31 +1527,28 @@ namespace mse {
 			typedef typename mm_const_iterator_type::reference reference;
 			typedef typename mm_const_iterator_type::const_reference const_reference;
 
-			cipointer(const _Myt& owner_cref) : m_owner_cptr(&owner_cref) {
-				mm_const_iterator_handle_type handle = m_owner_cptr->allocate_new_const_item_pointer();
-				m_handle_shptr = std::make_shared<mm_const_iterator_handle_type>(handle);
-			}
-			cipointer(const cipointer& src_cref) : m_owner_cptr(src_cref.m_owner_cptr) {
-				mm_const_iterator_handle_type handle = m_owner_cptr->allocate_new_const_item_pointer();
-				m_handle_shptr = std::make_shared<mm_const_iterator_handle_type>(handle);
-				const_item_pointer() = src_cref.const_item_pointer();
+			cipointer(const _Myt& owner_cref) : m_owner_cptr(&owner_cref), m_handle(m_owner_cptr->allocate_new_const_item_pointer()) {}
+			cipointer(const cipointer& src_cref) : m_owner_cptr(src_cref.m_owner_cptr), m_handle(m_owner_cptr->allocate_new_const_item_pointer()) {
+				const_item_pointer() = src_cref.const_item_pointer_cref();
 			}
 			~cipointer() {
-				m_owner_cptr->release_const_item_pointer(*m_handle_shptr);
+				m_owner_cptr->release_const_item_pointer(m_handle);
 			}
-			mm_const_iterator_type& const_item_pointer() const { return m_owner_cptr->const_item_pointer(*m_handle_shptr); }
+			mm_const_iterator_type& const_item_pointer() const { return m_owner_cptr->const_item_pointer(m_handle); }
 			mm_const_iterator_type& cip() const { return const_item_pointer(); }
-			//const mm_const_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			/* Unlike const_item_pointer(), doesn't flag the vector's iterator registry ordering as (potentially) stale. */
+			const mm_const_iterator_type& const_item_pointer_cref() const { return m_owner_cptr->const_item_pointer_cref(m_handle); }
+			//const mm_const_iterator_handle_type& handle() const { return (m_handle); }
 
 			void reset() { const_item_pointer().reset(); }
-			bool points_to_an_item() const { return const_item_pointer().points_to_an_item(); }
-			bool points_to_end_marker() const { return const_item_pointer().points_to_end_marker(); }
-			bool points_to_beginning() const { return const_item_pointer().points_to_beginning(); }
+			bool points_to_an_item() const { return const_item_pointer_cref().points_to_an_item(); }
+			bool points_to_end_marker() const { return const_item_pointer_cref().points_to_end_marker(); }
+			bool points_to_beginning() const { return const_item_pointer_cref().points_to_beginning(); }
 			/* has_next_item_or_end_marker() is just an alias for points_to_an_item(). */
-			bool has_next_item_or_end_marker() const { return const_item_pointer().has_next_item_or_end_marker(); }
+			bool has_next_item_or_end_marker() const { return const_item_pointer_cref().has_next_item_or_end_marker(); }
 			/* has_next() is just an alias for points_to_an_item() that's familiar to java programmers. */
-			bool has_next() const { return const_item_pointer().has_next(); }
-			bool has_previous() const { return const_item_pointer().has_previous(); }
+			bool has_next() const { return const_item_pointer_cref().has_next(); }
+			bool has_previous() const { return const_item_pointer_cref().has_previous(); }
 			void set_to_beginning() { const_item_pointer().set_to_beginning(); }
 			void set_to_end_marker() { const_item_pointer().set_to_end_marker(); }
 			void set_to_next() { const_item_pointer().set_to_next(); }
@@ -1491,25 +1563,25 @@ namespace mse {
 			cipointer& operator -=(difference_type n) { const_item_pointer().operator -=(n); return (*this); }
 			cipointer operator+(difference_type n) const { auto retval = (*this); retval += n; return retval; }
 			cipointer operator-(difference_type n) const { return ((*this) + (-n)); }
-			difference_type operator-(const cipointer& _Right_cref) const { return const_item_pointer() - (_Right_cref.const_item_pointer()); }
-			const_reference operator*() const { return const_item_pointer().operator*(); }
+			difference_type operator-(const cipointer& _Right_cref) const { return const_item_pointer_cref() - (_Right_cref.const_item_pointer_cref()); }
+			const_reference operator*() const { return const_item_pointer_cref().operator*(); }
 			const_reference item() const { return operator*(); }
-			const_reference previous_item() const { return const_item_pointer().previous_item(); }
-			const_pointer operator->() const { return const_item_pointer().operator->(); }
-			const_reference operator[](difference_type _Off) const { return const_item_pointer()[_Off]; }
-			cipointer& operator=(const cipointer& _Right_cref) { const_item_pointer().operator=(_Right_cref.const_item_pointer()); return (*this); }
-			bool operator==(const cipointer& _Right_cref) const { return const_item_pointer().operator==(_Right_cref.const_item_pointer()); }
+			const_reference previous_item() const { return const_item_pointer_cref().previous_item(); }
+			const_pointer operator->() const { return const_item_pointer_cref().operator->(); }
+			const_reference operator[](difference_type _Off) const { return const_item_pointer_cref()[_Off]; }
+			cipointer& operator=(const cipointer& _Right_cref) { const_item_pointer().operator=(_Right_cref.const_item_pointer_cref()); return (*this); }
+			bool operator==(const cipointer& _Right_cref) const { return const_item_pointer_cref().operator==(_Right_cref.const_item_pointer_cref()); }
 			bool operator!=(const cipointer& _Right_cref) const { return (!(_Right_cref == (*this))); }
-			bool operator<(const cipointer& _Right) const { return (const_item_pointer() < _Right.const_item_pointer()); }
-			bool operator<=(const cipointer& _Right) const { return (const_item_pointer() <= _Right.const_item_pointer()); }
-			bool operator>(const cipointer& _Right) const { return (const_item_pointer() > _Right.const_item_pointer()); }
-			bool operator>=(const cipointer& _Right) const { return (const_item_pointer() >= _Right.const_item_pointer()); }
-			void set_to_const_item_pointer(const cipointer& _Right_cref) { const_item_pointer().set_to_const_item_pointer(_Right_cref.const_item_pointer()); }
-			msev_size_t position() const { return const_item_pointer().position(); }
+			bool operator<(const cipointer& _Right) const { return (const_item_pointer_cref() < _Right.const_item_pointer_cref()); }
+			bool operator<=(const cipointer& _Right) const { return (const_item_pointer_cref() <= _Right.const_item_pointer_cref()); }
+			bool operator>(const cipointer& _Right) const { return (const_item_pointer_cref() > _Right.const_item_pointer_cref()); }
+			bool operator>=(const cipointer& _Right) const { return (const_item_pointer_cref() >= _Right.const_item_pointer_cref()); }
+			void set_to_const_item_pointer(const cipointer& _Right_cref) { const_item_pointer().set_to_const_item_pointer(_Right_cref.const_item_pointer_cref()); }
+			msev_size_t position() const { return const_item_pointer_cref().position(); }
 		private:
 			const _Myt* m_owner_cptr = nullptr;
-			std::shared_ptr<mm_const_iterator_handle_type> m_handle_shptr;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			mm_const_iterator_handle_type m_handle;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 		class ipointer {
 		public:
@@ -1520,37 +1592,34 @@ namespace mse {
 			typedef typename mm_iterator_type::pointer pointer;
 			typedef typename mm_iterator_type::reference reference;
 
-			ipointer(_Myt& owner_ref) : m_owner_ptr(&owner_ref) {
-				mm_iterator_handle_type handle = m_owner_ptr->allocate_new_item_pointer();
-				m_handle_shptr = std::make_shared<mm_iterator_handle_type>(handle);
-			}
-			ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr) {
-				mm_iterator_handle_type handle = m_owner_ptr->allocate_new_item_pointer();
-				m_handle_shptr = std::make_shared<mm_iterator_handle_type>(handle);
-				item_pointer() = src_cref.item_pointer();
+			ipointer(_Myt& owner_ref) : m_owner_ptr(&owner_ref), m_handle(m_owner_ptr->allocate_new_item_pointer()) {}
+			ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr), m_handle(m_owner_ptr->allocate_new_item_pointer()) {
+				item_pointer() = src_cref.item_pointer_cref();
 			}
 			~ipointer() {
-				m_owner_ptr->release_item_pointer(*m_handle_shptr);
+				m_owner_ptr->release_item_pointer(m_handle);
 			}
-			mm_iterator_type& item_pointer() const { return m_owner_ptr->item_pointer(*m_handle_shptr); }
+			mm_iterator_type& item_pointer() const { return m_owner_ptr->item_pointer(m_handle); }
 			mm_iterator_type& ip() const { return item_pointer(); }
-			//const mm_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			/* Unlike item_pointer(), doesn't flag the vector's iterator registry ordering as (potentially) stale. */
+			const mm_iterator_type& item_pointer_cref() const { return m_owner_ptr->item_pointer_cref(m_handle); }
+			//const mm_iterator_handle_type& handle() const { return (m_handle); }
 			operator cipointer() const {
 				cipointer retval(*m_owner_ptr);
 				retval.const_item_pointer().set_to_beginning();
-				retval.const_item_pointer().advance(msev_int(item_pointer().position()));
+				retval.const_item_pointer().advance(msev_int(item_pointer_cref().position()));
 				return retval;
 			}
 
 			void reset() { item_pointer().reset(); }
-			bool points_to_an_item() const { return item_pointer().points_to_an_item(); }
-			bool points_to_end_marker() const { return item_pointer().points_to_end_marker(); }
-			bool points_to_beginning() const { return item_pointer().points_to_beginning(); }
+			bool points_to_an_item() const { return item_pointer_cref().points_to_an_item(); }
+			bool points_to_end_marker() const { return item_pointer_cref().points_to_end_marker(); }
+			bool points_to_beginning() const { return item_pointer_cref().points_to_beginning(); }
 			/* has_next_item_or_end_marker() is just an alias for points_to_an_item(). */
-			bool has_next_item_or_end_marker() const { return item_pointer().has_next_item_or_end_marker(); }
+			bool has_next_item_or_end_marker() const { return item_pointer_cref().has_next_item_or_end_marker(); }
 			/* has_next() is just an alias for points_to_an_item() that's familiar to java programmers. */
-			bool has_next() const { return item_pointer().has_next(); }
-			bool has_previous() const { return item_pointer().has_previous(); }
+			bool has_next() const { return item_pointer_cref().has_next(); }
+			bool has_previous() const { return item_pointer_cref().has_previous(); }
 			void set_to_beginning() { item_pointer().set_to_beginning(); }
 			void set_to_end_marker() { item_pointer().set_to_end_marker(); }
 			void set_to_next() { item_pointer().set_to_next(); }
@@ -1565,25 +1634,25 @@ namespace mse {
 			ipointer& operator -=(difference_type n) { item_pointer().operator -=(n); return (*this); }
 			ipointer operator+(difference_type n) const { auto retval = (*this); retval += n; return retval; }
 			ipointer operator-(difference_type n) const { return ((*this) + (-n)); }
-			difference_type operator-(const ipointer& _Right_cref) const { return item_pointer() - (_Right_cref.item_pointer()); }
-			reference operator*() const { return item_pointer().operator*(); }
+			difference_type operator-(const ipointer& _Right_cref) const { return item_pointer_cref() - (_Right_cref.item_pointer_cref()); }
+			reference operator*() const { return item_pointer_cref().operator*(); }
 			reference item() const { return operator*(); }
-			reference previous_item() const { return item_pointer().previous_item(); }
-			pointer operator->() const { return item_pointer().operator->(); }
-			reference operator[](difference_type _Off) const { return item_pointer()[_Off]; }
-			ipointer& operator=(const ipointer& _Right_cref) { item_pointer().operator=(_Right_cref.item_pointer()); return (*this); }
-			bool operator==(const ipointer& _Right_cref) const { return item_pointer().operator==(_Right_cref.item_pointer()); }
+			reference previous_item() const { return item_pointer_cref().previous_item(); }
+			pointer operator->() const { return item_pointer_cref().operator->(); }
+			reference operator[](difference_type _Off) const { return item_pointer_cref()[_Off]; }
+			ipointer& operator=(const ipointer& _Right_cref) { item_pointer().operator=(_Right_cref.item_pointer_cref()); return (*this); }
+			bool operator==(const ipointer& _Right_cref) const { return item_pointer_cref().operator==(_Right_cref.item_pointer_cref()); }
 			bool operator!=(const ipointer& _Right_cref) const { return (!(_Right_cref == (*this))); }
-			bool operator<(const ipointer& _Right) const { return (item_pointer() < _Right.item_pointer()); }
-			bool operator<=(const ipointer& _Right) const { return (item_pointer() <= _Right.item_pointer()); }
-			bool operator>(const ipointer& _Right) const { return (item_pointer() > _Right.item_pointer()); }
-			bool operator>=(const ipointer& _Right) const { return (item_pointer() >= _Right.item_pointer()); }
-			void set_to_item_pointer(const ipointer& _Right_cref) { item_pointer().set_to_item_pointer(_Right_cref.item_pointer()); }
-			msev_size_t position() const { return item_pointer().position(); }
+			bool operator<(const ipointer& _Right) const { return (item_pointer_cref() < _Right.item_pointer_cref()); }
+			bool operator<=(const ipointer& _Right) const { return (item_pointer_cref() <= _Right.item_pointer_cref()); }
+			bool operator>(const ipointer& _Right) const { return (item_pointer_cref() > _Right.item_pointer_cref()); }
+			bool operator>=(const ipointer& _Right) const { return (item_pointer_cref() >= _Right.item_pointer_cref()); }
+			void set_to_item_pointer(const ipointer& _Right_cref) { item_pointer().set_to_item_pointer(_Right_cref.item_pointer_cref()); }
+			msev_size_t position() const { return item_pointer_cref().position(); }
 		private:
 			_Myt* m_owner_ptr = nullptr;
-			std::shared_ptr<mm_iterator_handle_type> m_handle_shptr;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			mm_iterator_handle_type m_handle;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 
 		ipointer ibegin() {	// return ipointer for beginning of mutable sequence
@@ -2001,7 +2070,7 @@ namespace mse {
 			}
 			msev_size_t m_index = 0;
 			msev_pointer<const _Myt> m_owner_cptr = nullptr;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 		/* ss_iterator_type is a bounds checked iterator. */
 		class ss_iterator_type/* : public base_class::iterator*/ {
@@ -2189,7 +2258,7 @@ namespace mse {
 			}
 			msev_size_t m_index = 0;
 			msev_pointer<_Myt> m_owner_ptr = nullptr;
-			friend class /*_Myt*/msevector<_Ty, _A>;
+			friend class /*_Myt*/msevector<_Ty, _A, _TIteratorTrackingPolicy>;
 		};
 		typedef std::reverse_iterator<ss_iterator_type> ss_reverse_iterator_type;
 		typedef std::reverse_iterator<ss_const_iterator_type> ss_const_reverse_iterator_type;
@@ -186,6 +186,11 @@ namespace mse {
 			_CONST_FUN bool empty() const _NOEXCEPT { return m_msearray.empty(); }
 			_CONST_FUN typename _MA::const_reference at(size_type _Pos) const { return m_msearray.at(_Pos); }
 			typename _MA::reference at(size_type _Pos) { return m_msearray.at(_Pos); }
+			/* Element access with an index that's checked at compile-time (so without a run-time bounds check). */
+			template<size_t _Idx> typename _MA::reference get() _NOEXCEPT { return m_msearray.template get<_Idx>(); }
+			template<size_t _Idx> _CONST_FUN typename _MA::const_reference get() const _NOEXCEPT { return m_msearray.template get<_Idx>(); }
+			template<size_t _Idx> typename _MA::reference at() _NOEXCEPT { return m_msearray.template get<_Idx>(); }
+			template<size_t _Idx> _CONST_FUN typename _MA::const_reference at() const _NOEXCEPT { return m_msearray.template get<_Idx>(); }
 			typename _MA::reference front() { return m_msearray.front(); }
 			_CONST_FUN typename _MA::const_reference front() const { return m_msearray.front(); }
 			typename _MA::reference back() { return m_msearray.back(); }
@@ -851,6 +856,10 @@ namespace mse {
 				auto l_tuple_size = std::tuple_size<mse::mstd::array<int, 3>>::value;
 				std::tuple_element<1, mse::mstd::array<int, 3>>::type b1 = 5;
 
+				a1.get<0>() = 31;
+				a1.at<2>() = a1.get<0>();
+				assert(31 == a1[2]);
+
 				a1 = a2;
 
 				{
@@ -109,9 +109,8 @@ namespace mse {
 				typedef typename _MV::ss_const_iterator_type::reference reference;
 
 				const_iterator() {}
-				const_iterator(const const_iterator& src_cref) : m_msevector_cshptr(src_cref.m_msevector_cshptr) {
-					(*this) = src_cref;
-				}
+				const_iterator(const const_iterator& src_cref) noexcept : m_msevector_cshptr(src_cref.m_msevector_cshptr)
+					, m_ss_const_iterator(src_cref.m_ss_const_iterator) {}
 				~const_iterator() {}
 				const typename _MV::ss_const_iterator_type& msevector_ss_const_iterator_type() const { return m_ss_const_iterator; }
 				typename _MV::ss_const_iterator_type& msevector_ss_const_iterator_type() { return m_ss_const_iterator; }
@@ -175,9 +174,8 @@ namespace mse {
 				typedef typename _MV::ss_iterator_type::reference reference;
 
 				iterator() {}
-				iterator(const iterator& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr) {
-					(*this) = src_cref;
-				}
+				iterator(const iterator& src_cref) noexcept : m_msevector_shptr(src_cref.m_msevector_shptr)
+					, m_ss_iterator(src_cref.m_ss_iterator) {}
 				~iterator() {}
 				const typename _MV::ss_iterator_type& msevector_ss_iterator_type() const { return m_ss_iterator; }
 				typename _MV::ss_iterator_type& msevector_ss_iterator_type() { return m_ss_iterator; }
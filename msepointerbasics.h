@@ -13,6 +13,7 @@
 #include <limits>       // std::numeric_limits
 #include <stdexcept>      // primitives_range_error
 #include <memory>
+#include "mseinstrumentation.h"
 
 /*compiler specific defines*/
 #ifdef _MSC_VER
@@ -112,6 +113,7 @@ namespace mse {
 		_Ty& operator*() const {
 			assert_initialized();
 #ifndef MSE_DISABLE_TSAFERPTR_CHECKS
+			MSE_SAFETY_CHECK_COUNT("TSaferPtr", null_check);
 			if (nullptr == m_ptr) {
 				MSE_THROW(primitives_null_dereference_error("attempt to dereference null pointer - mse::TSaferPtr"));
 			}
@@ -121,6 +123,7 @@ namespace mse {
 		_Ty* operator->() const {
 			assert_initialized();
 #ifndef MSE_DISABLE_TSAFERPTR_CHECKS
+			MSE_SAFETY_CHECK_COUNT("TSaferPtr", null_check);
 			if (nullptr == m_ptr) {
 				MSE_THROW(primitives_null_dereference_error("attempt to dereference null pointer - mse::TSaferPtr"));
 			}
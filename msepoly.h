@@ -69,40 +69,53 @@ namespace mse {
 			static_max<arg2, others...>::value;
 	};
 
+	/* The (one based) position of T in Ts, or zero if T isn't one of Ts. */
+	template<typename T, typename... Ts>
+	struct tdp_variant_index_of {
+		static const size_t value = 0;
+	};
+	template<typename T, typename F, typename... Ts>
+	struct tdp_variant_index_of<T, F, Ts...> {
+		static const size_t value = std::is_same<T, F>::value ? 1
+			: ((0 == tdp_variant_index_of<T, Ts...>::value) ? 0 : (1 + tdp_variant_index_of<T, Ts...>::value));
+	};
+
+	/* The type id of a tdp_variant is the (one based) index of the held type in its list of types (zero means empty), so the
+	operations are dispatched through (constant initialized) tables indexed by the type id. */
 	template<typename... Ts>
-	struct tdp_variant_helper;
+	struct tdp_variant_helper {
+		typedef void(*destroy_fn_t)(void * data);
+		typedef void(*move_fn_t)(void * old_v, void * new_v);
+		typedef void(*copy_fn_t)(const void * old_v, void * new_v);
 
-	template<typename F, typename... Ts>
-	struct tdp_variant_helper<F, Ts...> {
 		inline static void destroy(size_t id, void * data)
 		{
-			if (id == typeid(F).hash_code())
-				reinterpret_cast<F*>(data)->~F();
-			else
-				tdp_variant_helper<Ts...>::destroy(id, data);
+			static const destroy_fn_t sc_fns[] = { &destroy_none, &destroy_as<Ts>... };
+			sc_fns[id](data);
 		}
 
 		inline static void move(size_t old_t, void * old_v, void * new_v)
 		{
-			if (old_t == typeid(F).hash_code())
-				::new (new_v) F(std::move(*reinterpret_cast<F*>(old_v)));
-			else
-				tdp_variant_helper<Ts...>::move(old_t, old_v, new_v);
+			static const move_fn_t sc_fns[] = { &move_none, &move_as<Ts>... };
+			sc_fns[old_t](old_v, new_v);
 		}
 
 		inline static void copy(size_t old_t, const void * old_v, void * new_v)
 		{
-			if (old_t == typeid(F).hash_code())
-				::new (new_v) F(*reinterpret_cast<const F*>(old_v));
-			else
-				tdp_variant_helper<Ts...>::copy(old_t, old_v, new_v);
+			static const copy_fn_t sc_fns[] = { &copy_none, &copy_as<Ts>... };
+			sc_fns[old_t](old_v, new_v);
 		}
-	};
 
-	template<> struct tdp_variant_helper<> {
-		inline static void destroy(size_t id, void * data) { }
-		inline static void move(size_t old_t, void * old_v, void * new_v) { }
-		inline static void copy(size_t old_t, const void * old_v, void * new_v) { }
+	private:
+		static void destroy_none(void * data) {}
+		template<typename F>
+		static void destroy_as(void * data) { reinterpret_cast<F*>(data)->~F(); }
+		static void move_none(void * old_v, void * new_v) {}
+		template<typename F>
+		static void move_as(void * old_v, void * new_v) { ::new (new_v) F(std::move(*reinterpret_cast<F*>(old_v))); }
+		static void copy_none(const void * old_v, void * new_v) {}
+		template<typename F>
+		static void copy_as(const void * old_v, void * new_v) { ::new (new_v) F(*reinterpret_cast<const F*>(old_v)); }
 	};
 
 	template<typename... Ts>
@@ -116,7 +129,11 @@ namespace mse {
 		using helper_t = tdp_variant_helper<Ts...>;
 
 		static inline size_t invalid_type() {
-			return typeid(void).hash_code();
+			return 0;
+		}
+		template<typename T>
+		static inline size_t type_index() {
+			return tdp_variant_index_of<T, Ts...>::value;
 		}
 
 		size_t type_id;
@@ -160,7 +177,7 @@ namespace mse {
 
 		template<typename T>
 		bool is() const {
-			return (type_id == typeid(T).hash_code());
+			return ((invalid_type() != type_index<T>()) && (type_id == type_index<T>()));
 		}
 
 		bool valid() const {
@@ -170,19 +187,20 @@ namespace mse {
 		template<typename T, typename... Args>
 		void set(Args&&... args)
 		{
+			static_assert(0 != tdp_variant_index_of<T, Ts...>::value, "the type is not one of the variant's types");
 			// First we destroy the current contents    
 			auto held_type_id = type_id;
 			type_id = invalid_type();
 			helper_t::destroy(held_type_id, &data);
 			::new (&data) T(std::forward<Args>(args)...);
-			type_id = typeid(T).hash_code();
+			type_id = type_index<T>();
 		}
 
 		template<typename T>
 		const T& get() const
 		{
 			// It is a dynamic_cast-like behaviour
-			if (type_id == typeid(T).hash_code())
+			if (is<T>())
 				return *reinterpret_cast<const T*>(&data);
 			else
 				MSE_THROW(std::bad_cast());
@@ -192,7 +210,7 @@ namespace mse {
 		T& get()
 		{
 			// It is a dynamic_cast-like behaviour
-			if (type_id == typeid(T).hash_code())
+			if (is<T>())
 				return *reinterpret_cast<T*>(&data);
 			else
 				MSE_THROW(std::bad_cast());
@@ -206,32 +224,38 @@ namespace mse {
 	};
 
 	template<typename... Ts>
-	struct tdp_pointer_variant_helper;
+	struct tdp_pointer_variant_helper {
+		typedef void*(*arrow_operator_fn_t)(const void * data);
+		typedef const void*(*const_arrow_operator_fn_t)(const void * data);
 
-	template<typename F, typename... Ts>
-	struct tdp_pointer_variant_helper<F, Ts...> {
 		inline static void* arrow_operator(size_t id, const void * data) {
-			if (id == typeid(F).hash_code()) {
-				return (reinterpret_cast<const F*>(data))->operator->();
-			}
-			else {
-				return tdp_pointer_variant_helper<Ts...>::arrow_operator(id, data);
-			}
+			static const arrow_operator_fn_t sc_fns[] = { &arrow_operator_none, &arrow_operator_as<Ts>... };
+			return sc_fns[id](data);
 		}
 
 		inline static const void* const_arrow_operator(size_t id, const void * data) {
-			if (id == typeid(F).hash_code()) {
-				return (reinterpret_cast<const F*>(data))->operator->();
-			}
-			else {
-				return tdp_pointer_variant_helper<Ts...>::const_arrow_operator(id, data);
-			}
+			static const const_arrow_operator_fn_t sc_fns[] = { &const_arrow_operator_none, &const_arrow_operator_as<Ts>... };
+			return sc_fns[id](data);
 		}
-	};
 
-	template<> struct tdp_pointer_variant_helper<> {
-		inline static void* arrow_operator(size_t id, const void * data) { return nullptr; }
-		inline static const void* const_arrow_operator(size_t id, const void * data) { return nullptr; }
+		template<typename _TTarget>
+		inline static _TTarget* target_pointer(size_t id, const void * data) {
+			typedef _TTarget*(*target_pointer_fn_t)(const void * data);
+			static const target_pointer_fn_t sc_fns[] = { &target_pointer_none<_TTarget>, &target_pointer_as<_TTarget, Ts>... };
+			return sc_fns[id](data);
+		}
+
+	private:
+		static void* arrow_operator_none(const void * data) { return nullptr; }
+		template<typename F>
+		static void* arrow_operator_as(const void * data) { return (reinterpret_cast<const F*>(data))->operator->(); }
+		static const void* const_arrow_operator_none(const void * data) { return nullptr; }
+		template<typename F>
+		static const void* const_arrow_operator_as(const void * data) { return (reinterpret_cast<const F*>(data))->operator->(); }
+		template<typename _TTarget>
+		static _TTarget* target_pointer_none(const void * data) { return nullptr; }
+		template<typename _TTarget, typename F>
+		static _TTarget* target_pointer_as(const void * data) { return (reinterpret_cast<const F*>(data))->operator->(); }
 	};
 
 	template<typename... Ts>
@@ -247,8 +271,188 @@ namespace mse {
 		const void* const_arrow_operator() const {
 			return pointer_helper_t::const_arrow_operator((*this).type_id, &((*this).data));
 		}
+		/* Unlike casting the result of arrow_operator(), this applies any (derived to base) pointer adjustment required to
+		convert the held pointer's target to a _TTarget. */
+		template<typename _TTarget>
+		_TTarget* target_pointer() const {
+			return pointer_helper_t::template target_pointer<_TTarget>((*this).type_id, &((*this).data));
+		}
 	};
 
+	namespace us {
+		namespace impl {
+			inline constexpr size_t erased_max_size(size_t a) { return a; }
+			template<typename... _Tail>
+			inline constexpr size_t erased_max_size(size_t a, size_t b, _Tail... tail) { return erased_max_size(((a < b) ? b : a), tail...); }
+
+			/* The size of the inline buffer used by the type-erased pointers and iterators (TXScopeAnyPointer,
+			TXScopeAnyRandomAccessIterator, etc.). It's big enough to hold any of the library's pointer and iterator types
+			(whose sizes don't depend on the type of their target). Any type that doesn't fit (including the poly pointers,
+			which can themselves contain an any pointer), or whose move constructor might throw (like the registered pointers,
+			whose copies may need to allocate), is held via a heap allocated copy. */
+			static const size_t sc_erased_object_buffer_size = erased_max_size(sizeof(void*)
+				, sizeof(mse::TRegisteredPointer<int>), sizeof(mse::TRelaxedRegisteredPointer<int>)
+				, sizeof(mse::TRefCountingPointer<int>), sizeof(std::shared_ptr<int>)
+				, sizeof(mse::TXScopeFixedPointer<int>), sizeof(mse::TXScopeWeakFixedPointer<int, mse::TRelaxedRegisteredPointer<int>>)
+				, sizeof(mse::TAsyncSharedReadWritePointer<int>), sizeof(mse::TAsyncSharedReadOnlyConstPointer<int>)
+				, sizeof(typename mse::msevector<int>::ss_iterator_type), sizeof(typename mse::msearray<int, 1>::ss_iterator_type)
+				, sizeof(typename mse::mstd::vector<int>::iterator), sizeof(typename mse::mstd::array<int, 1>::iterator));
+			static const size_t sc_erased_object_buffer_alignment = std::alignment_of<void*>::value;
+
+			/* Objects are only held inline if they can be relocated without throwing, so relocation never throws. */
+			template<class _TObj>
+			struct TErasedObjectIsInline : std::integral_constant<bool, (sizeof(_TObj) <= sc_erased_object_buffer_size)
+				&& (std::alignment_of<_TObj>::value <= sc_erased_object_buffer_alignment) && std::is_nothrow_move_constructible<_TObj>::value> {};
+
+			/* Constructs, accesses, copies and destroys an object of type _TObj held in an erased object buffer. */
+			template<class _TObj, bool _IsInline = TErasedObjectIsInline<_TObj>::value>
+			struct TErasedObjectAccess {
+				static _TObj& object(void* buffer) { return *static_cast<_TObj*>(buffer); }
+				static const _TObj& object(const void* buffer) { return *static_cast<const _TObj*>(buffer); }
+				static void construct(void* buffer, const _TObj& src) { ::new (buffer) _TObj(src); }
+				static void copy(const void* src_buffer, void* dest_buffer) { construct(dest_buffer, object(src_buffer)); }
+				static void relocate(void* src_buffer, void* dest_buffer) noexcept {
+					::new (dest_buffer) _TObj(std::move(object(src_buffer)));
+					destroy(src_buffer);
+				}
+				static void destroy(void* buffer) { object(buffer).~_TObj(); }
+			};
+			template<class _TObj>
+			struct TErasedObjectAccess<_TObj, false> {
+				static _TObj& object(void* buffer) { return **static_cast<_TObj**>(buffer); }
+				static const _TObj& object(const void* buffer) { return **static_cast<_TObj* const*>(buffer); }
+				static void construct(void* buffer, const _TObj& src) { *static_cast<_TObj**>(buffer) = ::new _TObj(src); }
+				static void copy(const void* src_buffer, void* dest_buffer) { construct(dest_buffer, object(src_buffer)); }
+				static void relocate(void* src_buffer, void* dest_buffer) noexcept { *static_cast<_TObj**>(dest_buffer) = *static_cast<_TObj**>(src_buffer); }
+				static void destroy(void* buffer) {
+					_TObj* obj_ptr = *static_cast<_TObj**>(buffer);
+					obj_ptr->~_TObj();
+					::operator delete(obj_ptr);
+				}
+			};
+
+			/* The operations supported by every erased object. The operation tables of the erased pointer and iterator types
+			extend this one. */
+			class CErasedObjectOps {
+			public:
+				typedef void(*copy_fn_t)(const void* src_buffer, void* dest_buffer);
+				typedef void(*relocate_fn_t)(void* src_buffer, void* dest_buffer);
+				typedef void(*destroy_fn_t)(void* buffer);
+
+				constexpr CErasedObjectOps(copy_fn_t copy, relocate_fn_t relocate, destroy_fn_t destroy)
+					: m_copy(copy), m_relocate(relocate), m_destroy(destroy) {}
+				template<class _TObj>
+				static constexpr CErasedObjectOps make() {
+					return CErasedObjectOps(&TErasedObjectAccess<_TObj>::copy, &TErasedObjectAccess<_TObj>::relocate, &TErasedObjectAccess<_TObj>::destroy);
+				}
+
+				copy_fn_t m_copy;
+				relocate_fn_t m_relocate;
+				destroy_fn_t m_destroy;
+			};
+
+			/* One (statically initialized) operation table per erased type. */
+			template<class _TOps, class _TObj>
+			struct TErasedObjectOpsInstance {
+				static constexpr _TOps sc_ops = _TOps::template make<_TObj>();
+			};
+			template<class _TOps, class _TObj>
+			constexpr _TOps TErasedObjectOpsInstance<_TOps, _TObj>::sc_ops;
+
+			/* Holds an object of any (copyable) type in an inline buffer, along with a pointer to its table of operations,
+			_TOps (a CErasedObjectOps derivative). Unlike mse::any, there are no virtual functions involved. */
+			template<class _TOps>
+			class TErasedObjectStorage {
+			public:
+				template<class _TObj, class = typename std::enable_if<!std::is_same<_TObj, TErasedObjectStorage>::value, void>::type>
+				explicit TErasedObjectStorage(const _TObj& obj) : m_ops_ptr(&TErasedObjectOpsInstance<_TOps, _TObj>::sc_ops) {
+					TErasedObjectAccess<_TObj>::construct(buffer(), obj);
+				}
+				TErasedObjectStorage(const TErasedObjectStorage& src) : m_ops_ptr(src.m_ops_ptr) {
+					m_ops_ptr->m_copy(src.buffer(), buffer());
+				}
+				~TErasedObjectStorage() {
+					m_ops_ptr->m_destroy(buffer());
+				}
+				/* If the copy throws, this object is unaltered. Nothing after it throws. */
+				TErasedObjectStorage& operator=(const TErasedObjectStorage& _Right_cref) {
+					if (std::addressof(_Right_cref) == this) { return (*this); }
+					buffer_t tmp_buffer;
+					_Right_cref.m_ops_ptr->m_copy(_Right_cref.buffer(), &tmp_buffer);
+					m_ops_ptr->m_destroy(buffer());
+					m_ops_ptr = _Right_cref.m_ops_ptr;
+					m_ops_ptr->m_relocate(&tmp_buffer, buffer());
+					return (*this);
+				}
+				void swap(TErasedObjectStorage& other) noexcept {
+					if (std::addressof(other) == this) { return; }
+					buffer_t tmp_buffer;
+					m_ops_ptr->m_relocate(buffer(), &tmp_buffer);
+					other.m_ops_ptr->m_relocate(other.buffer(), buffer());
+					m_ops_ptr->m_relocate(&tmp_buffer, other.buffer());
+					std::swap(m_ops_ptr, other.m_ops_ptr);
+				}
+
+				const _TOps& ops() const { return (*m_ops_ptr); }
+				void* buffer() { return &m_buffer; }
+				const void* buffer() const { return &m_buffer; }
+
+			private:
+				typedef typename std::aligned_storage<sc_erased_object_buffer_size, sc_erased_object_buffer_alignment>::type buffer_t;
+				buffer_t m_buffer;
+				const _TOps* m_ops_ptr;
+			};
+
+			template<typename _TElement>
+			class TErasedPointerOps : public CErasedObjectOps {
+			public:
+				typedef _TElement*(*deref_fn_t)(const void* buffer);
+
+				constexpr TErasedPointerOps(const CErasedObjectOps& base, deref_fn_t deref) : CErasedObjectOps(base), m_deref(deref) {}
+				template<class _TPointer>
+				static constexpr TErasedPointerOps make() {
+					return TErasedPointerOps(CErasedObjectOps::make<_TPointer>(), &deref<_TPointer>);
+				}
+				template<class _TPointer>
+				static _TElement* deref(const void* buffer) { return std::addressof(*TErasedObjectAccess<_TPointer>::object(buffer)); }
+
+				deref_fn_t m_deref;
+			};
+
+			template<typename _TElement>
+			class TErasedRandomAccessIteratorOps : public CErasedObjectOps {
+			public:
+				typedef typename mse::mstd::array<int, 0>::difference_type difference_t;
+				typedef _TElement*(*deref_fn_t)(const void* buffer);
+				typedef _TElement*(*subscript_fn_t)(const void* buffer, difference_t _Off);
+				typedef void(*add_fn_t)(void* buffer, difference_t x);
+				typedef difference_t(*difference_fn_t)(const void* buffer, const void* right_buffer);
+
+				constexpr TErasedRandomAccessIteratorOps(const CErasedObjectOps& base, deref_fn_t deref, subscript_fn_t subscript, add_fn_t add, difference_fn_t difference)
+					: CErasedObjectOps(base), m_deref(deref), m_subscript(subscript), m_add(add), m_difference(difference) {}
+				template<class _TIterator>
+				static constexpr TErasedRandomAccessIteratorOps make() {
+					return TErasedRandomAccessIteratorOps(CErasedObjectOps::make<_TIterator>(), &deref<_TIterator>, &subscript<_TIterator>, &add<_TIterator>, &difference<_TIterator>);
+				}
+				template<class _TIterator>
+				static _TElement* deref(const void* buffer) { return std::addressof(*TErasedObjectAccess<_TIterator>::object(buffer)); }
+				template<class _TIterator>
+				static _TElement* subscript(const void* buffer, difference_t _Off) { return std::addressof(TErasedObjectAccess<_TIterator>::object(buffer)[_Off]); }
+				template<class _TIterator>
+				static void add(void* buffer, difference_t x) { TErasedObjectAccess<_TIterator>::object(buffer) += x; }
+				template<class _TIterator>
+				static difference_t difference(const void* buffer, const void* right_buffer) {
+					return TErasedObjectAccess<_TIterator>::object(buffer) - TErasedObjectAccess<_TIterator>::object(right_buffer);
+				}
+
+				deref_fn_t m_deref;
+				subscript_fn_t m_subscript;
+				add_fn_t m_add;
+				difference_fn_t m_difference;
+			};
+		}
+	}
+
 	template <typename _Ty>
 	class TAnyPointer;
 	template <typename _Ty>
@@ -256,30 +460,6 @@ namespace mse {
 	template <typename _Ty>
 	class TAnyConstPointer;
 
-	template <typename _Ty>
-	class TCommonPointerInterface {
-	public:
-		virtual ~TCommonPointerInterface() {}
-		virtual _Ty& operator*() const = 0;
-		virtual _Ty* operator->() const = 0;
-	};
-
-	template <typename _Ty, typename _TPointer1>
-	class TCommonizedPointer : public TCommonPointerInterface<_Ty> {
-	public:
-		TCommonizedPointer(const _TPointer1& pointer) : m_pointer(pointer) {}
-		virtual ~TCommonizedPointer() {}
-
-		_Ty& operator*() const {
-			return (*m_pointer);
-		}
-		_Ty* operator->() const {
-			return m_pointer.operator->();
-		}
-
-		_TPointer1 m_pointer;
-	};
-
 	template <typename _Ty>
 	class TXScopeAnyPointer {
 	public:
@@ -295,13 +475,13 @@ namespace mse {
 			&& (!std::is_same<_TPointer1, TAnyConstPointer<_Ty>>::value)
 			&& (!std::is_base_of<TAnyConstPointer<_Ty>, _TPointer1>::value)
 			, void>::type>
-		TXScopeAnyPointer(const _TPointer1& pointer) : m_any_pointer(TCommonizedPointer<_Ty, _TPointer1>(pointer)) {}
+		TXScopeAnyPointer(const _TPointer1& pointer) : m_any_pointer(pointer) {}
 
 		_Ty& operator*() const {
-			return (*(*common_pointer_interface_const_ptr()));
+			return (*m_any_pointer.ops().m_deref(m_any_pointer.buffer()));
 		}
 		_Ty* operator->() const {
-			return common_pointer_interface_const_ptr()->operator->();
+			return m_any_pointer.ops().m_deref(m_any_pointer.buffer());
 		}
 		template <typename _Ty2>
 		bool operator ==(const _Ty2& _Right_cref) const {
@@ -320,13 +500,7 @@ namespace mse {
 		TXScopeAnyPointer<_Ty>* operator&() { return this; }
 		const TXScopeAnyPointer<_Ty>* operator&() const { return this; }
 
-		const TCommonPointerInterface<_Ty>* common_pointer_interface_const_ptr() const {
-			auto retval = reinterpret_cast<const TCommonPointerInterface<_Ty>*>(m_any_pointer.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-
-		mse::any m_any_pointer;
+		us::impl::TErasedObjectStorage<us::impl::TErasedPointerOps<_Ty>> m_any_pointer;
 	};
 
 	template <typename _Ty>
@@ -359,30 +533,6 @@ namespace mse {
 		const TAnyPointer<_Ty>* operator&() const { return this; }
 	};
 
-	template <typename _Ty>
-	class TCommonConstPointerInterface {
-	public:
-		virtual ~TCommonConstPointerInterface() {}
-		virtual const _Ty& operator*() const = 0;
-		virtual const _Ty* operator->() const = 0;
-	};
-
-	template <typename _Ty, typename _TConstPointer1>
-	class TCommonizedConstPointer : public TCommonConstPointerInterface<_Ty> {
-	public:
-		TCommonizedConstPointer(const _TConstPointer1& const_pointer) : m_const_pointer(const_pointer) {}
-		virtual ~TCommonizedConstPointer() {}
-
-		const _Ty& operator*() const {
-			return (*m_const_pointer);
-		}
-		const _Ty* operator->() const {
-			return m_const_pointer.operator->();
-		}
-
-		_TConstPointer1 m_const_pointer;
-	};
-
 	template <typename _Ty>
 	class TXScopeAnyConstPointer {
 	public:
@@ -394,13 +544,13 @@ namespace mse {
 			&& (!std::is_same<_TPointer1, TAnyConstPointer<_Ty>>::value)
 			&& (!std::is_base_of<TAnyConstPointer<_Ty>, _TPointer1>::value)
 			, void>::type>
-		TXScopeAnyConstPointer(const _TPointer1& pointer) : m_any_const_pointer(TCommonizedConstPointer<_Ty, _TPointer1>(pointer)) {}
+		TXScopeAnyConstPointer(const _TPointer1& pointer) : m_any_const_pointer(pointer) {}
 
 		const _Ty& operator*() const {
-			return (*(*common_pointer_interface_const_ptr()));
+			return (*m_any_const_pointer.ops().m_deref(m_any_const_pointer.buffer()));
 		}
 		const _Ty* operator->() const {
-			return common_pointer_interface_const_ptr()->operator->();
+			return m_any_const_pointer.ops().m_deref(m_any_const_pointer.buffer());
 		}
 		template <typename _Ty2>
 		bool operator ==(const _Ty2& _Right_cref) const {
@@ -419,13 +569,7 @@ namespace mse {
 		TXScopeAnyConstPointer<_Ty>* operator&() { return this; }
 		const TXScopeAnyConstPointer<_Ty>* operator&() const { return this; }
 
-		const TCommonPointerInterface<_Ty>* common_pointer_interface_const_ptr() const {
-			auto retval = reinterpret_cast<const TCommonPointerInterface<_Ty>*>(m_any_const_pointer.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-
-		mse::any m_any_const_pointer;
+		us::impl::TErasedObjectStorage<us::impl::TErasedPointerOps<const _Ty>> m_any_const_pointer;
 	};
 
 	template <typename _Ty>
@@ -532,10 +676,10 @@ namespace mse {
 		TXScopePolyPointer(_Ty* p) { m_pointer.template set<mse::TPointer<_Ty, TPolyPointerID<const _Ty>>>(p); }
 
 		_Ty& operator*() const {
-			return *(reinterpret_cast<_Ty*>(m_pointer.arrow_operator()));
+			return *(m_pointer.template target_pointer<_Ty>());
 		}
 		_Ty* operator->() const {
-			return reinterpret_cast<_Ty*>(m_pointer.arrow_operator());
+			return m_pointer.template target_pointer<_Ty>();
 		}
 		template <typename _Ty2>
 		bool operator ==(const _Ty2& _Right_cref) const {
@@ -705,10 +849,10 @@ namespace mse {
 		TXScopePolyConstPointer(const _Ty* p) { m_pointer.template set<mse::TPointer<const _Ty, TPolyPointerID<const _Ty>>>(p); }
 
 		const _Ty& operator*() const {
-			return *(reinterpret_cast<const _Ty*>(m_pointer.const_arrow_operator()));
+			return *(m_pointer.template target_pointer<const _Ty>());
 		}
 		const _Ty* operator->() const {
-			return reinterpret_cast<const _Ty*>(m_pointer.const_arrow_operator());
+			return m_pointer.template target_pointer<const _Ty>();
 		}
 		template <typename _Ty2>
 		bool operator ==(const _Ty2& _Right_cref) const {
@@ -805,57 +949,6 @@ namespace mse {
 	};
 
 
-	template <typename _Ty>
-	class TCommonRandomAccessIteratorInterface {
-	public:
-		virtual ~TCommonRandomAccessIteratorInterface() {}
-		virtual _Ty& operator*() const = 0;
-		virtual _Ty* operator->() const = 0;
-		typedef typename mse::mstd::array<_Ty, 0>::reference reference_t;
-		typedef typename mse::mstd::array<_Ty, 0>::difference_type difference_t;
-		virtual reference_t operator[](difference_t _Off) const = 0;
-		virtual void operator +=(difference_t x) = 0;
-		virtual void operator -=(difference_t x) { operator +=(-x); }
-		virtual void operator ++() { operator +=(1); }
-		virtual void operator ++(int) { operator +=(1); }
-		virtual void operator --() { operator -=(1); }
-		virtual void operator --(int) { operator -=(1); }
-		virtual difference_t operator-(const TCommonRandomAccessIteratorInterface& _Right_cref) const = 0;
-		virtual bool operator==(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return (0 == operator-(_Right_cref)); }
-		virtual bool operator!=(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return !(operator==(_Right_cref)); }
-		virtual bool operator<(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return (0 > operator-(_Right_cref)); }
-		virtual bool operator>(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return (0 > operator-(_Right_cref)); }
-		virtual bool operator<=(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return (0 >= operator-(_Right_cref)); }
-		virtual bool operator>=(const TCommonRandomAccessIteratorInterface& _Right_cref) const { return (0 >= operator-(_Right_cref)); }
-	};
-
-	template <typename _Ty, typename _TRandomAccessIterator1>
-	class TCommonizedRandomAccessIterator : public TCommonRandomAccessIteratorInterface<_Ty> {
-	public:
-		TCommonizedRandomAccessIterator(const _TRandomAccessIterator1& random_access_iterator) : m_random_access_iterator(random_access_iterator) {}
-		virtual ~TCommonizedRandomAccessIterator() {}
-
-		_Ty& operator*() const {
-			return (*m_random_access_iterator);
-		}
-		_Ty* operator->() const {
-			return std::addressof(*m_random_access_iterator);
-			//return m_random_access_iterator.operator->();
-		}
-		typename TCommonRandomAccessIteratorInterface<_Ty>::reference_t operator[](typename TCommonRandomAccessIteratorInterface<_Ty>::difference_t _Off) const {
-			return m_random_access_iterator[_Off];
-		}
-		void operator +=(typename TCommonRandomAccessIteratorInterface<_Ty>::difference_t x) { m_random_access_iterator += x; }
-		typename TCommonRandomAccessIteratorInterface<_Ty>::difference_t operator-(const TCommonRandomAccessIteratorInterface<_Ty>& _Right_cref) const {
-			const TCommonizedRandomAccessIterator* crai_ptr = static_cast<const TCommonizedRandomAccessIterator*>(&_Right_cref);
-			assert(crai_ptr);
-			const _TRandomAccessIterator1& _Right_cref_m_random_access_iterator_cref = (*crai_ptr).m_random_access_iterator;
-			return m_random_access_iterator - _Right_cref_m_random_access_iterator_cref;
-		}
-
-		_TRandomAccessIterator1 m_random_access_iterator;
-	};
-
 	template <typename _Ty>
 	class TAnyRandomAccessIterator;
 
@@ -865,24 +958,24 @@ namespace mse {
 		TXScopeAnyRandomAccessIterator(const TXScopeAnyRandomAccessIterator& src) : m_any_random_access_iterator(src.m_any_random_access_iterator) {}
 
 		template <typename _TRandomAccessIterator1, class = typename std::enable_if<!std::is_convertible<_TRandomAccessIterator1, TXScopeAnyRandomAccessIterator>::value, void>::type>
-		TXScopeAnyRandomAccessIterator(const _TRandomAccessIterator1& random_access_iterator) : m_any_random_access_iterator(TCommonizedRandomAccessIterator<_Ty, _TRandomAccessIterator1>(random_access_iterator)) {}
+		TXScopeAnyRandomAccessIterator(const _TRandomAccessIterator1& random_access_iterator) : m_any_random_access_iterator(random_access_iterator) {}
 
 		friend void swap(TXScopeAnyRandomAccessIterator& first, TXScopeAnyRandomAccessIterator& second) {
-			std::swap(first.m_any_random_access_iterator, second.m_any_random_access_iterator);
+			first.m_any_random_access_iterator.swap(second.m_any_random_access_iterator);
 		}
 
 		_Ty& operator*() const {
-			return (*(*common_random_access_iterator_interface_ptr()));
+			return (*m_any_random_access_iterator.ops().m_deref(m_any_random_access_iterator.buffer()));
 		}
 		_Ty* operator->() const {
-			return common_random_access_iterator_interface_ptr()->operator->();
+			return m_any_random_access_iterator.ops().m_deref(m_any_random_access_iterator.buffer());
 		}
-		typedef typename TCommonRandomAccessIteratorInterface<_Ty>::reference_t reference_t;
-		typedef typename TCommonRandomAccessIteratorInterface<_Ty>::difference_t difference_t;
+		typedef typename mse::mstd::array<_Ty, 0>::reference reference_t;
+		typedef typename mse::mstd::array<_Ty, 0>::difference_type difference_t;
 		reference_t operator[](difference_t _Off) const {
-			return common_random_access_iterator_interface_ptr()->operator[](_Off);
+			return (*m_any_random_access_iterator.ops().m_subscript(m_any_random_access_iterator.buffer(), _Off));
 		}
-		void operator +=(difference_t x) { common_random_access_iterator_interface_ptr()->operator+=(x); }
+		void operator +=(difference_t x) { m_any_random_access_iterator.ops().m_add(m_any_random_access_iterator.buffer(), x); }
 		void operator -=(difference_t x) { operator +=(-x); }
 		void operator ++() { operator +=(1); }
 		void operator ++(int) { operator +=(1); }
@@ -892,7 +985,10 @@ namespace mse {
 		TXScopeAnyRandomAccessIterator operator+(difference_t n) const { auto retval = (*this); retval += n; return retval; }
 		TXScopeAnyRandomAccessIterator operator-(difference_t n) const { return ((*this) + (-n)); }
 		difference_t operator-(const TXScopeAnyRandomAccessIterator& _Right_cref) const {
-			return (*common_random_access_iterator_interface_ptr()) - (*(_Right_cref.common_random_access_iterator_interface_ptr()));
+			if (&(m_any_random_access_iterator.ops()) != &(_Right_cref.m_any_random_access_iterator.ops())) {
+				MSE_THROW(msearray_range_error("invalid argument (iterators of different underlying types) - difference_t operator-() - TXScopeAnyRandomAccessIterator"));
+			}
+			return m_any_random_access_iterator.ops().m_difference(m_any_random_access_iterator.buffer(), _Right_cref.m_any_random_access_iterator.buffer());
 		}
 		bool operator==(const TXScopeAnyRandomAccessIterator& _Right_cref) const { return (0 == operator-(_Right_cref)); }
 		bool operator!=(const TXScopeAnyRandomAccessIterator& _Right_cref) const { return !(operator==(_Right_cref)); }
@@ -911,73 +1007,11 @@ namespace mse {
 		TXScopeAnyRandomAccessIterator<_Ty>* operator&() { return this; }
 		const TXScopeAnyRandomAccessIterator<_Ty>* operator&() const { return this; }
 
-		TCommonRandomAccessIteratorInterface<_Ty>* common_random_access_iterator_interface_ptr() {
-			auto retval = reinterpret_cast<TCommonRandomAccessIteratorInterface<_Ty>*>(m_any_random_access_iterator.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-		const TCommonRandomAccessIteratorInterface<_Ty>* common_random_access_iterator_interface_ptr() const {
-			auto retval = reinterpret_cast<const TCommonRandomAccessIteratorInterface<_Ty>*>(m_any_random_access_iterator.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-
-		mse::any m_any_random_access_iterator;
+		us::impl::TErasedObjectStorage<us::impl::TErasedRandomAccessIteratorOps<_Ty>> m_any_random_access_iterator;
 
 		friend class TAnyRandomAccessIterator<_Ty>;
 	};
 
-	template <typename _Ty>
-	class TCommonRandomAccessConstIteratorInterface {
-	public:
-		virtual ~TCommonRandomAccessConstIteratorInterface() {}
-		virtual const _Ty& operator*() const = 0;
-		virtual const _Ty* operator->() const = 0;
-		typedef typename mse::mstd::array<_Ty, 0>::const_reference const_reference_t;
-		typedef typename mse::mstd::array<_Ty, 0>::difference_type difference_t;
-		virtual const_reference_t operator[](difference_t _Off) const = 0;
-		virtual void operator +=(difference_t x) = 0;
-		virtual void operator -=(difference_t x) { operator +=(-x); }
-		virtual void operator ++() { operator +=(1); }
-		virtual void operator ++(int) { operator +=(1); }
-		virtual void operator --() { operator -=(1); }
-		virtual void operator --(int) { operator -=(1); }
-		virtual difference_t operator-(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const = 0;
-		virtual bool operator==(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return (0 == operator-(_Right_cref)); }
-		virtual bool operator!=(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return !(operator==(_Right_cref)); }
-		virtual bool operator<(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return (0 > operator-(_Right_cref)); }
-		virtual bool operator>(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return (0 > operator-(_Right_cref)); }
-		virtual bool operator<=(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return (0 >= operator-(_Right_cref)); }
-		virtual bool operator>=(const TCommonRandomAccessConstIteratorInterface& _Right_cref) const { return (0 >= operator-(_Right_cref)); }
-	};
-
-	template <typename _Ty, typename _TRandomAccessConstIterator1>
-	class TCommonizedRandomAccessConstIterator : public TCommonRandomAccessConstIteratorInterface<_Ty> {
-	public:
-		TCommonizedRandomAccessConstIterator(const _TRandomAccessConstIterator1& random_access_const_iterator) : m_random_access_const_iterator(random_access_const_iterator) {}
-		virtual ~TCommonizedRandomAccessConstIterator() {}
-
-		const _Ty& operator*() const {
-			return (*m_random_access_const_iterator);
-		}
-		const _Ty* operator->() const {
-			return std::addressof(*m_random_access_const_iterator);
-			//return m_random_access_const_iterator.operator->();
-		}
-		typename TCommonRandomAccessConstIteratorInterface<_Ty>::const_reference_t operator[](typename TCommonRandomAccessConstIteratorInterface<_Ty>::difference_t _Off) const {
-			return m_random_access_const_iterator[_Off];
-		}
-		void operator +=(typename TCommonRandomAccessConstIteratorInterface<_Ty>::difference_t x) { m_random_access_const_iterator += x; }
-		typename TCommonRandomAccessIteratorInterface<_Ty>::difference_t operator-(const TCommonRandomAccessConstIteratorInterface<_Ty>& _Right_cref) const {
-			const TCommonizedRandomAccessConstIterator* crai_ptr = static_cast<const TCommonizedRandomAccessConstIterator*>(&_Right_cref);
-			assert(crai_ptr);
-			const _TRandomAccessConstIterator1& _Right_cref_m_random_access_const_iterator_cref = (*crai_ptr).m_random_access_const_iterator;
-			return m_random_access_const_iterator - _Right_cref_m_random_access_const_iterator_cref;
-		}
-
-		_TRandomAccessConstIterator1 m_random_access_const_iterator;
-	};
-
 	template <typename _Ty>
 	class TAnyRandomAccessConstIterator;
 
@@ -987,24 +1021,24 @@ namespace mse {
 		TXScopeAnyRandomAccessConstIterator(const TXScopeAnyRandomAccessConstIterator& src) : m_any_random_access_const_iterator(src.m_any_random_access_const_iterator) {}
 
 		template <typename _TRandomAccessConstIterator1, class = typename std::enable_if<!std::is_convertible<_TRandomAccessConstIterator1, TXScopeAnyRandomAccessConstIterator>::value, void>::type>
-		TXScopeAnyRandomAccessConstIterator(const _TRandomAccessConstIterator1& random_access_const_iterator) : m_any_random_access_const_iterator(TCommonizedRandomAccessConstIterator<const _Ty, _TRandomAccessConstIterator1>(random_access_const_iterator)) {}
+		TXScopeAnyRandomAccessConstIterator(const _TRandomAccessConstIterator1& random_access_const_iterator) : m_any_random_access_const_iterator(random_access_const_iterator) {}
 
 		friend void swap(TXScopeAnyRandomAccessConstIterator& first, TXScopeAnyRandomAccessConstIterator& second) {
-			std::swap(first.m_any_random_access_const_iterator, second.m_any_random_access_const_iterator);
+			first.m_any_random_access_const_iterator.swap(second.m_any_random_access_const_iterator);
 		}
 
 		const _Ty& operator*() const {
-			return (*(*common_random_access_const_iterator_interface_ptr()));
+			return (*m_any_random_access_const_iterator.ops().m_deref(m_any_random_access_const_iterator.buffer()));
 		}
 		const _Ty* operator->() const {
-			return common_random_access_const_iterator_interface_ptr()->operator->();
+			return m_any_random_access_const_iterator.ops().m_deref(m_any_random_access_const_iterator.buffer());
 		}
-		typedef typename TCommonRandomAccessConstIteratorInterface<_Ty>::const_reference_t const_reference_t;
-		typedef typename TCommonRandomAccessConstIteratorInterface<_Ty>::difference_t difference_t;
+		typedef typename mse::mstd::array<_Ty, 0>::const_reference const_reference_t;
+		typedef typename mse::mstd::array<_Ty, 0>::difference_type difference_t;
 		const_reference_t operator[](difference_t _Off) const {
-			return common_random_access_const_iterator_interface_ptr()->operator[](_Off);
+			return (*m_any_random_access_const_iterator.ops().m_subscript(m_any_random_access_const_iterator.buffer(), _Off));
 		}
-		void operator +=(difference_t x) { common_random_access_const_iterator_interface_ptr()->operator+=(x); };
+		void operator +=(difference_t x) { m_any_random_access_const_iterator.ops().m_add(m_any_random_access_const_iterator.buffer(), x); }
 		void operator -=(difference_t x) { operator +=(-x); }
 		void operator ++() { operator +=(1); }
 		void operator ++(int) { operator +=(1); }
@@ -1014,7 +1048,10 @@ namespace mse {
 		TXScopeAnyRandomAccessConstIterator operator+(difference_t n) const { auto retval = (*this); retval += n; return retval; }
 		TXScopeAnyRandomAccessConstIterator operator-(difference_t n) const { return ((*this) + (-n)); }
 		difference_t operator-(const TXScopeAnyRandomAccessConstIterator& _Right_cref) const {
-			return (*common_random_access_const_iterator_interface_ptr()) - (*(_Right_cref.common_random_access_const_iterator_interface_ptr()));
+			if (&(m_any_random_access_const_iterator.ops()) != &(_Right_cref.m_any_random_access_const_iterator.ops())) {
+				MSE_THROW(msearray_range_error("invalid argument (iterators of different underlying types) - difference_t operator-() - TXScopeAnyRandomAccessConstIterator"));
+			}
+			return m_any_random_access_const_iterator.ops().m_difference(m_any_random_access_const_iterator.buffer(), _Right_cref.m_any_random_access_const_iterator.buffer());
 		}
 		bool operator==(const TXScopeAnyRandomAccessConstIterator& _Right_cref) const { return (0 == operator-(_Right_cref)); }
 		bool operator!=(const TXScopeAnyRandomAccessConstIterator& _Right_cref) const { return !(operator==(_Right_cref)); }
@@ -1033,18 +1070,7 @@ namespace mse {
 		TXScopeAnyRandomAccessConstIterator<_Ty>* operator&() { return this; }
 		const TXScopeAnyRandomAccessConstIterator<_Ty>* operator&() const { return this; }
 
-		TCommonRandomAccessConstIteratorInterface<_Ty>* common_random_access_const_iterator_interface_ptr() {
-			auto retval = reinterpret_cast<TCommonRandomAccessConstIteratorInterface<_Ty>*>(m_any_random_access_const_iterator.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-		const TCommonRandomAccessConstIteratorInterface<_Ty>* common_random_access_const_iterator_interface_ptr() const {
-			auto retval = reinterpret_cast<const TCommonRandomAccessConstIteratorInterface<_Ty>*>(m_any_random_access_const_iterator.storage_address());
-			assert(nullptr != retval);
-			return retval;
-		}
-
-		mse::any m_any_random_access_const_iterator;
+		us::impl::TErasedObjectStorage<us::impl::TErasedRandomAccessIteratorOps<const _Ty>> m_any_random_access_const_iterator;
 
 		friend class TAnyRandomAccessConstIterator<_Ty>;
 	};
@@ -1354,6 +1380,293 @@ namespace mse {
 	//template<typename _Ty> using TArraySection = TRandomAccessSection<_Ty>;
 	//template<typename _Ty> using TConstArraySection = TRandomAccessConstSection<_Ty>;
 
+	namespace us {
+		namespace impl {
+			/* Uniform access to the contiguous storage of the containers that spans can be constructed from. */
+			template<class _TContainer> struct TSpanContainerTraits;
+			template<class _Ty, size_t _Size> struct TSpanContainerTraits<mse::msearray<_Ty, _Size>> {
+				typedef _Ty element_type;
+				static _Ty* data(mse::msearray<_Ty, _Size>& container_ref) { return container_ref.data(); }
+				static size_t size(const mse::msearray<_Ty, _Size>& container_ref) { return size_t(container_ref.size()); }
+				static msevector_size_change_lock size_change_lock(const mse::msearray<_Ty, _Size>&) { return msevector_size_change_lock(); }
+			};
+			template<class _Ty, size_t _Size> struct TSpanContainerTraits<mse::mstd::array<_Ty, _Size>> {
+				typedef _Ty element_type;
+				static _Ty* data(mse::mstd::array<_Ty, _Size>& container_ref) { return container_ref.msearray().data(); }
+				static size_t size(const mse::mstd::array<_Ty, _Size>& container_ref) { return size_t(container_ref.size()); }
+				static msevector_size_change_lock size_change_lock(const mse::mstd::array<_Ty, _Size>&) { return msevector_size_change_lock(); }
+			};
+			template<class _Ty, class _A, class _TIteratorTrackingPolicy> struct TSpanContainerTraits<mse::msevector<_Ty, _A, _TIteratorTrackingPolicy>> {
+				typedef _Ty element_type;
+				static _Ty* data(mse::msevector<_Ty, _A, _TIteratorTrackingPolicy>& container_ref) { return container_ref.data(); }
+				static size_t size(const mse::msevector<_Ty, _A, _TIteratorTrackingPolicy>& container_ref) { return size_t(container_ref.size()); }
+				/* The vector can't be resized (and its contents can't be relocated) while the span exists. */
+				static msevector_size_change_lock size_change_lock(const mse::msevector<_Ty, _A, _TIteratorTrackingPolicy>& container_ref) { return container_ref.size_change_lock(); }
+			};
+			template<class _TContainer> struct TSpanContainerTraits<const _TContainer> {
+				typedef const typename TSpanContainerTraits<_TContainer>::element_type element_type;
+				static element_type* data(const _TContainer& container_ref) {
+					return TSpanContainerTraits<_TContainer>::data(const_cast<_TContainer&>(container_ref));
+				}
+				static size_t size(const _TContainer& container_ref) { return TSpanContainerTraits<_TContainer>::size(container_ref); }
+				static msevector_size_change_lock size_change_lock(const _TContainer& container_ref) { return TSpanContainerTraits<_TContainer>::size_change_lock(container_ref); }
+			};
+
+			/* Throws if [offset, offset + count) isn't contained in [0, size). Returns the offset. */
+			inline size_t checked_span_offset(size_t size, size_t offset, size_t count) {
+				if ((size < offset) || ((size - offset) < count)) {
+					MSE_THROW(msearray_range_error("out of bounds range - size_t checked_span_offset() - TXScopeSpan"));
+				}
+				return offset;
+			}
+		}
+	}
+
+	/* A (bounds checked) iterator over the elements of a TXScopeSpan. */
+	template <typename _Ty>
+	class TXScopeSpanIterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef typename std::remove_const<_Ty>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef _Ty* pointer;
+		typedef _Ty& reference;
+		typedef size_t size_type;
+
+		TXScopeSpanIterator(const TXScopeSpanIterator& src) = default;
+
+		void dereference_bounds_check() const {
+			if ((0 > m_index) || (difference_type(m_size) <= m_index)) {
+				MSE_THROW(msearray_range_error("out of bounds index - void dereference_bounds_check() - TXScopeSpanIterator"));
+			}
+		}
+		reference operator*() const {
+			dereference_bounds_check();
+			return m_data[m_index];
+		}
+		pointer operator->() const {
+			dereference_bounds_check();
+			return std::addressof(m_data[m_index]);
+		}
+		reference operator[](difference_type _Off) const { return *((*this) + _Off); }
+		TXScopeSpanIterator& operator +=(difference_type x) { m_index += x; return (*this); }
+		TXScopeSpanIterator& operator -=(difference_type x) { m_index -= x; return (*this); }
+		TXScopeSpanIterator& operator ++() { m_index += 1; return (*this); }
+		TXScopeSpanIterator operator ++(int) { auto _Tmp = *this; m_index += 1; return (_Tmp); }
+		TXScopeSpanIterator& operator --() { m_index -= 1; return (*this); }
+		TXScopeSpanIterator operator --(int) { auto _Tmp = *this; m_index -= 1; return (_Tmp); }
+		TXScopeSpanIterator operator+(difference_type n) const { auto retval = (*this); retval += n; return retval; }
+		TXScopeSpanIterator operator-(difference_type n) const { return ((*this) + (-n)); }
+		difference_type operator-(const TXScopeSpanIterator& _Right_cref) const {
+			if (_Right_cref.m_data != m_data) { MSE_THROW(msearray_range_error("invalid argument - difference_type operator-() - TXScopeSpanIterator")); }
+			return m_index - _Right_cref.m_index;
+		}
+		bool operator ==(const TXScopeSpanIterator& _Right_cref) const { return (0 == operator-(_Right_cref)); }
+		bool operator !=(const TXScopeSpanIterator& _Right_cref) const { return !((*this) == _Right_cref); }
+		bool operator<(const TXScopeSpanIterator& _Right_cref) const { return (0 > operator-(_Right_cref)); }
+		bool operator>(const TXScopeSpanIterator& _Right_cref) const { return (0 < operator-(_Right_cref)); }
+		bool operator<=(const TXScopeSpanIterator& _Right_cref) const { return (0 >= operator-(_Right_cref)); }
+		bool operator>=(const TXScopeSpanIterator& _Right_cref) const { return (0 <= operator-(_Right_cref)); }
+		TXScopeSpanIterator& operator=(const TXScopeSpanIterator& _Right_cref) {
+			if (_Right_cref.m_data != m_data) { MSE_THROW(msearray_range_error("invalid argument - TXScopeSpanIterator& operator=() - TXScopeSpanIterator")); }
+			m_index = _Right_cref.m_index;
+			return (*this);
+		}
+
+	private:
+		TXScopeSpanIterator(_Ty* data, size_type size, difference_type index) : m_data(data), m_size(size), m_index(index) {}
+		void* operator new(size_t size) { return ::operator new(size); }
+
+		_Ty* m_data = nullptr;
+		size_type m_size = 0;
+		difference_type m_index = 0;
+
+		template <typename _Ty2> friend class TXScopeSpan;
+	};
+
+	template <typename _Ty>
+	class TSpan;
+
+	/* TXScopeSpan is a view of a contiguous range of elements of an msearray, mstd::array or msevector. The range is bounds
+	checked once, at construction, after which an element access is just an index comparison and a pointer offset, and
+	sub-spans are obtained in constant time. If the container is an msevector, the span holds a size change lock on it, so
+	any attempt to resize (or otherwise relocate the contents of) the vector while the span exists will throw. Like the
+	other "XScope" types, it can only be constructed from scope pointers and is intended to be used as a local variable
+	or function parameter. */
+	template <typename _Ty>
+	class TXScopeSpan {
+	public:
+		typedef _Ty element_type;
+		typedef typename std::remove_const<_Ty>::type value_type;
+		typedef _Ty& reference;
+		typedef size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef TXScopeSpanIterator<_Ty> iterator;
+
+		template<class _TContainer>
+		TXScopeSpan(const mse::TXScopeFixedPointer<_TContainer>& container_ptr)
+			: TXScopeSpan(*container_ptr, 0, us::impl::TSpanContainerTraits<_TContainer>::size(*container_ptr)) {}
+		template<class _TContainer>
+		TXScopeSpan(const mse::TXScopeFixedPointer<_TContainer>& container_ptr, size_type offset, size_type count)
+			: TXScopeSpan(*container_ptr, offset, count) {}
+		template<class _TContainer>
+		TXScopeSpan(const mse::TXScopeFixedConstPointer<_TContainer>& container_ptr)
+			: TXScopeSpan(*container_ptr, 0, us::impl::TSpanContainerTraits<const _TContainer>::size(*container_ptr)) {}
+		template<class _TContainer>
+		TXScopeSpan(const mse::TXScopeFixedConstPointer<_TContainer>& container_ptr, size_type offset, size_type count)
+			: TXScopeSpan(*container_ptr, offset, count) {}
+		template<class _TContainer, class _TLeasePointerType>
+		TXScopeSpan(const mse::TXScopeWeakFixedPointer<_TContainer, _TLeasePointerType>& container_ptr)
+			: TXScopeSpan(*container_ptr, 0, us::impl::TSpanContainerTraits<_TContainer>::size(*container_ptr)) {}
+		template<class _TContainer, class _TLeasePointerType>
+		TXScopeSpan(const mse::TXScopeWeakFixedPointer<_TContainer, _TLeasePointerType>& container_ptr, size_type offset, size_type count)
+			: TXScopeSpan(*container_ptr, offset, count) {}
+		TXScopeSpan(const TXScopeSpan& src) = default;
+		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
+		TXScopeSpan(const TXScopeSpan<_Ty2>& src) : m_lock(src.m_lock), m_data(src.m_data), m_size(src.m_size) {}
+		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
+		TXScopeSpan(const TSpan<_Ty2>& src) : m_lock(src.m_lock), m_data(src.m_data), m_size(src.m_size) {}
+		/* The TXScopeSpan doesn't hold the TSpan's reference to the container, so it can't be constructed from a temporary
+		TSpan, which (along with the container) might not outlive it. */
+		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
+		TXScopeSpan(const TSpan<_Ty2>&& src) = delete;
+
+		reference operator[](size_type _P) const {
+			if (m_size <= _P) { MSE_THROW(msearray_range_error("out of bounds index - reference operator[](size_type _P) - TXScopeSpan")); }
+			return m_data[_P];
+		}
+		reference at(size_type _P) const { return (*this)[_P]; }
+		size_type size() const { return m_size; }
+		bool empty() const { return (0 == m_size); }
+
+		/* Constant time. Only the bounds of the new range are checked. */
+		TXScopeSpan subspan(size_type offset, size_type count) const { return TXScopeSpan(*this, offset, count); }
+		TXScopeSpan subspan(size_type offset) const {
+			return TXScopeSpan(*this, offset, m_size - us::impl::checked_span_offset(m_size, offset, 0));
+		}
+		TXScopeSpan first(size_type count) const { return subspan(0, count); }
+		TXScopeSpan last(size_type count) const {
+			us::impl::checked_span_offset(m_size, 0, count);
+			return subspan(m_size - count, count);
+		}
+
+		/* Applies func to each element in order. Since the range was validated at construction, the elements are accessed
+		without any per-element checks. */
+		template<class _TFunction>
+		_TFunction for_each(_TFunction func) const {
+			auto data = m_data;
+			const auto size = m_size;
+			for (size_type i = 0; i < size; i += 1) {
+				func(data[i]);
+			}
+			return func;
+		}
+
+		iterator begin() const { return iterator(m_data, m_size, 0); }
+		iterator end() const { return iterator(m_data, m_size, difference_type(m_size)); }
+
+	private:
+		template<class _TContainer>
+		TXScopeSpan(_TContainer& container_ref, size_type offset, size_type count)
+			: m_lock(us::impl::TSpanContainerTraits<_TContainer>::size_change_lock(container_ref))
+			, m_data(us::impl::TSpanContainerTraits<_TContainer>::data(container_ref)
+				+ us::impl::checked_span_offset(us::impl::TSpanContainerTraits<_TContainer>::size(container_ref), offset, count))
+			, m_size(count) {}
+		TXScopeSpan(const TXScopeSpan& src, size_type offset, size_type count)
+			: m_lock(src.m_lock), m_data(src.m_data + us::impl::checked_span_offset(src.m_size, offset, count)), m_size(count) {}
+
+		TXScopeSpan<_Ty>& operator=(const TXScopeSpan<_Ty>& _Right_cref) = delete;
+		void* operator new(size_t size) { return ::operator new(size); }
+
+		TXScopeSpan<_Ty>* operator&() { return this; }
+		const TXScopeSpan<_Ty>* operator&() const { return this; }
+
+		msevector_size_change_lock m_lock;
+		_Ty* m_data = nullptr;
+		size_type m_size = 0;
+
+		template <typename _Ty2> friend class TXScopeSpan;
+	};
+
+	/* TSpan is the non-scope counterpart of TXScopeSpan. It is constructed from a reference counting pointer to the
+	container, a copy of which it holds to ensure the container outlives the span. Iteration is done via a TXScopeSpan
+	constructed from it (or via for_each()). */
+	template <typename _Ty>
+	class TSpan {
+	public:
+		typedef _Ty element_type;
+		typedef typename std::remove_const<_Ty>::type value_type;
+		typedef _Ty& reference;
+		typedef size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		template<class _TContainer>
+		TSpan(const mse::TRefCountingPointer<_TContainer>& container_ptr)
+			: TSpan(container_ptr, *container_ptr, 0, us::impl::TSpanContainerTraits<_TContainer>::size(*container_ptr)) {}
+		template<class _TContainer>
+		TSpan(const mse::TRefCountingPointer<_TContainer>& container_ptr, size_type offset, size_type count)
+			: TSpan(container_ptr, *container_ptr, offset, count) {}
+		template<class _TContainer>
+		TSpan(const mse::TRefCountingConstPointer<_TContainer>& container_ptr)
+			: TSpan(container_ptr, *container_ptr, 0, us::impl::TSpanContainerTraits<const _TContainer>::size(*container_ptr)) {}
+		template<class _TContainer>
+		TSpan(const mse::TRefCountingConstPointer<_TContainer>& container_ptr, size_type offset, size_type count)
+			: TSpan(container_ptr, *container_ptr, offset, count) {}
+		TSpan(const TSpan& src) = default;
+		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
+		TSpan(const TSpan<_Ty2>& src) : m_keep_alive(src.m_keep_alive), m_lock(src.m_lock), m_data(src.m_data), m_size(src.m_size) {}
+
+		reference operator[](size_type _P) const {
+			if (m_size <= _P) { MSE_THROW(msearray_range_error("out of bounds index - reference operator[](size_type _P) - TSpan")); }
+			return m_data[_P];
+		}
+		reference at(size_type _P) const { return (*this)[_P]; }
+		size_type size() const { return m_size; }
+		bool empty() const { return (0 == m_size); }
+
+		TSpan subspan(size_type offset, size_type count) const { return TSpan(*this, offset, count); }
+		TSpan subspan(size_type offset) const {
+			return TSpan(*this, offset, m_size - us::impl::checked_span_offset(m_size, offset, 0));
+		}
+		TSpan first(size_type count) const { return subspan(0, count); }
+		TSpan last(size_type count) const {
+			us::impl::checked_span_offset(m_size, 0, count);
+			return subspan(m_size - count, count);
+		}
+
+		template<class _TFunction>
+		_TFunction for_each(_TFunction func) const {
+			auto data = m_data;
+			const auto size = m_size;
+			for (size_type i = 0; i < size; i += 1) {
+				func(data[i]);
+			}
+			return func;
+		}
+
+	private:
+		template<class _TContainerPointer, class _TContainer>
+		TSpan(const _TContainerPointer& container_ptr, _TContainer& container_ref, size_type offset, size_type count)
+			: m_keep_alive(container_ptr), m_lock(us::impl::TSpanContainerTraits<_TContainer>::size_change_lock(container_ref))
+			, m_data(us::impl::TSpanContainerTraits<_TContainer>::data(container_ref)
+				+ us::impl::checked_span_offset(us::impl::TSpanContainerTraits<_TContainer>::size(container_ref), offset, count))
+			, m_size(count) {}
+		TSpan(const TSpan& src, size_type offset, size_type count)
+			: m_keep_alive(src.m_keep_alive), m_lock(src.m_lock)
+			, m_data(src.m_data + us::impl::checked_span_offset(src.m_size, offset, count)), m_size(count) {}
+
+		TSpan<_Ty>& operator=(const TSpan<_Ty>& _Right_cref) = delete;
+
+		/* m_keep_alive must be declared (and so destroyed) before (after) m_lock. */
+		mse::any m_keep_alive;
+		msevector_size_change_lock m_lock;
+		_Ty* m_data = nullptr;
+		size_type m_size = 0;
+
+		template <typename _Ty2> friend class TSpan;
+		template <typename _Ty2> friend class TXScopeSpan;
+	};
+
 	template <typename _Ty>
 	class TOpaqueWrapper {
 	public:
@@ -1646,6 +1959,16 @@ namespace mse {
 
 	static void s_poly_test1() {
 #ifdef MSE_SELF_TESTS
+		{
+			/* These can be relocated without throwing, so they're held inline by the type-erased pointers and iterators. */
+			static_assert(us::impl::TErasedObjectIsInline<mse::TRefCountingPointer<int>>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<mse::TRefCountingFixedConstPointer<int>>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<mse::TXScopeFixedPointer<int>>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<std::shared_ptr<int>>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<typename mse::msevector<int>::ss_iterator_type>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<typename mse::msearray<int, 1>::ss_const_iterator_type>::value, "");
+			static_assert(us::impl::TErasedObjectIsInline<typename mse::mstd::vector<int>::iterator>::value, "");
+		}
 		{
 			class A {
 			public:
@@ -1845,6 +2168,46 @@ namespace mse {
 				ara_iter1 = ara_iter2;
 				auto res42 = (*ara_iter1);
 			}
+
+			{
+				mse::TXScopeObj<mse::msevector<int>> msevector1_xscpobj = mse::msevector<int>{ 1, 2, 3, 4, 5 };
+				{
+					mse::TXScopeSpan<int> span1(&msevector1_xscpobj, 1, 3);
+					mse::TXScopeSpan<const int> const_span1 = span1.subspan(1);
+					assert((2 == const_span1.size()) && (4 == const_span1[1]));
+					bool expected_exception = false;
+					try {
+						auto res1 = span1[3];
+					}
+					catch (...) {
+						expected_exception = true;
+					}
+					assert(expected_exception);
+					expected_exception = false;
+					try {
+						/* The vector can't be resized while a span of it exists. */
+						msevector1_xscpobj.resize(2);
+					}
+					catch (...) {
+						expected_exception = true;
+					}
+					assert(expected_exception && (5 == msevector1_xscpobj.size()));
+				}
+				/* The span (and so the lock) is gone. */
+				msevector1_xscpobj.resize(2);
+			}
+			{
+				/* A TXScopeSpan can be constructed from a TSpan, but not from a temporary one. */
+				static_assert(std::is_constructible<mse::TXScopeSpan<int>, mse::TSpan<int>&>::value, "");
+				static_assert(std::is_constructible<mse::TXScopeSpan<const int>, const mse::TSpan<int>&>::value, "");
+				static_assert(!std::is_constructible<mse::TXScopeSpan<int>, mse::TSpan<int>>::value, "");
+				static_assert(!std::is_constructible<mse::TXScopeSpan<const int>, mse::TSpan<int>&&>::value, "");
+
+				auto msevector2_refcptr = mse::make_refcounting<mse::msevector<int>>(mse::msevector<int>{ 1, 2, 3 });
+				mse::TSpan<int> span2(msevector2_refcptr);
+				mse::TXScopeSpan<int> span3(span2);
+				assert(2 == span3[1]);
+			}
 			int q = 3;
 		}
 #endif // MSE_SELF_TESTS
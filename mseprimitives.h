@@ -188,7 +188,7 @@ namespace mse {
 		TIntBase1() : m_val(0) {}
 
 		// Copy constructor
-		TIntBase1(const TIntBase1 &x) : m_val(x.m_val) { note_value_assignment(); };
+		TIntBase1(const TIntBase1 &x) noexcept : m_val(x.m_val) { note_value_assignment(); };
 
 		// Constructors from primitive integer types
 		explicit TIntBase1(_Ty   x) { note_value_assignment(); m_val = x; }
@@ -486,7 +486,7 @@ namespace mse {
 		CSize_t() : _Myt() {}
 
 		// Copy constructor
-		CSize_t(const CSize_t &x) : _Myt(x) {};
+		CSize_t(const CSize_t &x) noexcept : _Myt(x) {};
 		CSize_t(const _Myt &x) : _Myt(x) {};
 
 		// Assignment operator
@@ -9,21 +9,32 @@
 #define MSEREFCOUNTING_H_
 
 //include "mseprimitives.h"
+#include "mseinstrumentation.h"
 #include <memory>
 #include <iostream>
 #include <utility>
 #include <cassert>
 #include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 
 /* for the test functions */
 #include <map>
 #include <string>
+#include <thread>
 
 #ifdef MSE_SAFER_SUBSTITUTES_DISABLED
 #define MSE_REFCOUNTINGPOINTER_DISABLED
 #endif /*MSE_SAFER_SUBSTITUTES_DISABLED*/
 
+#ifndef MSE_REFCOUNTINGPOINTER_COUNTER_TYPE
+#define MSE_REFCOUNTINGPOINTER_COUNTER_TYPE std::uint32_t
+#endif // !MSE_REFCOUNTINGPOINTER_COUNTER_TYPE
+
 #ifdef MSE_CUSTOM_THROW_DEFINITION
 #include <iostream>
 #define MSE_THROW(x) MSE_CUSTOM_THROW_DEFINITION(x)
@@ -45,6 +56,43 @@ namespace mse {
 	TRefCountingFixedPointer<X> make_refcounting(Args&&... args) {
 		return std::make_shared<X>(std::forward<Args>(args)...);
 	}
+
+	class CRefCountingArena {
+	public:
+		CRefCountingArena(size_t chunk_size = 0) {}
+		void release_all() {}
+	};
+	template <class X> using TArenaRefCountingPointer = std::shared_ptr<X>;
+	template <class X> using TArenaRefCountingConstPointer = std::shared_ptr<const X>;
+
+	template <class X, class... Args>
+	TArenaRefCountingPointer<X> make_refcounting_in(CRefCountingArena& arena, Args&&... args) {
+		return std::make_shared<X>(std::forward<Args>(args)...);
+	}
+
+	template <class X> using TAtomicRefCountingPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingNotNullPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingFixedPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingConstPointer = std::shared_ptr<const X>;
+	template <class X> using TAtomicRefCountingNotNullConstPointer = std::shared_ptr<const X>;
+	template <class X> using TAtomicRefCountingFixedConstPointer = std::shared_ptr<const X>;
+
+	template <class X, class... Args>
+	TAtomicRefCountingFixedPointer<X> make_atomic_refcounting(Args&&... args) {
+		return std::make_shared<X>(std::forward<Args>(args)...);
+	}
+
+	template <class X> using TBiasedRefCountingPointer = std::shared_ptr<X>;
+	template <class X> using TBiasedRefCountingNotNullPointer = std::shared_ptr<X>;
+	template <class X> using TBiasedRefCountingFixedPointer = std::shared_ptr<X>;
+	template <class X> using TBiasedRefCountingConstPointer = std::shared_ptr<const X>;
+	template <class X> using TBiasedRefCountingNotNullConstPointer = std::shared_ptr<const X>;
+	template <class X> using TBiasedRefCountingFixedConstPointer = std::shared_ptr<const X>;
+
+	template <class X, class... Args>
+	TBiasedRefCountingFixedPointer<X> make_biased_refcounting(Args&&... args) {
+		return std::make_shared<X>(std::forward<Args>(args)...);
+	}
 #else /*MSE_REFCOUNTINGPOINTER_DISABLED*/
 
 	class refcounting_null_dereference_error : public std::logic_error { public:
@@ -56,31 +104,215 @@ namespace mse {
 	template<typename _Ty> class TRefCountingNotNullConstPointer;
 	template<typename _Ty> class TRefCountingFixedConstPointer;
 
+	/* CRefCounter is the "control block" that precedes each object targeted by TRefCountingPointers. It has no vtable, just
+	the counter, whose type can be set with MSE_REFCOUNTINGPOINTER_COUNTER_TYPE. (For example, a 16 bit counter would allow
+	the control block to pack into 2 bytes when the target type's alignment permits, at the cost of limiting the number of
+	pointers to an object.) Targets of class type also get a 32 bit deleter index (see below). */
 	class CRefCounter {
-	private:
-		int m_counter;
-
 	public:
+		typedef MSE_REFCOUNTINGPOINTER_COUNTER_TYPE counter_type;
+
 		CRefCounter() : m_counter(1) {}
-		virtual ~CRefCounter() {}
 		void increment() { m_counter++; }
-		void decrement() { assert(0 <= m_counter); m_counter--; }
-		int use_count() const { return m_counter; }
-		virtual void* target_obj_address() const = 0;
+		void decrement() { assert(1 <= m_counter); m_counter--; }
+		counter_type use_count() const { return m_counter; }
+
+	private:
+		counter_type m_counter;
 	};
 
-	template<class Y>
-	class TRefWithTargetObj : public CRefCounter {
-	public:
-		Y m_object;
+	/* Thrown on an attempt to convert a refcounting pointer to a pointer to a base class subobject that isn't at the same
+	address as the object (i.e. a base class other than the first (non-empty) one). */
+	class refcounting_conversion_error : public std::logic_error { public:
+		using std::logic_error::logic_error;
+	};
 
-		template<class ... Args>
-		TRefWithTargetObj(Args && ...args) : m_object(args...) {}
+	namespace us {
+		namespace impl {
+#ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+			static const size_t sc_refcounting_default_new_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else // __STDCPP_DEFAULT_NEW_ALIGNMENT__
+			static const size_t sc_refcounting_default_new_alignment = alignof(std::max_align_t);
+#endif // __STDCPP_DEFAULT_NEW_ALIGNMENT__
+
+			inline void* refcounting_allocate(size_t size, size_t alignment) {
+#ifdef __cpp_aligned_new
+				if (sc_refcounting_default_new_alignment < alignment) {
+					return ::operator new(size, std::align_val_t(alignment));
+				}
+#else // __cpp_aligned_new
+				(void)alignment;
+#endif // __cpp_aligned_new
+				return ::operator new(size);
+			}
+			inline void refcounting_deallocate(void* ptr, size_t alignment) {
+#ifdef __cpp_aligned_new
+				if (sc_refcounting_default_new_alignment < alignment) {
+					::operator delete(ptr, std::align_val_t(alignment));
+					return;
+				}
+#else // __cpp_aligned_new
+				(void)alignment;
+#endif // __cpp_aligned_new
+				::operator delete(ptr);
+			}
+
+			/* The target object is normally destroyed via the destructor of the pointer's target type, selected at compile
+			time. That's not enough when a pointer to an object of class type has been converted to a pointer to a base class
+			that doesn't have a virtual destructor. So the control block of an object of class type also has a 32 bit deleter
+			index that is zero unless such a conversion has occurred, in which case it identifies a (registered) function that
+			destroys the object as the type it was converted from. Objects of non-class type can only be targeted through
+			pointers to their own type, so their control block is just the counter. */
+			class CRefCountingDeleterRegistry {
+			public:
+				typedef void(*destroy_fn_type)(void* ref_ptr);
+
+				static CRefCountingDeleterRegistry& instance() {
+					/* Never destroyed, so that objects released during static destruction can still be destroyed. */
+					static CRefCountingDeleterRegistry* s_instance_ptr = new CRefCountingDeleterRegistry();
+					return *s_instance_ptr;
+				}
+				std::uint32_t register_deleter(destroy_fn_type destroy_fn) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					m_destroy_fns.push_back(destroy_fn);
+					return std::uint32_t(m_destroy_fns.size());
+				}
+				destroy_fn_type deleter(std::uint32_t deleter_index) const {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					return m_destroy_fns.at(deleter_index - 1);
+				}
+
+			private:
+				CRefCountingDeleterRegistry() {}
+
+				mutable std::mutex m_mutex;
+				std::vector<destroy_fn_type> m_destroy_fns;
+			};
+
+			template<class _TRefCounter>
+			class TRefCounterWithDeleterIndex : public _TRefCounter {
+			public:
+				std::atomic<std::uint32_t> m_deleter_index{ 0 };
+			};
 
-		void* target_obj_address() const {
-			return const_cast<void *>(static_cast<const void *>(std::addressof(m_object)));
+			template<class _TRefCounter, class Y>
+			using TRefCountingControlBlock = typename std::conditional<std::is_class<Y>::value
+				, TRefCounterWithDeleterIndex<_TRefCounter>, _TRefCounter>::type;
+
+			/* The control block and the target object share a single allocation, with the target object following the control
+			block at an offset determined (at compile time) by the target type. So a pointer only needs to hold the address of
+			the control block. */
+			template<class _TRefCounter, class Y>
+			class TRefCounterWithTargetObj : public TRefCountingControlBlock<_TRefCounter, typename std::remove_cv<Y>::type> {
+			public:
+				typedef typename std::remove_cv<Y>::type object_type;
+				typedef TRefCountingControlBlock<_TRefCounter, object_type> control_block_type;
+				static_assert(std::is_trivially_destructible<control_block_type>::value, "");
+				static const size_t sc_required_alignment = (alignof(control_block_type) < alignof(object_type)) ? alignof(object_type) : alignof(control_block_type);
+				/* The alignment the allocation is made with. (The default unless the object is over-aligned.) */
+				static const size_t sc_alignment = (sc_required_alignment <= sc_refcounting_default_new_alignment) ? sc_refcounting_default_new_alignment : sc_required_alignment;
+				static const size_t sc_object_offset = ((sizeof(control_block_type) + alignof(object_type) - 1) / alignof(object_type)) * alignof(object_type);
+
+				template<class ... Args>
+				static TRefCounterWithTargetObj* make(Args && ...args) {
+					auto storage_ptr = refcounting_allocate(sc_object_offset + sizeof(object_type), sc_alignment);
+					auto retval = ::new (storage_ptr) TRefCounterWithTargetObj();
+					try {
+						::new (static_cast<void*>(object_ptr(retval))) object_type(std::forward<Args>(args)...);
+					}
+					catch (...) {
+						refcounting_deallocate(storage_ptr, sc_alignment);
+						throw;
+					}
+					return retval;
+				}
+				static object_type* object_ptr(_TRefCounter* ref_ptr) {
+					return reinterpret_cast<object_type*>(reinterpret_cast<char*>(static_cast<control_block_type*>(ref_ptr)) + sc_object_offset);
+				}
+				/* Destroys the target object (as an object_type) and deallocates the control block. */
+				static void destroy(_TRefCounter* ref_ptr) {
+					object_ptr(ref_ptr)->~object_type();
+					/* The control block is trivially destructible. */
+					refcounting_deallocate(static_cast<void*>(static_cast<control_block_type*>(ref_ptr)), sc_alignment);
+				}
+				static void destroy_erased(void* ref_ptr) {
+					destroy(static_cast<_TRefCounter*>(ref_ptr));
+				}
+
+			private:
+				TRefCounterWithTargetObj() {}
+			};
+
+			template<class X, class _TRefCounter>
+			X* refcounted_obj_ptr(_TRefCounter* ref_ptr) {
+				return TRefCounterWithTargetObj<_TRefCounter, X>::object_ptr(ref_ptr);
+			}
+
+			template<class _TRefCounter, class Y>
+			std::uint32_t refcounting_deleter_index() {
+				static const std::uint32_t s_deleter_index = CRefCountingDeleterRegistry::instance().register_deleter(
+					&TRefCounterWithTargetObj<_TRefCounter, Y>::destroy_erased);
+				return s_deleter_index;
+			}
+
+			template<class X>
+			class TRefCountingTargetMayNeedDeleterIndex : public std::integral_constant<bool
+				, std::is_class<X>::value && (!std::has_virtual_destructor<X>::value)> {};
+
+			template<class X, class _TRefCounter>
+			void destroy_refcounted_obj(std::true_type, _TRefCounter* ref_ptr) {
+				const auto deleter_index = static_cast<TRefCounterWithDeleterIndex<_TRefCounter>*>(ref_ptr)->m_deleter_index.load(std::memory_order_relaxed);
+				if (0 != deleter_index) {
+					CRefCountingDeleterRegistry::instance().deleter(deleter_index)(ref_ptr);
+				}
+				else {
+					TRefCounterWithTargetObj<_TRefCounter, X>::destroy(ref_ptr);
+				}
+			}
+			template<class X, class _TRefCounter>
+			void destroy_refcounted_obj(std::false_type, _TRefCounter* ref_ptr) {
+				TRefCounterWithTargetObj<_TRefCounter, X>::destroy(ref_ptr);
+			}
+			/* Destroys the target object (targeted as an X) and deallocates its control block. */
+			template<class X, class _TRefCounter>
+			void destroy_refcounted_obj(_TRefCounter* ref_ptr) {
+				typedef typename std::remove_cv<X>::type object_type;
+				destroy_refcounted_obj<object_type>(typename TRefCountingTargetMayNeedDeleterIndex<object_type>::type(), ref_ptr);
+			}
+
+			template<class X, class Y, class _TRefCounter>
+			void note_refcounting_conversion(std::true_type, _TRefCounter* ref_ptr) {
+				/* If the deleter index is already set, it stays valid. Otherwise Y is either the type the object was created
+				as, or has a virtual destructor. */
+				auto& deleter_index_ref = static_cast<TRefCounterWithDeleterIndex<_TRefCounter>*>(ref_ptr)->m_deleter_index;
+				if (0 == deleter_index_ref.load(std::memory_order_relaxed)) {
+					deleter_index_ref.store(refcounting_deleter_index<_TRefCounter, Y>(), std::memory_order_relaxed);
+				}
+			}
+			template<class X, class Y, class _TRefCounter>
+			void note_refcounting_conversion(std::false_type, _TRefCounter*) {}
+			/* Called when a pointer targeting (an object as) a Y is converted to a pointer targeting an X. */
+			template<class X, class Y, class _TRefCounter>
+			void note_refcounting_conversion(_TRefCounter* ref_ptr, Y* y_ptr) {
+				typedef typename std::remove_cv<X>::type x_type;
+				typedef typename std::remove_cv<Y>::type y_type;
+				static_assert(std::is_convertible<Y*, X*>::value, "");
+				static_assert((TRefCounterWithTargetObj<_TRefCounter, x_type>::sc_object_offset == TRefCounterWithTargetObj<_TRefCounter, y_type>::sc_object_offset)
+					&& (TRefCounterWithTargetObj<_TRefCounter, x_type>::sc_alignment == TRefCounterWithTargetObj<_TRefCounter, y_type>::sc_alignment)
+					, "conversion to a pointer to an over-aligned base class requires that it have the same alignment as the target type");
+				if (!ref_ptr) { return; }
+				/* The target object's address is computed from the control block's, so it has to be the same for both types. */
+				if (static_cast<const volatile void*>(static_cast<X*>(y_ptr)) != static_cast<const volatile void*>(y_ptr)) {
+					MSE_THROW(refcounting_conversion_error("conversion to a pointer to a base class subobject at a different address is not supported - mse::TRefCountingPointer"));
+				}
+				note_refcounting_conversion<x_type, y_type>(std::integral_constant<bool, TRefCountingTargetMayNeedDeleterIndex<x_type>::value
+					&& (!std::is_same<x_type, y_type>::value)>(), ref_ptr);
+			}
 		}
-	};
+	}
+
+	template<class Y>
+	using TRefWithTargetObj = us::impl::TRefCounterWithTargetObj<CRefCounter, Y>;
 
 	/* Some code originally came from this stackoverflow post:
 	http://stackoverflow.com/questions/6593770/creating-a-non-thread-safe-shared-ptr */
@@ -98,10 +330,10 @@ namespace mse {
 		~TRefCountingPointer() {
 			release();
 		}
-		TRefCountingPointer(const TRefCountingPointer& r) {
+		TRefCountingPointer(const TRefCountingPointer& r) noexcept {
 			acquire(r.m_ref_with_target_obj_ptr);
 		}
-		operator bool() const { return nullptr != get(); }
+		operator bool() const { return nullptr != m_ref_with_target_obj_ptr; }
 		void clear() { (*this) = TRefCountingPointer<X>(nullptr); }
 		TRefCountingPointer& operator=(const TRefCountingPointer& r) {
 			if (this != &r) {
@@ -128,13 +360,13 @@ namespace mse {
 		*/
 		template <class Y> friend class TRefCountingPointer;
 		template <class Y> TRefCountingPointer(const TRefCountingPointer<Y>& r) {
+			us::impl::note_refcounting_conversion<X>(r.m_ref_with_target_obj_ptr, r.get());
 			acquire(r.m_ref_with_target_obj_ptr);
 		}
 		template <class Y> TRefCountingPointer& operator=(const TRefCountingPointer<Y>& r) {
-			if (this != &r) {
-				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
-			}
+			us::impl::note_refcounting_conversion<X>(r.m_ref_with_target_obj_ptr, r.get());
+			auto_release keep(m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr);
 			return *this;
 		}
 		template <class Y> bool operator<(const TRefCountingPointer<Y>& r) const {
@@ -149,14 +381,14 @@ namespace mse {
 #endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
 
 		X& operator*() const {
+			MSE_SAFETY_CHECK_COUNT("TRefCountingPointer", null_check);
 			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return (*x_ptr);
+			return (*target_obj_ptr(m_ref_with_target_obj_ptr));
 		}
 		X* operator->() const {
+			MSE_SAFETY_CHECK_COUNT("TRefCountingPointer", null_check);
 			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return x_ptr;
+			return target_obj_ptr(m_ref_with_target_obj_ptr);
 		}
 		bool unique() const {
 			return (m_ref_with_target_obj_ptr ? (m_ref_with_target_obj_ptr->use_count() == 1) : true);
@@ -164,25 +396,21 @@ namespace mse {
 
 		template <class... Args>
 		static TRefCountingPointer make(Args&&... args) {
-			auto new_ptr = new TRefWithTargetObj<X>(std::forward<Args>(args)...);
+			auto new_ptr = TRefWithTargetObj<X>::make(std::forward<Args>(args)...);
 			TRefCountingPointer retval(new_ptr);
 			return retval;
 		}
 
 	protected:
 		X* get() const {
-			if (!m_ref_with_target_obj_ptr) {
-				return nullptr;
-			}
-			else {
-				X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-				return x_ptr;
-			}
+			return m_ref_with_target_obj_ptr ? target_obj_ptr(m_ref_with_target_obj_ptr) : nullptr;
 		}
 
 	private:
-		explicit TRefCountingPointer(TRefWithTargetObj<X>* p/* = nullptr*/) {
-			m_ref_with_target_obj_ptr = p;
+		explicit TRefCountingPointer(TRefWithTargetObj<X>* p/* = nullptr*/) : m_ref_with_target_obj_ptr(p) {}
+
+		static X* target_obj_ptr(CRefCounter* c) {
+			return us::impl::refcounted_obj_ptr<X>(c);
 		}
 
 		void acquire(CRefCounter* c) {
@@ -204,15 +432,15 @@ namespace mse {
 			// decrement the count, delete if it is nullptr
 			if (ref_with_target_obj_ptr) {
 				if (1 == ref_with_target_obj_ptr->use_count()) {
-					delete ref_with_target_obj_ptr;
+					us::impl::destroy_refcounted_obj<X>(ref_with_target_obj_ptr);
 				}
 				else {
 					ref_with_target_obj_ptr->decrement();
 				}
-				ref_with_target_obj_ptr = nullptr;
 			}
 		}
 
+		/* The target object's address is computed (at a compile-time offset) from the control block's. */
 		CRefCounter* m_ref_with_target_obj_ptr;
 
 		friend class TRefCountingNotNullPointer<X>;
@@ -222,7 +450,7 @@ namespace mse {
 	template<typename _Ty>
 	class TRefCountingNotNullPointer : public TRefCountingPointer<_Ty> {
 	public:
-		TRefCountingNotNullPointer(const TRefCountingNotNullPointer& src_cref) : TRefCountingPointer<_Ty>(src_cref) {}
+		TRefCountingNotNullPointer(const TRefCountingNotNullPointer& src_cref) noexcept : TRefCountingPointer<_Ty>(src_cref) {}
 		virtual ~TRefCountingNotNullPointer() {}
 		TRefCountingNotNullPointer<_Ty>& operator=(const TRefCountingNotNullPointer<_Ty>& _Right_cref) {
 			TRefCountingPointer<_Ty>::operator=(_Right_cref);
@@ -246,14 +474,14 @@ namespace mse {
 	template<typename _Ty>
 	class TRefCountingFixedPointer : public TRefCountingNotNullPointer<_Ty> {
 	public:
-		TRefCountingFixedPointer(const TRefCountingFixedPointer& src_cref) : TRefCountingNotNullPointer<_Ty>(src_cref) {}
+		TRefCountingFixedPointer(const TRefCountingFixedPointer& src_cref) noexcept : TRefCountingNotNullPointer<_Ty>(src_cref) {}
 		virtual ~TRefCountingFixedPointer() {}
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator _Ty*() const { return TRefCountingNotNullPointer<_Ty>::operator _Ty*(); }
 
 		template <class... Args>
 		static TRefCountingFixedPointer make(Args&&... args) {
-			auto new_ptr = new TRefWithTargetObj<_Ty>(std::forward<Args>(args)...);
+			auto new_ptr = TRefWithTargetObj<_Ty>::make(std::forward<Args>(args)...);
 			TRefCountingFixedPointer retval(new_ptr);
 			return retval;
 		}
@@ -282,13 +510,13 @@ namespace mse {
 		~TRefCountingConstPointer() {
 			release();
 		}
-		TRefCountingConstPointer(const TRefCountingConstPointer& r) {
+		TRefCountingConstPointer(const TRefCountingConstPointer& r) noexcept {
 			acquire(r.m_ref_with_target_obj_ptr);
 		}
-		TRefCountingConstPointer(const TRefCountingPointer<X>& r) {
+		TRefCountingConstPointer(const TRefCountingPointer<X>& r) noexcept {
 			acquire(r.m_ref_with_target_obj_ptr);
 		}
-		operator bool() const { return nullptr != get(); }
+		operator bool() const { return nullptr != m_ref_with_target_obj_ptr; }
 		void clear() { (*this) = TRefCountingConstPointer<X>(nullptr); }
 		TRefCountingConstPointer& operator=(const TRefCountingConstPointer& r) {
 			if (this != &r) {
@@ -322,13 +550,13 @@ namespace mse {
 		*/
 		template <class Y> friend class TRefCountingConstPointer;
 		template <class Y> TRefCountingConstPointer(const TRefCountingConstPointer<Y>& r) {
+			us::impl::note_refcounting_conversion<const X>(r.m_ref_with_target_obj_ptr, r.get());
 			acquire(r.m_ref_with_target_obj_ptr);
 		}
 		template <class Y> TRefCountingConstPointer& operator=(const TRefCountingConstPointer<Y>& r) {
-			if (this != &r) {
-				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
-			}
+			us::impl::note_refcounting_conversion<const X>(r.m_ref_with_target_obj_ptr, r.get());
+			auto_release keep(m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr);
 			return *this;
 		}
 		template <class Y> bool operator<(const TRefCountingConstPointer<Y>& r) const {
@@ -343,31 +571,27 @@ namespace mse {
 #endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
 
 		const X& operator*() const {
+			MSE_SAFETY_CHECK_COUNT("TRefCountingConstPointer", null_check);
 			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return (*x_ptr);
+			return (*target_obj_ptr(m_ref_with_target_obj_ptr));
 		}
 		const X* operator->() const {
+			MSE_SAFETY_CHECK_COUNT("TRefCountingConstPointer", null_check);
 			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return x_ptr;
+			return target_obj_ptr(m_ref_with_target_obj_ptr);
 		}
 		const X* get() const {
-			if (!m_ref_with_target_obj_ptr) {
-				return nullptr;
-			}
-			else {
-				X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-				return x_ptr;
-			}
+			return m_ref_with_target_obj_ptr ? target_obj_ptr(m_ref_with_target_obj_ptr) : nullptr;
 		}
 		bool unique() const {
 			return (m_ref_with_target_obj_ptr ? (m_ref_with_target_obj_ptr->use_count() == 1) : true);
 		}
 
 	private:
-		explicit TRefCountingConstPointer(TRefWithTargetObj<X>* p/* = nullptr*/) {
-			m_ref_with_target_obj_ptr = p;
+		explicit TRefCountingConstPointer(TRefWithTargetObj<X>* p/* = nullptr*/) : m_ref_with_target_obj_ptr(p) {}
+
+		static const X* target_obj_ptr(CRefCounter* c) {
+			return us::impl::refcounted_obj_ptr<const X>(c);
 		}
 
 		void acquire(CRefCounter* c) {
@@ -389,12 +613,11 @@ namespace mse {
 			// decrement the count, delete if it is nullptr
 			if (ref_with_target_obj_ptr) {
 				if (1 == ref_with_target_obj_ptr->use_count()) {
-					delete ref_with_target_obj_ptr;
+					us::impl::destroy_refcounted_obj<const X>(ref_with_target_obj_ptr);
 				}
 				else {
 					ref_with_target_obj_ptr->decrement();
 				}
-				ref_with_target_obj_ptr = nullptr;
 			}
 		}
 
@@ -406,8 +629,8 @@ namespace mse {
 	template<typename _Ty>
 	class TRefCountingNotNullConstPointer : public TRefCountingConstPointer<_Ty> {
 	public:
-		TRefCountingNotNullConstPointer(const TRefCountingNotNullConstPointer& src_cref) : TRefCountingConstPointer<_Ty>(src_cref) {}
-		TRefCountingNotNullConstPointer(const TRefCountingNotNullPointer<_Ty>& src_cref) : TRefCountingConstPointer<_Ty>(src_cref) {}
+		TRefCountingNotNullConstPointer(const TRefCountingNotNullConstPointer& src_cref) noexcept : TRefCountingConstPointer<_Ty>(src_cref) {}
+		TRefCountingNotNullConstPointer(const TRefCountingNotNullPointer<_Ty>& src_cref) noexcept : TRefCountingConstPointer<_Ty>(src_cref) {}
 		virtual ~TRefCountingNotNullConstPointer() {}
 		TRefCountingNotNullConstPointer<_Ty>& operator=(const TRefCountingNotNullConstPointer<_Ty>& _Right_cref) {
 			TRefCountingConstPointer<_Ty>::operator=(_Right_cref);
@@ -429,8 +652,8 @@ namespace mse {
 	template<typename _Ty>
 	class TRefCountingFixedConstPointer : public TRefCountingNotNullConstPointer<_Ty> {
 	public:
-		TRefCountingFixedConstPointer(const TRefCountingFixedConstPointer& src_cref) : TRefCountingNotNullConstPointer<_Ty>(src_cref) {}
-		TRefCountingFixedConstPointer(const TRefCountingFixedPointer<_Ty>& src_cref) : TRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		TRefCountingFixedConstPointer(const TRefCountingFixedConstPointer& src_cref) noexcept : TRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		TRefCountingFixedConstPointer(const TRefCountingFixedPointer<_Ty>& src_cref) noexcept : TRefCountingNotNullConstPointer<_Ty>(src_cref) {}
 		virtual ~TRefCountingFixedConstPointer() {}
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator const _Ty*() const { return TRefCountingNotNullConstPointer<_Ty>::operator _Ty*(); }
@@ -442,6 +665,998 @@ namespace mse {
 		//const TRefCountingFixedConstPointer<_Ty>* operator&() const { return this; }
 	};
 
+
+	class refcounting_arena_dangling_error : public std::logic_error { public:
+		using std::logic_error::logic_error;
+	};
+
+	class CRefCountingArena;
+	template<typename _Ty> class TArenaRefCountingPointer;
+	template<typename _Ty> class TArenaRefCountingConstPointer;
+
+	namespace us {
+		namespace impl {
+			/* An arena's current generation is kept in a "slot" that is never deallocated (slots are recycled instead), so
+			pointers can always safely check whether the arena they were created in has since released its objects (or been
+			destroyed). Generation values are never reused. */
+			class CArenaGenerationSlot {
+			public:
+				std::uint64_t m_generation = 0;
+
+				static std::uint64_t new_generation() {
+					static std::atomic<std::uint64_t> s_last_generation(0);
+					return ++s_last_generation;
+				}
+				static CArenaGenerationSlot* acquire() {
+					auto& free_slots = s_free_slots();
+					std::lock_guard<std::mutex> lock(s_free_slots_mutex());
+					CArenaGenerationSlot* retval = nullptr;
+					if (free_slots.empty()) {
+						retval = new CArenaGenerationSlot();
+					}
+					else {
+						retval = free_slots.back();
+						free_slots.pop_back();
+					}
+					retval->m_generation = new_generation();
+					return retval;
+				}
+				static void release(CArenaGenerationSlot* slot_ptr) {
+					slot_ptr->m_generation = new_generation();
+					auto& free_slots = s_free_slots();
+					std::lock_guard<std::mutex> lock(s_free_slots_mutex());
+					free_slots.push_back(slot_ptr);
+				}
+
+			private:
+				/* These are intentionally never destroyed, as pointers may still refer to the slots after static destruction. */
+				static std::vector<CArenaGenerationSlot*>& s_free_slots() {
+					static std::vector<CArenaGenerationSlot*>* s_free_slots_ptr = new std::vector<CArenaGenerationSlot*>();
+					return *s_free_slots_ptr;
+				}
+				static std::mutex& s_free_slots_mutex() {
+					static std::mutex* s_mutex_ptr = new std::mutex();
+					return *s_mutex_ptr;
+				}
+			};
+
+			/* Each object allocated in an arena is preceded by one of these. Rather than a vtable, it holds a pointer to a
+			function (instantiated for the object's type) that destroys the object. */
+			class CArenaObjHeader {
+			public:
+				CArenaObjHeader* m_prev_obj_ptr;
+				void(*m_destroy_fn)(CArenaObjHeader*);
+				std::uint32_t m_counter;
+			};
+
+			template<class Y>
+			class TArenaObjLayout {
+			public:
+				static const size_t sc_obj_offset = ((sizeof(CArenaObjHeader) + alignof(Y) - 1) / alignof(Y)) * alignof(Y);
+				static const size_t sc_alignment = (alignof(Y) > alignof(CArenaObjHeader)) ? alignof(Y) : alignof(CArenaObjHeader);
+				static Y* obj_ptr(CArenaObjHeader* header_ptr) {
+					return reinterpret_cast<Y*>(reinterpret_cast<unsigned char*>(header_ptr) + sc_obj_offset);
+				}
+				static void destroy(CArenaObjHeader* header_ptr) {
+					obj_ptr(header_ptr)->~Y();
+				}
+			};
+
+			template<typename _TPointee>
+			class TArenaRefCountingPointerBase {
+			public:
+				TArenaRefCountingPointerBase() {}
+				TArenaRefCountingPointerBase(const TArenaRefCountingPointerBase& src) : m_obj_ptr(src.m_obj_ptr), m_header_ptr(src.m_header_ptr)
+					, m_slot_ptr(src.m_slot_ptr), m_generation(src.m_generation) {
+					acquire();
+				}
+				template<typename _TPointee2, class = typename std::enable_if<std::is_convertible<_TPointee2*, _TPointee*>::value, void>::type>
+				TArenaRefCountingPointerBase(const TArenaRefCountingPointerBase<_TPointee2>& src) : m_obj_ptr(src.m_obj_ptr), m_header_ptr(src.m_header_ptr)
+					, m_slot_ptr(src.m_slot_ptr), m_generation(src.m_generation) {
+					acquire();
+				}
+				~TArenaRefCountingPointerBase() {
+					release();
+				}
+				TArenaRefCountingPointerBase& operator=(const TArenaRefCountingPointerBase& src) {
+					if (this != &src) {
+						/* The source's target is acquired before our current target is released, in case the source is
+						(indirectly) owned by our current target. */
+						TArenaRefCountingPointerBase keep(src);
+						swap(keep);
+					}
+					return (*this);
+				}
+				void swap(TArenaRefCountingPointerBase& other) {
+					std::swap(m_obj_ptr, other.m_obj_ptr);
+					std::swap(m_header_ptr, other.m_header_ptr);
+					std::swap(m_slot_ptr, other.m_slot_ptr);
+					std::swap(m_generation, other.m_generation);
+				}
+
+				/* Note that a pointer whose target has been released (by its arena) is still non-null. */
+				operator bool() const { return (nullptr != m_header_ptr); }
+				/* Returns true if the pointer's arena has released its objects (or been destroyed) since the pointer was set. */
+				bool is_dangling() const { return ((nullptr != m_header_ptr) && (!is_current())); }
+				bool unique() const {
+					return ((nullptr != m_header_ptr) && is_current()) ? (1 == m_header_ptr->m_counter) : true;
+				}
+
+				_TPointee* checked_get() const {
+					MSE_SAFETY_CHECK_COUNT("TArenaRefCountingPointer", null_check);
+					if (nullptr == m_header_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TArenaRefCountingPointer")); }
+					if (!is_current()) { MSE_THROW(refcounting_arena_dangling_error("attempt to dereference a pointer to an object released by its arena - mse::TArenaRefCountingPointer")); }
+					return m_obj_ptr;
+				}
+				_TPointee* unchecked_get() const { return m_obj_ptr; }
+
+			protected:
+				TArenaRefCountingPointerBase(_TPointee* obj_ptr, CArenaObjHeader* header_ptr, const CArenaGenerationSlot* slot_ptr)
+					: m_obj_ptr(obj_ptr), m_header_ptr(header_ptr), m_slot_ptr(slot_ptr), m_generation(slot_ptr->m_generation) {}
+
+			private:
+
+				bool is_current() const { return (m_slot_ptr->m_generation == m_generation); }
+				void acquire() {
+					if ((nullptr != m_header_ptr) && is_current()) {
+						m_header_ptr->m_counter += 1;
+					}
+				}
+				void release() {
+					/* If the arena has (bulk) released its objects, the target has already been destroyed. */
+					if ((nullptr != m_header_ptr) && is_current()) {
+						assert(1 <= m_header_ptr->m_counter);
+						m_header_ptr->m_counter -= 1;
+						if (0 == m_header_ptr->m_counter) {
+							/* The target object is destroyed, but its memory isn't reclaimed until the arena releases its objects. */
+							m_header_ptr->m_destroy_fn(m_header_ptr);
+						}
+					}
+				}
+
+				_TPointee* m_obj_ptr = nullptr;
+				CArenaObjHeader* m_header_ptr = nullptr;
+				const CArenaGenerationSlot* m_slot_ptr = nullptr;
+				std::uint64_t m_generation = 0;
+
+				template<typename _TPointee2> friend class TArenaRefCountingPointerBase;
+			};
+		}
+	}
+
+	/* CRefCountingArena is a region (aka "bump") allocator for refcounted objects. Objects are created in the arena with
+	make_refcounting_in<>() and accessed via TArenaRefCountingPointers, which behave much like TRefCountingPointers. An object
+	is destroyed when its last pointer goes away, but its memory isn't freed until the arena's release_all() is called (or
+	the arena is destroyed), at which point all the arena's (remaining) objects are destroyed and their memory is released in
+	one pass. This is intended for things like parse trees or message graphs, where many nodes are created and then
+	discarded together. Any pointers to the released objects that remain are not (undetectably) left dangling, but rather
+	will throw an exception on any attempt to dereference them. Like TRefCountingPointer, it is not thread safe. */
+	class CRefCountingArena {
+	public:
+		CRefCountingArena(size_t chunk_size = sc_default_chunk_size) : m_chunk_size(chunk_size)
+			, m_generation_slot_ptr(us::impl::CArenaGenerationSlot::acquire()) {}
+		CRefCountingArena(const CRefCountingArena&) = delete;
+		CRefCountingArena& operator=(const CRefCountingArena&) = delete;
+		~CRefCountingArena() {
+			release_all();
+			while (nullptr != m_first_chunk_ptr) {
+				auto next_chunk_ptr = m_first_chunk_ptr->m_next_chunk_ptr;
+				::operator delete(m_first_chunk_ptr);
+				m_first_chunk_ptr = next_chunk_ptr;
+			}
+			us::impl::CArenaGenerationSlot::release(m_generation_slot_ptr);
+		}
+
+		/* Destroys all the (remaining) objects in the arena and makes its memory available for reuse. Any remaining pointers
+		to the arena's objects become "dangling" and will throw on dereference. */
+		void release_all() {
+			/* Invalidating the existing pointers first ensures that pointers held by the objects being destroyed don't
+			also try to destroy their targets. */
+			m_generation_slot_ptr->m_generation = us::impl::CArenaGenerationSlot::new_generation();
+			auto obj_header_ptr = m_last_obj_header_ptr;
+			m_last_obj_header_ptr = nullptr;
+			while (nullptr != obj_header_ptr) {
+				auto prev_obj_header_ptr = obj_header_ptr->m_prev_obj_ptr;
+				if (0 != obj_header_ptr->m_counter) {
+					obj_header_ptr->m_destroy_fn(obj_header_ptr);
+				}
+				obj_header_ptr = prev_obj_header_ptr;
+			}
+			/* The objects' destructors shouldn't be creating new objects in the arena being released. */
+			assert(nullptr == m_last_obj_header_ptr);
+			m_current_chunk_ptr = m_first_chunk_ptr;
+			m_current_offset = sizeof(CChunkHeader);
+			m_num_objects = 0;
+		}
+		/* The number of objects created since the last release. */
+		size_t num_objects() const { return m_num_objects; }
+
+		template <class X, class... Args>
+		TArenaRefCountingPointer<X> make(Args&&... args) {
+			typedef us::impl::TArenaObjLayout<X> layout_type;
+			static_assert(alignof(std::max_align_t) >= layout_type::sc_alignment, "over-aligned types are not supported");
+			auto mem_ptr = allocate(layout_type::sc_obj_offset + sizeof(X), layout_type::sc_alignment);
+			auto header_ptr = static_cast<us::impl::CArenaObjHeader*>(mem_ptr);
+			/* If the constructor throws, the memory is just left unused until the arena releases its objects. */
+			X* obj_ptr = ::new (static_cast<void*>(layout_type::obj_ptr(header_ptr))) X(std::forward<Args>(args)...);
+			header_ptr->m_destroy_fn = &layout_type::destroy;
+			header_ptr->m_counter = 1;
+			header_ptr->m_prev_obj_ptr = m_last_obj_header_ptr;
+			m_last_obj_header_ptr = header_ptr;
+			m_num_objects += 1;
+			return TArenaRefCountingPointer<X>(obj_ptr, header_ptr, m_generation_slot_ptr);
+		}
+
+		static const size_t sc_default_chunk_size = 64 * 1024;
+
+	private:
+		class CChunkHeader {
+		public:
+			CChunkHeader* m_next_chunk_ptr;
+			size_t m_size;
+		};
+
+		void* allocate(size_t size, size_t alignment) {
+			while (true) {
+				if (nullptr != m_current_chunk_ptr) {
+					size_t offset = ((m_current_offset + alignment - 1) / alignment) * alignment;
+					if (m_current_chunk_ptr->m_size >= offset + size) {
+						m_current_offset = offset + size;
+						return reinterpret_cast<unsigned char*>(m_current_chunk_ptr) + offset;
+					}
+					if (nullptr != m_current_chunk_ptr->m_next_chunk_ptr) {
+						/* Reuse the chunks retained from before the last release. */
+						m_current_chunk_ptr = m_current_chunk_ptr->m_next_chunk_ptr;
+						m_current_offset = sizeof(CChunkHeader);
+						continue;
+					}
+				}
+				size_t chunk_size = m_chunk_size;
+				const size_t min_chunk_size = sizeof(CChunkHeader) + alignof(std::max_align_t) + size;
+				if (min_chunk_size > chunk_size) {
+					chunk_size = min_chunk_size;
+				}
+				auto new_chunk_ptr = static_cast<CChunkHeader*>(::operator new(chunk_size));
+				new_chunk_ptr->m_next_chunk_ptr = nullptr;
+				new_chunk_ptr->m_size = chunk_size;
+				if (nullptr == m_current_chunk_ptr) {
+					m_first_chunk_ptr = new_chunk_ptr;
+				}
+				else {
+					m_current_chunk_ptr->m_next_chunk_ptr = new_chunk_ptr;
+				}
+				m_current_chunk_ptr = new_chunk_ptr;
+				m_current_offset = sizeof(CChunkHeader);
+			}
+		}
+
+		size_t m_chunk_size;
+		us::impl::CArenaGenerationSlot* m_generation_slot_ptr;
+		CChunkHeader* m_first_chunk_ptr = nullptr;
+		CChunkHeader* m_current_chunk_ptr = nullptr;
+		size_t m_current_offset = sizeof(CChunkHeader);
+		us::impl::CArenaObjHeader* m_last_obj_header_ptr = nullptr;
+		size_t m_num_objects = 0;
+	};
+
+	/* TArenaRefCountingPointer is the pointer type for objects allocated in a CRefCountingArena. */
+	template<typename X>
+	class TArenaRefCountingPointer : public us::impl::TArenaRefCountingPointerBase<X> {
+	public:
+		typedef us::impl::TArenaRefCountingPointerBase<X> base_class;
+		TArenaRefCountingPointer() {}
+		TArenaRefCountingPointer(std::nullptr_t) {}
+		TArenaRefCountingPointer(const TArenaRefCountingPointer& src) : base_class(src) {}
+		template<typename Y, class = typename std::enable_if<std::is_convertible<Y*, X*>::value, void>::type>
+		TArenaRefCountingPointer(const TArenaRefCountingPointer<Y>& src) : base_class(src) {}
+		TArenaRefCountingPointer& operator=(const TArenaRefCountingPointer& src) {
+			base_class::operator=(src);
+			return (*this);
+		}
+		void clear() { (*this) = TArenaRefCountingPointer(nullptr); }
+
+		X& operator*() const { return (*base_class::checked_get()); }
+		X* operator->() const { return base_class::checked_get(); }
+
+		template<typename Y>
+		bool operator==(const TArenaRefCountingPointer<Y>& r) const { return (base_class::unchecked_get() == r.unchecked_get()); }
+		template<typename Y>
+		bool operator!=(const TArenaRefCountingPointer<Y>& r) const { return (!((*this) == r)); }
+		template<typename Y>
+		bool operator<(const TArenaRefCountingPointer<Y>& r) const { return (base_class::unchecked_get() < r.unchecked_get()); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+
+	private:
+		TArenaRefCountingPointer(X* obj_ptr, us::impl::CArenaObjHeader* header_ptr, const us::impl::CArenaGenerationSlot* slot_ptr)
+			: base_class(obj_ptr, header_ptr, slot_ptr) {}
+
+		friend class CRefCountingArena;
+	};
+
+	template<typename X>
+	class TArenaRefCountingConstPointer : public us::impl::TArenaRefCountingPointerBase<const X> {
+	public:
+		typedef us::impl::TArenaRefCountingPointerBase<const X> base_class;
+		TArenaRefCountingConstPointer() {}
+		TArenaRefCountingConstPointer(std::nullptr_t) {}
+		TArenaRefCountingConstPointer(const TArenaRefCountingConstPointer& src) : base_class(src) {}
+		template<typename Y, class = typename std::enable_if<std::is_convertible<const Y*, const X*>::value, void>::type>
+		TArenaRefCountingConstPointer(const TArenaRefCountingConstPointer<Y>& src) : base_class(src) {}
+		template<typename Y, class = typename std::enable_if<std::is_convertible<Y*, const X*>::value, void>::type>
+		TArenaRefCountingConstPointer(const TArenaRefCountingPointer<Y>& src) : base_class(src) {}
+		TArenaRefCountingConstPointer& operator=(const TArenaRefCountingConstPointer& src) {
+			base_class::operator=(src);
+			return (*this);
+		}
+		void clear() { (*this) = TArenaRefCountingConstPointer(nullptr); }
+
+		const X& operator*() const { return (*base_class::checked_get()); }
+		const X* operator->() const { return base_class::checked_get(); }
+
+		template<typename Y>
+		bool operator==(const TArenaRefCountingConstPointer<Y>& r) const { return (base_class::unchecked_get() == r.unchecked_get()); }
+		template<typename Y>
+		bool operator!=(const TArenaRefCountingConstPointer<Y>& r) const { return (!((*this) == r)); }
+		template<typename Y>
+		bool operator<(const TArenaRefCountingConstPointer<Y>& r) const { return (base_class::unchecked_get() < r.unchecked_get()); }
+		template<typename Y>
+		bool operator==(const TArenaRefCountingPointer<Y>& r) const { return (base_class::unchecked_get() == r.unchecked_get()); }
+		template<typename Y>
+		bool operator!=(const TArenaRefCountingPointer<Y>& r) const { return (!((*this) == r)); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+	};
+
+	template <class X, class... Args>
+	TArenaRefCountingPointer<X> make_refcounting_in(CRefCountingArena& arena, Args&&... args) {
+		return arena.make<X>(std::forward<Args>(args)...);
+	}
+
+
+	/* CAtomicRefCounter is the (thread safe) control block for TAtomicRefCountingPointers. Like CRefCounter, it's just the
+	counter (plus, for targets of class type, the deleter index), allocated together with the target object. */
+	class CAtomicRefCounter {
+	public:
+		typedef MSE_REFCOUNTINGPOINTER_COUNTER_TYPE counter_type;
+
+		CAtomicRefCounter() : m_counter(1) {}
+		/* A new reference can only be made from an existing one, so no ordering is required here. */
+		void increment() { m_counter.fetch_add(1, std::memory_order_relaxed); }
+		/* Returns true if the last reference was just released. The release/acquire ordering ensures that all accesses to
+		the target object (through other references) "happen before" its destruction. */
+		bool decrement() {
+			if (1 == m_counter.fetch_sub(1, std::memory_order_release)) {
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return true;
+			}
+			return false;
+		}
+		counter_type use_count() const { return m_counter.load(std::memory_order_relaxed); }
+
+		template<class X>
+		static void destroy(CAtomicRefCounter* ref_ptr, X* /*obj_ptr*/) {
+			us::impl::destroy_refcounted_obj<X>(ref_ptr);
+		}
+		template<class X, class Y>
+		static void note_conversion(CAtomicRefCounter* ref_ptr, Y* obj_ptr) {
+			us::impl::note_refcounting_conversion<X>(ref_ptr, obj_ptr);
+		}
+
+	private:
+		std::atomic<counter_type> m_counter;
+	};
+
+	template<class Y>
+	using TAtomicRefWithTargetObj = us::impl::TRefCounterWithTargetObj<CAtomicRefCounter, Y>;
+
+	template<typename _Ty> class TAtomicRefCountingNotNullPointer;
+	template<typename _Ty> class TAtomicRefCountingFixedPointer;
+	template<typename _Ty> class TAtomicRefCountingConstPointer;
+	template<typename _Ty> class TAtomicRefCountingNotNullConstPointer;
+	template<typename _Ty> class TAtomicRefCountingFixedConstPointer;
+
+	namespace us {
+		namespace impl {
+			/* The implementation shared by the thread safe refcounting pointers (both non-const and const). _TPointee may be
+			const qualified. _TRefCounter::decrement() returns true if the caller is responsible for destroying the target
+			(using _TRefCounter::destroy()). */
+			template<typename _TPointee, class _TRefCounter>
+			class TThreadSafeRefCountingPointerBase {
+			public:
+				TThreadSafeRefCountingPointerBase() {}
+				TThreadSafeRefCountingPointerBase(const TThreadSafeRefCountingPointerBase& src) : m_ref_with_target_obj_ptr(src.m_ref_with_target_obj_ptr)
+					, m_target_obj_ptr(src.m_target_obj_ptr) {
+					if (m_ref_with_target_obj_ptr) { m_ref_with_target_obj_ptr->increment(); }
+				}
+				template<typename _TPointee2>
+				TThreadSafeRefCountingPointerBase(const TThreadSafeRefCountingPointerBase<_TPointee2, _TRefCounter>& src) : m_ref_with_target_obj_ptr(src.m_ref_with_target_obj_ptr)
+					, m_target_obj_ptr(src.m_target_obj_ptr) {
+					_TRefCounter::template note_conversion<_TPointee>(src.m_ref_with_target_obj_ptr, src.m_target_obj_ptr);
+					if (m_ref_with_target_obj_ptr) { m_ref_with_target_obj_ptr->increment(); }
+				}
+				TThreadSafeRefCountingPointerBase(TThreadSafeRefCountingPointerBase&& src) : m_ref_with_target_obj_ptr(src.m_ref_with_target_obj_ptr)
+					, m_target_obj_ptr(src.m_target_obj_ptr) {
+					src.m_ref_with_target_obj_ptr = nullptr;
+					src.m_target_obj_ptr = nullptr;
+				}
+				~TThreadSafeRefCountingPointerBase() {
+					release();
+				}
+				TThreadSafeRefCountingPointerBase& operator=(const TThreadSafeRefCountingPointerBase& src) {
+					if (this != &src) {
+						/* The source's target is acquired before our current target is released, in case the source is
+						(indirectly) owned by our current target. */
+						TThreadSafeRefCountingPointerBase keep(src);
+						swap(keep);
+					}
+					return (*this);
+				}
+				void swap(TThreadSafeRefCountingPointerBase& other) {
+					std::swap(m_ref_with_target_obj_ptr, other.m_ref_with_target_obj_ptr);
+					std::swap(m_target_obj_ptr, other.m_target_obj_ptr);
+				}
+
+				operator bool() const { return nullptr != m_target_obj_ptr; }
+				bool unique() const {
+					return (m_ref_with_target_obj_ptr ? (m_ref_with_target_obj_ptr->use_count() == 1) : true);
+				}
+				_TPointee* get() const { return m_target_obj_ptr; }
+
+			protected:
+				template<class _TRefWithTargetObj>
+				explicit TThreadSafeRefCountingPointerBase(_TRefWithTargetObj* p) : m_ref_with_target_obj_ptr(p), m_target_obj_ptr(_TRefWithTargetObj::object_ptr(p)) {}
+
+			private:
+				void release() {
+					if (m_ref_with_target_obj_ptr) {
+						if (m_ref_with_target_obj_ptr->decrement()) {
+							_TRefCounter::destroy(m_ref_with_target_obj_ptr, m_target_obj_ptr);
+						}
+						m_ref_with_target_obj_ptr = nullptr;
+						m_target_obj_ptr = nullptr;
+					}
+				}
+
+				_TRefCounter* m_ref_with_target_obj_ptr = nullptr;
+				_TPointee* m_target_obj_ptr = nullptr;
+
+				template<typename _TPointee2, class _TRefCounter2> friend class TThreadSafeRefCountingPointerBase;
+			};
+		}
+	}
+
+	/* TAtomicRefCountingPointer is a thread safe version of TRefCountingPointer. That is, like std::shared_ptr, different
+	pointers to the same target can be copied and destroyed from different threads simultaneously. (Access to the target
+	object itself is not synchronized, so generally the target should be immutable or otherwise thread safe.) Unlike
+	std::shared_ptr, the counter is allocated together with the target object and there is no separate weak count. */
+	template <class X>
+	class TAtomicRefCountingPointer : public us::impl::TThreadSafeRefCountingPointerBase<X, CAtomicRefCounter> {
+	public:
+		typedef us::impl::TThreadSafeRefCountingPointerBase<X, CAtomicRefCounter> base_class;
+		TAtomicRefCountingPointer() {}
+		TAtomicRefCountingPointer(std::nullptr_t) {}
+		TAtomicRefCountingPointer(const TAtomicRefCountingPointer& r) : base_class(r) {}
+		TAtomicRefCountingPointer(TAtomicRefCountingPointer&& r) : base_class(std::move(r)) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, X*>::value, void>::type>
+		TAtomicRefCountingPointer(const TAtomicRefCountingPointer<Y>& r) : base_class(r) {}
+		TAtomicRefCountingPointer& operator=(const TAtomicRefCountingPointer& r) {
+			base_class::operator=(r);
+			return (*this);
+		}
+		void clear() { (*this) = TAtomicRefCountingPointer<X>(nullptr); }
+
+		X& operator*() const { return (*checked_get()); }
+		X* operator->() const { return checked_get(); }
+
+		template <class Y> bool operator<(const TAtomicRefCountingPointer<Y>& r) const { return base_class::get() < r.get(); }
+		template <class Y> bool operator==(const TAtomicRefCountingPointer<Y>& r) const { return base_class::get() == r.get(); }
+		template <class Y> bool operator!=(const TAtomicRefCountingPointer<Y>& r) const { return base_class::get() != r.get(); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+
+	private:
+		template<class Y>
+		explicit TAtomicRefCountingPointer(TAtomicRefWithTargetObj<Y>* p) : base_class(p) {}
+		X* checked_get() const {
+			if (!(*this)) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingPointer")); }
+			return base_class::get();
+		}
+
+		friend class TAtomicRefCountingNotNullPointer<X>;
+	};
+
+	template<typename _Ty>
+	class TAtomicRefCountingNotNullPointer : public TAtomicRefCountingPointer<_Ty> {
+	public:
+		TAtomicRefCountingNotNullPointer(const TAtomicRefCountingNotNullPointer& src_cref) : TAtomicRefCountingPointer<_Ty>(src_cref) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, _Ty*>::value, void>::type>
+		TAtomicRefCountingNotNullPointer(const TAtomicRefCountingNotNullPointer<Y>& src_cref) : TAtomicRefCountingPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingNotNullPointer() {}
+		TAtomicRefCountingNotNullPointer<_Ty>& operator=(const TAtomicRefCountingNotNullPointer<_Ty>& _Right_cref) {
+			TAtomicRefCountingPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+	private:
+		explicit TAtomicRefCountingNotNullPointer(TAtomicRefWithTargetObj<_Ty>* p) : TAtomicRefCountingPointer<_Ty>(p) {}
+
+		friend class TAtomicRefCountingFixedPointer<_Ty>;
+	};
+
+	/* TAtomicRefCountingFixedPointer cannot be retargeted or constructed without a target. */
+	template<typename _Ty>
+	class TAtomicRefCountingFixedPointer : public TAtomicRefCountingNotNullPointer<_Ty> {
+	public:
+		TAtomicRefCountingFixedPointer(const TAtomicRefCountingFixedPointer& src_cref) : TAtomicRefCountingNotNullPointer<_Ty>(src_cref) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, _Ty*>::value, void>::type>
+		TAtomicRefCountingFixedPointer(const TAtomicRefCountingFixedPointer<Y>& src_cref) : TAtomicRefCountingNotNullPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingFixedPointer() {}
+
+		template <class... Args>
+		static TAtomicRefCountingFixedPointer make(Args&&... args) {
+			return TAtomicRefCountingFixedPointer(TAtomicRefWithTargetObj<_Ty>::make(std::forward<Args>(args)...));
+		}
+
+	private:
+		explicit TAtomicRefCountingFixedPointer(TAtomicRefWithTargetObj<_Ty>* p) : TAtomicRefCountingNotNullPointer<_Ty>(p) {}
+		TAtomicRefCountingFixedPointer<_Ty>& operator=(const TAtomicRefCountingFixedPointer<_Ty>& _Right_cref) = delete;
+	};
+
+	template <class X, class... Args>
+	TAtomicRefCountingFixedPointer<X> make_atomic_refcounting(Args&&... args) {
+		return TAtomicRefCountingFixedPointer<X>::make(std::forward<Args>(args)...);
+	}
+
+	template <class X>
+	class TAtomicRefCountingConstPointer : public us::impl::TThreadSafeRefCountingPointerBase<const X, CAtomicRefCounter> {
+	public:
+		typedef us::impl::TThreadSafeRefCountingPointerBase<const X, CAtomicRefCounter> base_class;
+		TAtomicRefCountingConstPointer() {}
+		TAtomicRefCountingConstPointer(std::nullptr_t) {}
+		TAtomicRefCountingConstPointer(const TAtomicRefCountingConstPointer& r) : base_class(r) {}
+		TAtomicRefCountingConstPointer(TAtomicRefCountingConstPointer&& r) : base_class(std::move(r)) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<const Y*, const X*>::value, void>::type>
+		TAtomicRefCountingConstPointer(const TAtomicRefCountingConstPointer<Y>& r) : base_class(r) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, const X*>::value, void>::type>
+		TAtomicRefCountingConstPointer(const TAtomicRefCountingPointer<Y>& r) : base_class(r) {}
+		TAtomicRefCountingConstPointer& operator=(const TAtomicRefCountingConstPointer& r) {
+			base_class::operator=(r);
+			return (*this);
+		}
+		void clear() { (*this) = TAtomicRefCountingConstPointer<X>(nullptr); }
+
+		const X& operator*() const { return (*checked_get()); }
+		const X* operator->() const { return checked_get(); }
+
+		template <class Y> bool operator<(const TAtomicRefCountingConstPointer<Y>& r) const { return base_class::get() < r.get(); }
+		template <class Y> bool operator==(const TAtomicRefCountingConstPointer<Y>& r) const { return base_class::get() == r.get(); }
+		template <class Y> bool operator!=(const TAtomicRefCountingConstPointer<Y>& r) const { return base_class::get() != r.get(); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+
+	private:
+		const X* checked_get() const {
+			if (!(*this)) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingConstPointer")); }
+			return base_class::get();
+		}
+	};
+
+	template<typename _Ty>
+	class TAtomicRefCountingNotNullConstPointer : public TAtomicRefCountingConstPointer<_Ty> {
+	public:
+		TAtomicRefCountingNotNullConstPointer(const TAtomicRefCountingNotNullConstPointer& src_cref) : TAtomicRefCountingConstPointer<_Ty>(src_cref) {}
+		TAtomicRefCountingNotNullConstPointer(const TAtomicRefCountingNotNullPointer<_Ty>& src_cref) : TAtomicRefCountingConstPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingNotNullConstPointer() {}
+		TAtomicRefCountingNotNullConstPointer<_Ty>& operator=(const TAtomicRefCountingNotNullConstPointer<_Ty>& _Right_cref) {
+			TAtomicRefCountingConstPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+		friend class TAtomicRefCountingFixedConstPointer<_Ty>;
+	};
+
+	/* TAtomicRefCountingFixedConstPointer cannot be retargeted or constructed without a target. */
+	template<typename _Ty>
+	class TAtomicRefCountingFixedConstPointer : public TAtomicRefCountingNotNullConstPointer<_Ty> {
+	public:
+		TAtomicRefCountingFixedConstPointer(const TAtomicRefCountingFixedConstPointer& src_cref) : TAtomicRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		TAtomicRefCountingFixedConstPointer(const TAtomicRefCountingFixedPointer<_Ty>& src_cref) : TAtomicRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingFixedConstPointer() {}
+
+	private:
+		TAtomicRefCountingFixedConstPointer<_Ty>& operator=(const TAtomicRefCountingFixedConstPointer<_Ty>& _Right_cref) = delete;
+	};
+
+
+	class CBiasedRefCounter;
+
+	namespace us {
+		namespace impl {
+			/* Each thread that creates objects targeted by biased refcounting pointers has one of these. It holds the queue of
+			the thread's objects whose counters need to be merged. */
+			class CBiasedRefCountingOwnerState {
+			public:
+				static CBiasedRefCountingOwnerState*& this_threads_state_ptr_ref() {
+					static thread_local CBiasedRefCountingOwnerState* tl_state_ptr = nullptr;
+					return tl_state_ptr;
+				}
+				static CBiasedRefCountingOwnerState* this_threads_state() {
+					auto state_ptr = this_threads_state_ptr_ref();
+					if (nullptr == state_ptr) {
+						static thread_local CThreadStateHolder tl_state_holder;
+						state_ptr = tl_state_holder.m_state_ptr;
+					}
+					return state_ptr;
+				}
+
+				void add_ref() { m_num_refs.fetch_add(1, std::memory_order_relaxed); }
+				void release_ref() {
+					if (1 == m_num_refs.fetch_sub(1, std::memory_order_acq_rel)) {
+						delete this;
+					}
+				}
+				/* Called by a (non-owner) thread whose release took the object's shared count negative. */
+				inline void enqueue(CBiasedRefCounter* ref_counter_ptr);
+				/* Merges the counters of the queued objects (destroying those no longer referenced). Only called by the owner
+				thread. */
+				inline void process_queue();
+
+			private:
+				class CThreadStateHolder {
+				public:
+					CThreadStateHolder() : m_state_ptr(new CBiasedRefCountingOwnerState()) {
+						this_threads_state_ptr_ref() = m_state_ptr;
+					}
+					~CThreadStateHolder() {
+						m_state_ptr->process_queue();
+						{
+							/* From here on, the threads that enqueue objects will merge them themselves. */
+							std::lock_guard<std::mutex> lock(m_state_ptr->m_mutex);
+							m_state_ptr->m_orphaned = true;
+						}
+						m_state_ptr->process_queue();
+						this_threads_state_ptr_ref() = nullptr;
+						m_state_ptr->release_ref();
+					}
+					CBiasedRefCountingOwnerState* m_state_ptr;
+				};
+
+				std::mutex m_mutex;
+				std::vector<CBiasedRefCounter*> m_queue;
+				std::atomic<bool> m_queue_is_nonempty{ false };
+				bool m_orphaned = false;
+				/* One for the thread (holder) plus one for each object. */
+				std::atomic<size_t> m_num_refs{ 1 };
+			};
+		}
+	}
+
+	/* CBiasedRefCounter is the control block for TBiasedRefCountingPointers. The thread that creates an object "owns" its
+	counter and updates its (plain) local count without atomic operations, while other threads update a separate atomic
+	shared count. The shared count can go negative (when another thread releases a reference that was counted by the owner),
+	in which case the object is queued for the owner thread to merge the counts. The owner also merges the counts when its
+	local count drops to zero, after which all threads use the shared count. The object is destroyed when, once merged, the
+	shared count reaches zero. (This is known as "biased reference counting".) */
+	class CBiasedRefCounter {
+	public:
+		typedef MSE_REFCOUNTINGPOINTER_COUNTER_TYPE counter_type;
+
+		CBiasedRefCounter(void(*destroy_fn)(CBiasedRefCounter*)) : m_destroy_fn(destroy_fn)
+			, m_owner_state_ptr(us::impl::CBiasedRefCountingOwnerState::this_threads_state()) {
+			m_owner_state_ptr->add_ref();
+			m_owner_state_ptr->process_queue();
+		}
+		~CBiasedRefCounter() {
+			m_owner_state_ptr->release_ref();
+		}
+
+		void increment() {
+			if (is_owner() && (!m_merged)) {
+				m_local_counter += 1;
+			}
+			else {
+				m_shared_word.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		/* Returns true if the last reference was just released. */
+		bool decrement() {
+			if (is_owner()) {
+				/* This object may itself be in the queue. Processing the queue while our reference is still counted ensures
+				that this object won't be destroyed in the process. (This is just a load unless the queue is non-empty.) */
+				m_owner_state_ptr->process_queue();
+				if (!m_merged) {
+					assert(1 <= m_local_counter);
+					m_local_counter -= 1;
+					if (0 != m_local_counter) {
+						return false;
+					}
+					if (sc_count_bias == m_shared_word.load(std::memory_order_acquire)) {
+						/* No other thread holds any references, so there's nothing to merge. */
+						return true;
+					}
+					return merge(false/*clear_queued_flag*/);
+				}
+				/* Otherwise the counts have been merged, so we'll decrement the shared count. */
+			}
+			auto old_word = m_shared_word.load(std::memory_order_relaxed);
+			while (true) {
+				auto new_word = old_word - 1;
+				bool enqueue = false;
+				if ((!(old_word & sc_merged_flag)) && (!(old_word & sc_queued_flag)) && (shared_count(new_word) < 0)) {
+					new_word |= sc_queued_flag;
+					enqueue = true;
+				}
+				if (m_shared_word.compare_exchange_weak(old_word, new_word, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					if (enqueue) {
+						/* The object can't be destroyed while it's in the queue. */
+						m_owner_state_ptr->enqueue(this);
+						return false;
+					}
+					return is_unreferenced(new_word);
+				}
+			}
+		}
+		/* Not exact if other threads are concurrently modifying the counts. */
+		std::int64_t use_count() const {
+			auto shared = shared_count(m_shared_word.load(std::memory_order_relaxed));
+			return (is_owner() && (!m_merged)) ? (m_local_counter + shared) : shared;
+		}
+
+		template<class X>
+		static void destroy(CBiasedRefCounter* ref_ptr, X* /*obj_ptr*/) {
+			ref_ptr->m_destroy_fn(ref_ptr);
+		}
+		/* The destroy function is that of the type the object was created as, so conversions need no bookkeeping. */
+		template<class X, class Y>
+		static void note_conversion(CBiasedRefCounter*, Y*) {}
+
+	private:
+		/* The shared word holds the (biased, possibly negative) shared count in its lower bits, plus two flags. */
+		static const std::uint64_t sc_count_bias = std::uint64_t(1) << 46;
+		static const std::uint64_t sc_count_mask = (std::uint64_t(1) << 48) - 1;
+		static const std::uint64_t sc_queued_flag = std::uint64_t(1) << 61;
+		static const std::uint64_t sc_merged_flag = std::uint64_t(1) << 62;
+
+		static std::int64_t shared_count(std::uint64_t word) { return std::int64_t(word & sc_count_mask) - std::int64_t(sc_count_bias); }
+		static bool is_unreferenced(std::uint64_t word) {
+			return ((word & sc_merged_flag) && (!(word & sc_queued_flag)) && (0 == shared_count(word)));
+		}
+		bool is_owner() const {
+			return (us::impl::CBiasedRefCountingOwnerState::this_threads_state_ptr_ref() == m_owner_state_ptr);
+		}
+
+		/* Adds the local count to the shared count. Called by the owner thread, or by another thread after the owner thread
+		has exited. Returns true if the object is no longer referenced. */
+		bool merge(bool clear_queued_flag) {
+			const auto local_count = m_local_counter;
+			auto old_word = m_shared_word.load(std::memory_order_relaxed);
+			while (true) {
+				auto new_word = old_word;
+				if (!(old_word & sc_merged_flag)) {
+					new_word = (new_word + local_count) | sc_merged_flag;
+				}
+				if (clear_queued_flag) {
+					new_word &= ~sc_queued_flag;
+				}
+				if (m_shared_word.compare_exchange_weak(old_word, new_word, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					m_merged = true;
+					return is_unreferenced(new_word);
+				}
+			}
+		}
+		void merge_queued() {
+			if (merge(true/*clear_queued_flag*/)) {
+				m_destroy_fn(this);
+			}
+		}
+
+		void(*m_destroy_fn)(CBiasedRefCounter*);
+		us::impl::CBiasedRefCountingOwnerState* m_owner_state_ptr;
+		/* Only accessed by the owner thread (or after it has exited). */
+		counter_type m_local_counter = 1;
+		bool m_merged = false;
+		std::atomic<std::uint64_t> m_shared_word{ sc_count_bias };
+
+		friend class us::impl::CBiasedRefCountingOwnerState;
+	};
+
+	namespace us {
+		namespace impl {
+			void CBiasedRefCountingOwnerState::enqueue(CBiasedRefCounter* ref_counter_ptr) {
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (!m_orphaned) {
+						m_queue.push_back(ref_counter_ptr);
+						m_queue_is_nonempty.store(true, std::memory_order_release);
+						return;
+					}
+				}
+				/* The owner thread has exited, so its local count won't change anymore. */
+				ref_counter_ptr->merge_queued();
+			}
+			void CBiasedRefCountingOwnerState::process_queue() {
+				if (!m_queue_is_nonempty.load(std::memory_order_acquire)) {
+					return;
+				}
+				std::vector<CBiasedRefCounter*> queue;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					std::swap(queue, m_queue);
+					m_queue_is_nonempty.store(false, std::memory_order_relaxed);
+				}
+				for (auto ref_counter_ptr : queue) {
+					ref_counter_ptr->merge_queued();
+				}
+			}
+		}
+	}
+
+	template<class Y>
+	class TBiasedRefWithTargetObj : public CBiasedRefCounter {
+	public:
+		Y m_object;
+
+		template<class ... Args>
+		TBiasedRefWithTargetObj(Args && ...args) : CBiasedRefCounter(&s_destroy), m_object(std::forward<Args>(args)...) {}
+
+		static Y* object_ptr(TBiasedRefWithTargetObj* p) { return std::addressof(p->m_object); }
+
+	private:
+		static void s_destroy(CBiasedRefCounter* ref_ptr) {
+			delete static_cast<TBiasedRefWithTargetObj*>(ref_ptr);
+		}
+	};
+
+	template<typename _Ty> class TBiasedRefCountingNotNullPointer;
+	template<typename _Ty> class TBiasedRefCountingFixedPointer;
+	template<typename _Ty> class TBiasedRefCountingNotNullConstPointer;
+	template<typename _Ty> class TBiasedRefCountingFixedConstPointer;
+
+	/* TBiasedRefCountingPointer is a thread safe refcounting pointer optimized for targets that are mostly (but not
+	exclusively) referenced from the thread that created them. Copying and releasing pointers in that thread doesn't
+	involve any atomic operations. Pointers can be passed to, copied and released in other threads, as with
+	TAtomicRefCountingPointer. (Access to the target object itself is not synchronized.) An object whose last reference is
+	released in another thread may not be destroyed until the owner thread next creates or releases a (biased refcounting)
+	reference, or exits. */
+	template <class X>
+	class TBiasedRefCountingPointer : public us::impl::TThreadSafeRefCountingPointerBase<X, CBiasedRefCounter> {
+	public:
+		typedef us::impl::TThreadSafeRefCountingPointerBase<X, CBiasedRefCounter> base_class;
+		TBiasedRefCountingPointer() {}
+		TBiasedRefCountingPointer(std::nullptr_t) {}
+		TBiasedRefCountingPointer(const TBiasedRefCountingPointer& r) : base_class(r) {}
+		TBiasedRefCountingPointer(TBiasedRefCountingPointer&& r) : base_class(std::move(r)) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, X*>::value, void>::type>
+		TBiasedRefCountingPointer(const TBiasedRefCountingPointer<Y>& r) : base_class(r) {}
+		TBiasedRefCountingPointer& operator=(const TBiasedRefCountingPointer& r) {
+			base_class::operator=(r);
+			return (*this);
+		}
+		void clear() { (*this) = TBiasedRefCountingPointer<X>(nullptr); }
+
+		X& operator*() const { return (*checked_get()); }
+		X* operator->() const { return checked_get(); }
+
+		template <class Y> bool operator<(const TBiasedRefCountingPointer<Y>& r) const { return base_class::get() < r.get(); }
+		template <class Y> bool operator==(const TBiasedRefCountingPointer<Y>& r) const { return base_class::get() == r.get(); }
+		template <class Y> bool operator!=(const TBiasedRefCountingPointer<Y>& r) const { return base_class::get() != r.get(); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+
+	private:
+		template<class Y>
+		explicit TBiasedRefCountingPointer(TBiasedRefWithTargetObj<Y>* p) : base_class(p) {}
+		X* checked_get() const {
+			if (!(*this)) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TBiasedRefCountingPointer")); }
+			return base_class::get();
+		}
+
+		friend class TBiasedRefCountingNotNullPointer<X>;
+	};
+
+	template<typename _Ty>
+	class TBiasedRefCountingNotNullPointer : public TBiasedRefCountingPointer<_Ty> {
+	public:
+		TBiasedRefCountingNotNullPointer(const TBiasedRefCountingNotNullPointer& src_cref) : TBiasedRefCountingPointer<_Ty>(src_cref) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, _Ty*>::value, void>::type>
+		TBiasedRefCountingNotNullPointer(const TBiasedRefCountingNotNullPointer<Y>& src_cref) : TBiasedRefCountingPointer<_Ty>(src_cref) {}
+		virtual ~TBiasedRefCountingNotNullPointer() {}
+		TBiasedRefCountingNotNullPointer<_Ty>& operator=(const TBiasedRefCountingNotNullPointer<_Ty>& _Right_cref) {
+			TBiasedRefCountingPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+	private:
+		explicit TBiasedRefCountingNotNullPointer(TBiasedRefWithTargetObj<_Ty>* p) : TBiasedRefCountingPointer<_Ty>(p) {}
+
+		friend class TBiasedRefCountingFixedPointer<_Ty>;
+	};
+
+	/* TBiasedRefCountingFixedPointer cannot be retargeted or constructed without a target. */
+	template<typename _Ty>
+	class TBiasedRefCountingFixedPointer : public TBiasedRefCountingNotNullPointer<_Ty> {
+	public:
+		TBiasedRefCountingFixedPointer(const TBiasedRefCountingFixedPointer& src_cref) : TBiasedRefCountingNotNullPointer<_Ty>(src_cref) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, _Ty*>::value, void>::type>
+		TBiasedRefCountingFixedPointer(const TBiasedRefCountingFixedPointer<Y>& src_cref) : TBiasedRefCountingNotNullPointer<_Ty>(src_cref) {}
+		virtual ~TBiasedRefCountingFixedPointer() {}
+
+		template <class... Args>
+		static TBiasedRefCountingFixedPointer make(Args&&... args) {
+			return TBiasedRefCountingFixedPointer(new TBiasedRefWithTargetObj<_Ty>(std::forward<Args>(args)...));
+		}
+
+	private:
+		explicit TBiasedRefCountingFixedPointer(TBiasedRefWithTargetObj<_Ty>* p) : TBiasedRefCountingNotNullPointer<_Ty>(p) {}
+		TBiasedRefCountingFixedPointer<_Ty>& operator=(const TBiasedRefCountingFixedPointer<_Ty>& _Right_cref) = delete;
+	};
+
+	template <class X, class... Args>
+	TBiasedRefCountingFixedPointer<X> make_biased_refcounting(Args&&... args) {
+		return TBiasedRefCountingFixedPointer<X>::make(std::forward<Args>(args)...);
+	}
+
+	template <class X>
+	class TBiasedRefCountingConstPointer : public us::impl::TThreadSafeRefCountingPointerBase<const X, CBiasedRefCounter> {
+	public:
+		typedef us::impl::TThreadSafeRefCountingPointerBase<const X, CBiasedRefCounter> base_class;
+		TBiasedRefCountingConstPointer() {}
+		TBiasedRefCountingConstPointer(std::nullptr_t) {}
+		TBiasedRefCountingConstPointer(const TBiasedRefCountingConstPointer& r) : base_class(r) {}
+		TBiasedRefCountingConstPointer(TBiasedRefCountingConstPointer&& r) : base_class(std::move(r)) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<const Y*, const X*>::value, void>::type>
+		TBiasedRefCountingConstPointer(const TBiasedRefCountingConstPointer<Y>& r) : base_class(r) {}
+		template <class Y, class = typename std::enable_if<std::is_convertible<Y*, const X*>::value, void>::type>
+		TBiasedRefCountingConstPointer(const TBiasedRefCountingPointer<Y>& r) : base_class(r) {}
+		TBiasedRefCountingConstPointer& operator=(const TBiasedRefCountingConstPointer& r) {
+			base_class::operator=(r);
+			return (*this);
+		}
+		void clear() { (*this) = TBiasedRefCountingConstPointer<X>(nullptr); }
+
+		const X& operator*() const { return (*checked_get()); }
+		const X* operator->() const { return checked_get(); }
+
+		template <class Y> bool operator<(const TBiasedRefCountingConstPointer<Y>& r) const { return base_class::get() < r.get(); }
+		template <class Y> bool operator==(const TBiasedRefCountingConstPointer<Y>& r) const { return base_class::get() == r.get(); }
+		template <class Y> bool operator!=(const TBiasedRefCountingConstPointer<Y>& r) const { return base_class::get() != r.get(); }
+		bool operator==(std::nullptr_t) const { return (!(*this)); }
+		bool operator!=(std::nullptr_t) const { return (!((*this) == nullptr)); }
+
+	private:
+		const X* checked_get() const {
+			if (!(*this)) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TBiasedRefCountingConstPointer")); }
+			return base_class::get();
+		}
+	};
+
+	template<typename _Ty>
+	class TBiasedRefCountingNotNullConstPointer : public TBiasedRefCountingConstPointer<_Ty> {
+	public:
+		TBiasedRefCountingNotNullConstPointer(const TBiasedRefCountingNotNullConstPointer& src_cref) : TBiasedRefCountingConstPointer<_Ty>(src_cref) {}
+		TBiasedRefCountingNotNullConstPointer(const TBiasedRefCountingNotNullPointer<_Ty>& src_cref) : TBiasedRefCountingConstPointer<_Ty>(src_cref) {}
+		virtual ~TBiasedRefCountingNotNullConstPointer() {}
+		TBiasedRefCountingNotNullConstPointer<_Ty>& operator=(const TBiasedRefCountingNotNullConstPointer<_Ty>& _Right_cref) {
+			TBiasedRefCountingConstPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+		friend class TBiasedRefCountingFixedConstPointer<_Ty>;
+	};
+
+	/* TBiasedRefCountingFixedConstPointer cannot be retargeted or constructed without a target. */
+	template<typename _Ty>
+	class TBiasedRefCountingFixedConstPointer : public TBiasedRefCountingNotNullConstPointer<_Ty> {
+	public:
+		TBiasedRefCountingFixedConstPointer(const TBiasedRefCountingFixedConstPointer& src_cref) : TBiasedRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		TBiasedRefCountingFixedConstPointer(const TBiasedRefCountingFixedPointer<_Ty>& src_cref) : TBiasedRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		virtual ~TBiasedRefCountingFixedConstPointer() {}
+
+	private:
+		TBiasedRefCountingFixedConstPointer<_Ty>& operator=(const TBiasedRefCountingFixedConstPointer<_Ty>& _Right_cref) = delete;
+	};
+
 #endif /*MSE_REFCOUNTINGPOINTER_DISABLED*/
 
 	template <class _TTargetType, class _TLeaseType> class TStrongFixedConstPointer;
@@ -626,6 +1841,18 @@ namespace mse {
 	template<typename _Ty> using refcnncp = TRefCountingNotNullConstPointer<_Ty>;
 	template<typename _Ty> using refcfp = TRefCountingFixedPointer<_Ty>;
 	template<typename _Ty> using refcfcp = TRefCountingFixedConstPointer<_Ty>;
+	template<typename _Ty> using arefcp = TAtomicRefCountingPointer<_Ty>;
+	template<typename _Ty> using arefccp = TAtomicRefCountingConstPointer<_Ty>;
+	template<typename _Ty> using arefcnnp = TAtomicRefCountingNotNullPointer<_Ty>;
+	template<typename _Ty> using arefcnncp = TAtomicRefCountingNotNullConstPointer<_Ty>;
+	template<typename _Ty> using arefcfp = TAtomicRefCountingFixedPointer<_Ty>;
+	template<typename _Ty> using arefcfcp = TAtomicRefCountingFixedConstPointer<_Ty>;
+	template<typename _Ty> using brefcp = TBiasedRefCountingPointer<_Ty>;
+	template<typename _Ty> using brefccp = TBiasedRefCountingConstPointer<_Ty>;
+	template<typename _Ty> using brefcnnp = TBiasedRefCountingNotNullPointer<_Ty>;
+	template<typename _Ty> using brefcnncp = TBiasedRefCountingNotNullConstPointer<_Ty>;
+	template<typename _Ty> using brefcfp = TBiasedRefCountingFixedPointer<_Ty>;
+	template<typename _Ty> using brefcfcp = TBiasedRefCountingFixedConstPointer<_Ty>;
 
 	/* deprecated aliases */
 	template<class _TTargetType, class _TLeaseType> using strfp = TStrongFixedPointer<_TTargetType, _TLeaseType>;
@@ -754,6 +1981,175 @@ namespace mse {
 			return ok;
 		}
 
+		struct ArenaLinked : Trackable
+		{
+			ArenaLinked(TRefCountingPointer_test* state_ptr, const std::string&t) :Trackable(state_ptr, t) {}
+			TArenaRefCountingPointer<ArenaLinked> next;
+		};
+
+		bool testArena()
+		{
+			bool ok = true;
+#if defined(MSE_SELF_TESTS) && !defined(MSE_REFCOUNTINGPOINTER_DISABLED)
+
+			constructions.clear();
+			destructions.clear();
+			{
+				CRefCountingArena arena;
+				TArenaRefCountingPointer<ArenaLinked> node = make_refcounting_in<ArenaLinked>(arena, this, "parent");
+				MTXASSERT(ok, (node != nullptr));
+				node->next = make_refcounting_in<ArenaLinked>(arena, this, "child");
+				TArenaRefCountingConstPointer<ArenaLinked> child_cptr = node->next;
+
+				MTXASSERT_EQ(ok, 2ul, constructions.size());
+				MTXASSERT_EQ(ok, 0ul, destructions.size());
+
+				/* Objects are still destroyed when their last reference goes away. */
+				node = node->next;
+				MTXASSERT_EQ(ok, 1ul, destructions.size());
+				MTXASSERT_EQ(ok, 1, destructions["parent"]);
+				MTXASSERT(ok, (child_cptr == node));
+
+				/* Create a bunch of (cyclic) nodes that won't be destroyed until the arena releases them. */
+				for (int i = 0; i < 1000; i += 1) {
+					auto node2 = make_refcounting_in<ArenaLinked>(arena, this, "bulk");
+					node2->next = make_refcounting_in<ArenaLinked>(arena, this, "bulk");
+					node2->next->next = node2;
+				}
+				MTXASSERT_EQ(ok, 2000, constructions["bulk"]);
+				MTXASSERT_EQ(ok, 0, destructions["bulk"]);
+				MTXASSERT_EQ(ok, 2002ul, arena.num_objects());
+
+				arena.release_all();
+				MTXASSERT_EQ(ok, 2000, destructions["bulk"]);
+				MTXASSERT_EQ(ok, 1, destructions["child"]);
+				MTXASSERT_EQ(ok, 0ul, arena.num_objects());
+
+				/* Remaining pointers to released objects are detected rather than left dangling. */
+				MTXASSERT(ok, node.is_dangling());
+				bool expected_exception = false;
+				try {
+					auto next = node->next;
+				}
+				catch (const refcounting_arena_dangling_error&) {
+					expected_exception = true;
+				}
+				MTXASSERT(ok, expected_exception);
+				/* Copying or discarding dangling pointers is fine. */
+				auto node_copy = node;
+				child_cptr = nullptr;
+
+				/* The arena's memory is reused after a release. */
+				node = make_refcounting_in<ArenaLinked>(arena, this, "reused");
+				MTXASSERT(ok, !node.is_dangling());
+				MTXASSERT_EQ(ok, 1ul, arena.num_objects());
+			}
+			MTXASSERT_EQ(ok, 1, destructions["reused"]);
+#endif // defined(MSE_SELF_TESTS) && !defined(MSE_REFCOUNTINGPOINTER_DISABLED)
+
+			return ok;
+		}
+
+		bool testAtomic()
+		{
+			bool ok = true;
+#ifdef MSE_SELF_TESTS
+
+			constructions.clear();
+			destructions.clear();
+			{
+				TAtomicRefCountingFixedPointer<Trackable> a = make_atomic_refcounting<Trackable>(this, "shared");
+				TAtomicRefCountingConstPointer<Trackable> ca = a;
+				TAtomicRefCountingPointer<Trackable> nil;
+#ifndef MSE_REFCOUNTINGPOINTER_DISABLED
+				bool expected_exception = false;
+				try {
+					auto id = nil->_id;
+				}
+				catch (const refcounting_null_dereference_error&) {
+					expected_exception = true;
+				}
+				MTXASSERT(ok, expected_exception);
+#endif // !MSE_REFCOUNTINGPOINTER_DISABLED
+
+				/* Copies of the pointer are made and dropped in several threads simultaneously. */
+				std::vector<std::thread> threads;
+				for (int i = 0; i < 4; i += 1) {
+					threads.emplace_back([ca]() {
+						for (int j = 0; j < 10000; j += 1) {
+							TAtomicRefCountingConstPointer<Trackable> ca2 = ca;
+							assert("shared" == ca2->_id);
+						}
+					});
+				}
+				for (auto& thread : threads) {
+					thread.join();
+				}
+				MTXASSERT_EQ(ok, 0, destructions["shared"]);
+				MTXASSERT(ok, !ca.unique());
+			}
+			MTXASSERT_EQ(ok, 1, destructions["shared"]);
+#endif // MSE_SELF_TESTS
+
+			return ok;
+		}
+
+		bool testBiased()
+		{
+			bool ok = true;
+#ifdef MSE_SELF_TESTS
+
+			constructions.clear();
+			destructions.clear();
+			{
+				TBiasedRefCountingFixedPointer<Trackable> a = make_biased_refcounting<Trackable>(this, "biased");
+				TBiasedRefCountingConstPointer<Trackable> ca = a;
+				TBiasedRefCountingPointer<Trackable> nil;
+#ifndef MSE_REFCOUNTINGPOINTER_DISABLED
+				bool expected_exception = false;
+				try {
+					auto id = nil->_id;
+				}
+				catch (const refcounting_null_dereference_error&) {
+					expected_exception = true;
+				}
+				MTXASSERT(ok, expected_exception);
+#endif // !MSE_REFCOUNTINGPOINTER_DISABLED
+
+				/* Copies of the pointer are made and dropped in several threads simultaneously. */
+				std::vector<std::thread> threads;
+				for (int i = 0; i < 4; i += 1) {
+					threads.emplace_back([ca]() {
+						for (int j = 0; j < 10000; j += 1) {
+							TBiasedRefCountingConstPointer<Trackable> ca2 = ca;
+							assert("biased" == ca2->_id);
+						}
+					});
+				}
+				for (auto& thread : threads) {
+					thread.join();
+				}
+				MTXASSERT_EQ(ok, 0, destructions["biased"]);
+			}
+			MTXASSERT_EQ(ok, 1, destructions["biased"]);
+
+			{
+				/* Here the last reference is released in a thread other than the owner thread, after the owner thread
+				has exited. */
+				TBiasedRefCountingPointer<Trackable> b;
+				std::thread owner_thread([this, &b]() {
+					b = make_biased_refcounting<Trackable>(this, "escaped");
+				});
+				owner_thread.join();
+				MTXASSERT_EQ(ok, 0, destructions["escaped"]);
+				b = nullptr;
+				MTXASSERT_EQ(ok, 1, destructions["escaped"]);
+			}
+#endif // MSE_SELF_TESTS
+
+			return ok;
+		}
+
 		void test1() {
 #ifdef MSE_SELF_TESTS
 			class A {
@@ -831,6 +2227,46 @@ namespace mse {
 				int k = D_refcountingfixed_ptr1->b;
 			}
 
+#ifndef MSE_REFCOUNTINGPOINTER_DISABLED
+			{
+				/* The control block is just the counter (plus, for targets of class type, the deleter index), and the pointer
+				is just the address of the control block. */
+				static_assert(sizeof(mse::CRefCounter) == sizeof(mse::CRefCounter::counter_type), "");
+				static_assert(sizeof(mse::TRefCountingPointer<int>) == sizeof(void*), "");
+				static_assert(sizeof(mse::TRefCountingConstPointer<A>) == sizeof(void*), "");
+
+				/* Conversion to a pointer to a base class that isn't at the same address as the object isn't supported. */
+				class E { public: virtual ~E() {} int e = 5; };
+				class F : public E, public A {};
+				bool conversion_error_thrown = false;
+				mse::TRefCountingPointer<F> F_refcounting_ptr1 = mse::make_refcounting<F>();
+				try {
+					mse::TRefCountingPointer<A> A_refcounting_ptr3 = F_refcounting_ptr1;
+				}
+				catch (const mse::refcounting_conversion_error&) {
+					conversion_error_thrown = true;
+				}
+				assert(conversion_error_thrown);
+				assert(F_refcounting_ptr1.unique());
+			}
+			{
+				/* Conversion to a pointer to a base class without a virtual destructor. The object is still destroyed as the
+				type it was created as. */
+				static int s_num_H_destructions = 0;
+				class G { public: std::string m_g = "some text long enough to be allocated"; };
+				class H : public G { public: ~H() { s_num_H_destructions += 1; } std::string m_h = m_g; };
+				mse::TRefCountingPointer<G> G_refcounting_ptr1 = mse::make_refcounting<H>();
+				mse::TRefCountingConstPointer<G> G_refcountingconst_ptr1 = G_refcounting_ptr1;
+				G_refcounting_ptr1 = nullptr;
+				G_refcountingconst_ptr1.clear();
+				assert(1 == s_num_H_destructions);
+
+				mse::TAtomicRefCountingPointer<G> G_atomicrefcounting_ptr1 = mse::make_atomic_refcounting<H>();
+				G_atomicrefcounting_ptr1 = nullptr;
+				assert(2 == s_num_H_destructions);
+			}
+#endif // !MSE_REFCOUNTINGPOINTER_DISABLED
+
 			{
 				/* You can use the "mse::make_pointer_to_member()" function to obtain a safe pointer to a member of
 				an object owned by a refcounting pointer. */
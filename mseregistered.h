@@ -15,6 +15,12 @@
 #include <functional>
 #include <cassert>
 #include <string>
+#include <cstdint>
+#include <new>
+#include <cstddef>
+#include <limits>
+#include <atomic>
+#include <thread>
 
 
 #if defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)
@@ -29,6 +35,12 @@ namespace mse {
 
 	MSE_CONSTEXPR static const int sc_default_cache_size = MSE_REGISTERED_DEFAULT_CACHE_SIZE;
 
+	/* Passing sc_intrusive_list_tracking as the _Tn template parameter (instead of a cache size) selects an alternative
+	tracking mechanism in which each registered pointer carries the links of a doubly-linked list of all the pointers targeting
+	the object. Registering and unregistering pointers are then O(1) and never allocate, regardless of how many pointers
+	target the object, at the cost of three extra (native) pointers per registered pointer. */
+	MSE_CONSTEXPR static const int sc_intrusive_list_tracking = -1;
+
 #ifdef MSE_REGISTEREDPOINTER_DISABLED
 	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredPointer = _Ty*;
 	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredConstPointer = const _Ty*;
@@ -41,6 +53,146 @@ namespace mse {
 
 #else /*MSE_REGISTEREDPOINTER_DISABLED*/
 
+	/* CRPTrackerOverflowPtrSet is the storage TRPTracker switches to when the number of pointers targeting an object exceeds its
+	fast storage capacity. It's an open-addressed (linear probing) hash set of pointers stored in a single, cache-line aligned,
+	flat array. Removal uses "backward shift" deletion, so no tombstones accumulate as pointers are repeatedly registered and
+	unregistered. Unlike std::unordered_set, inserting and erasing elements never allocates or frees memory (unless the set
+	needs to grow). */
+	class CRPTrackerOverflowPtrSet {
+	public:
+		CRPTrackerOverflowPtrSet() {}
+		CRPTrackerOverflowPtrSet(const CRPTrackerOverflowPtrSet&) = delete;
+		CRPTrackerOverflowPtrSet& operator=(const CRPTrackerOverflowPtrSet&) = delete;
+		~CRPTrackerOverflowPtrSet() {
+			::operator delete(m_allocation);
+		}
+
+		size_t size() const { return m_size; }
+		size_t capacity() const { return m_capacity; }
+
+		void insert(const CSaferPtrBase* ptr) {
+			assert(nullptr != ptr);
+			reserve(m_size + 1);
+			size_t index = home_index(ptr);
+			while (nullptr != m_slots[index]) {
+				if (ptr == m_slots[index]) {
+					return;
+				}
+				index = (index + 1) & (m_capacity - 1);
+			}
+			m_slots[index] = ptr;
+			m_size += 1;
+		}
+		size_t erase(const CSaferPtrBase* ptr) {
+			if (0 == m_size) {
+				return 0;
+			}
+			const size_t mask = m_capacity - 1;
+			size_t index = home_index(ptr);
+			while (ptr != m_slots[index]) {
+				if (nullptr == m_slots[index]) {
+					return 0;
+				}
+				index = (index + 1) & mask;
+			}
+			/* "Backward shift" deletion. We move subsequent elements in the probe sequence back into the vacated slot
+			(when doing so doesn't move them in front of their home slot) so that lookups never need tombstones. */
+			size_t hole = index;
+			size_t next = index;
+			while (true) {
+				next = (next + 1) & mask;
+				const auto next_ptr = m_slots[next];
+				if (nullptr == next_ptr) {
+					break;
+				}
+				const size_t next_home = home_index(next_ptr);
+				/* Distance (in the probe sequence) from the element's home slot to its current slot and to the hole. */
+				if (((next - next_home) & mask) >= ((next - hole) & mask)) {
+					m_slots[hole] = next_ptr;
+					hole = next;
+				}
+			}
+			m_slots[hole] = nullptr;
+			m_size -= 1;
+			return 1;
+		}
+		/* Ensures that the set can hold (at least) new_size elements without reallocation. */
+		void reserve(size_t new_size) {
+			if (new_size > max_size_for_capacity(m_capacity)) {
+				size_t new_capacity = (0 == m_capacity) ? sc_initial_capacity : m_capacity;
+				while (new_size > max_size_for_capacity(new_capacity)) {
+					new_capacity *= 2;
+				}
+				rehash(new_capacity);
+			}
+		}
+		/* Applies the given function to each element. This is just a linear scan of the contiguous slot array. */
+		template<typename _TFunction>
+		void for_each(const _TFunction& func) const {
+			for (size_t i = 0; i < m_capacity; i += 1) {
+				if (nullptr != m_slots[i]) {
+					func(m_slots[i]);
+				}
+			}
+		}
+
+	private:
+		MSE_CONSTEXPR static const size_t sc_cache_line_size = 64;
+		/* The initial capacity fills two cache lines (on 64-bit platforms). The capacity must always be a power of two. */
+		MSE_CONSTEXPR static const size_t sc_initial_capacity = 2 * sc_cache_line_size / sizeof(const CSaferPtrBase*);
+
+		/* We keep the load factor at or below 3/4. */
+		static size_t max_size_for_capacity(size_t capacity) { return (capacity / 4) * 3; }
+		size_t home_index(const CSaferPtrBase* ptr) const {
+			/* Fibonacci hashing. The low bits of the (aligned) pointer value are mostly zero so we drop them first. */
+			MSE_CONSTEXPR static const uintptr_t sc_multiplier = (8 <= sizeof(uintptr_t))
+				? uintptr_t(11400714819323198485ull) : uintptr_t(2654435769u);
+			const auto hash = (uintptr_t(ptr) >> 3) * sc_multiplier;
+			return size_t(hash >> (sizeof(uintptr_t) * CHAR_BIT - m_capacity_log2));
+		}
+		void rehash(size_t new_capacity) {
+			assert(new_capacity > m_capacity);
+			/* Allocate the slot array aligned to a cache line boundary. */
+			void* new_allocation = ::operator new(new_capacity * sizeof(const CSaferPtrBase*) + sc_cache_line_size);
+			auto new_slots = reinterpret_cast<const CSaferPtrBase**>(
+				(uintptr_t(new_allocation) + (sc_cache_line_size - 1)) & ~uintptr_t(sc_cache_line_size - 1));
+			for (size_t i = 0; i < new_capacity; i += 1) {
+				new_slots[i] = nullptr;
+			}
+
+			auto old_allocation = m_allocation;
+			auto old_slots = m_slots;
+			auto old_capacity = m_capacity;
+
+			m_allocation = new_allocation;
+			m_slots = new_slots;
+			m_capacity = new_capacity;
+			m_capacity_log2 = 0;
+			while ((size_t(1) << m_capacity_log2) < new_capacity) {
+				m_capacity_log2 += 1;
+			}
+			m_size = 0;
+
+			for (size_t i = 0; i < old_capacity; i += 1) {
+				if (nullptr != old_slots[i]) {
+					size_t index = home_index(old_slots[i]);
+					while (nullptr != m_slots[index]) {
+						index = (index + 1) & (m_capacity - 1);
+					}
+					m_slots[index] = old_slots[i];
+					m_size += 1;
+				}
+			}
+			::operator delete(old_allocation);
+		}
+
+		void* m_allocation = nullptr;
+		const CSaferPtrBase** m_slots = nullptr;
+		size_t m_capacity = 0;
+		size_t m_capacity_log2 = 0;
+		size_t m_size = 0;
+	};
+
 	/* TRPTracker is intended to keep track of all the pointers pointing to an object. TRPTracker objects are intended to be always
 	associated with (infact, a member of) the one object that is the target of the pointers it tracks. Though at the moment, it
 	doesn't need to actually know which object it is associated with. */
@@ -75,9 +227,9 @@ namespace mse {
 		bool operator!=(const TRPTracker& _Right_cref) const { /* see above */ return false; }
 
 		void registerPointer(const CSaferPtrBase& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", registration);
 			if (!fast_mode1()) {
-				std::unordered_set<const CSaferPtrBase*>::value_type item(&sp_ref);
-				(*m_ptr_to_regptr_set_ptr).insert(item);
+				(*m_ptr_to_regptr_set_ptr).insert(&sp_ref);
 #ifdef MSE_REGISTERED_INSTRUMENTATION1
 				if ((*m_ptr_to_regptr_set_ptr).size() > m_highest_ptr_to_regptr_set_size) {
 					m_highest_ptr_to_regptr_set_size = (*m_ptr_to_regptr_set_ptr).size();
@@ -87,16 +239,16 @@ namespace mse {
 			else {
 				if (sc_fm1_max_pointers == m_fm1_num_pointers) {
 					/* Too many pointers. Initiate and switch to slow mode. */
+					MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", fast_to_slow_mode_transition);
 					/* Initialize slow storage. */
-					m_ptr_to_regptr_set_ptr = new std::unordered_set<const CSaferPtrBase*>();
+					m_ptr_to_regptr_set_ptr = new CRPTrackerOverflowPtrSet();
+					(*m_ptr_to_regptr_set_ptr).reserve(sc_fm1_max_pointers + 1);
 					/* First copy the pointers from fast storage to slow storage. */
 					for (int i = 0; i < sc_fm1_max_pointers; i += 1) {
-						std::unordered_set<const CSaferPtrBase*>::value_type item(m_fm1_ptr_to_regptr_array[i]);
-						(*m_ptr_to_regptr_set_ptr).insert(item);
+						(*m_ptr_to_regptr_set_ptr).insert(m_fm1_ptr_to_regptr_array[i]);
 					}
 					/* Add the new pointer to slow storage. */
-					std::unordered_set<const CSaferPtrBase*>::value_type item(&sp_ref);
-					(*m_ptr_to_regptr_set_ptr).insert(item);
+					(*m_ptr_to_regptr_set_ptr).insert(&sp_ref);
 				}
 				else {
 #ifdef MSE_RP_SPECIAL_CASE_OPTIMIZATIONS
@@ -126,6 +278,7 @@ namespace mse {
 			}
 		}
 		void unregisterPointer(const CSaferPtrBase& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", unregistration);
 			if (!fast_mode1()) {
 				auto res = (*m_ptr_to_regptr_set_ptr).erase(&sp_ref);
 				assert(0 != res);
@@ -178,9 +331,7 @@ namespace mse {
 		}
 		void onObjectDestruction() {
 			if (!fast_mode1()) {
-				for (auto sp_ref_ptr : (*m_ptr_to_regptr_set_ptr)) {
-					(*sp_ref_ptr).setToNull();
-				}
+				(*m_ptr_to_regptr_set_ptr).for_each([](const CSaferPtrBase* sp_ref_ptr) { (*sp_ref_ptr).setToNull(); });
 			}
 			else {
 #ifdef MSE_RP_SPECIAL_CASE_OPTIMIZATIONS
@@ -227,7 +378,7 @@ namespace mse {
 			}
 			else if (sc_fm1_max_pointers == m_fm1_num_pointers) {
 				/* At this point, a call to registerPointer() would result in a switch out of fast mode
-				and the allocation of an std::unordered_set. We'll trigger that event now by adding and
+				and the allocation of slow storage. We'll trigger that event now by adding and
 				removing a placeholder pointer. */
 				class CPlaceHolderPtr : public CSaferPtrBase {
 				public:
@@ -247,13 +398,95 @@ namespace mse {
 		MSE_CONSTEXPR static const int sc_fm1_max_pointers = _Tn;
 		const CSaferPtrBase* m_fm1_ptr_to_regptr_array[sc_fm1_max_pointers];
 
-		std::unordered_set<const CSaferPtrBase*> *m_ptr_to_regptr_set_ptr = nullptr;
+		CRPTrackerOverflowPtrSet *m_ptr_to_regptr_set_ptr = nullptr;
 
 #ifdef MSE_REGISTERED_INSTRUMENTATION1
 		size_t m_highest_ptr_to_regptr_set_size = 0;
 #endif // MSE_REGISTERED_INSTRUMENTATION1
 	};
 
+	/* TRPTrackerNode is a base class of registered pointers. It's an empty class except when the "intrusive list" tracking
+	mechanism is selected (see sc_intrusive_list_tracking), in which case it holds the pointer's list links. */
+	template<int _Tn>
+	class TRPTrackerNode {};
+
+	template<>
+	class TRPTrackerNode<sc_intrusive_list_tracking> {
+	public:
+		TRPTrackerNode() {}
+		/* Like TRPTracker, the state of this class is specific to the particular instance, so it is not copied. */
+		TRPTrackerNode(const TRPTrackerNode&) {}
+		TRPTrackerNode& operator=(const TRPTrackerNode&) { return (*this); }
+
+		mutable const CSaferPtrBase* m_rpt_sp_ptr = nullptr;
+		mutable const TRPTrackerNode* m_rpt_prev_ptr = nullptr;
+		mutable const TRPTrackerNode* m_rpt_next_ptr = nullptr;
+	};
+
+	/* This specialization of TRPTracker is just the head of an (intrusive) doubly-linked list of the registered pointers
+	targeting the object. */
+	template<>
+	class TRPTracker<sc_intrusive_list_tracking> {
+	public:
+		typedef TRPTrackerNode<sc_intrusive_list_tracking> node_type;
+
+		TRPTracker() {}
+		TRPTracker(const TRPTracker&) { /* see the primary template */ }
+		TRPTracker(TRPTracker&&) { /* see the primary template */ }
+		~TRPTracker() {}
+		TRPTracker& operator=(const TRPTracker&) { /* see the primary template */ return (*this); }
+		TRPTracker& operator=(TRPTracker&&) { /* see the primary template */ return (*this); }
+		bool operator==(const TRPTracker&) const { return true; }
+		bool operator!=(const TRPTracker&) const { return false; }
+
+		template<typename _TRegisteredPointer>
+		void registerPointer(const _TRegisteredPointer& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", registration);
+			const node_type& node_cref = sp_ref;
+			const CSaferPtrBase& sp_base_cref = sp_ref;
+			node_cref.m_rpt_sp_ptr = &sp_base_cref;
+			node_cref.m_rpt_prev_ptr = nullptr;
+			node_cref.m_rpt_next_ptr = m_head_ptr;
+			if (nullptr != m_head_ptr) {
+				m_head_ptr->m_rpt_prev_ptr = &node_cref;
+			}
+			m_head_ptr = &node_cref;
+		}
+		template<typename _TRegisteredPointer>
+		void unregisterPointer(const _TRegisteredPointer& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", unregistration);
+			const node_type& node_cref = sp_ref;
+			if (nullptr != node_cref.m_rpt_prev_ptr) {
+				node_cref.m_rpt_prev_ptr->m_rpt_next_ptr = node_cref.m_rpt_next_ptr;
+			}
+			else {
+				assert(&node_cref == m_head_ptr);
+				m_head_ptr = node_cref.m_rpt_next_ptr;
+			}
+			if (nullptr != node_cref.m_rpt_next_ptr) {
+				node_cref.m_rpt_next_ptr->m_rpt_prev_ptr = node_cref.m_rpt_prev_ptr;
+			}
+			node_cref.m_rpt_prev_ptr = nullptr;
+			node_cref.m_rpt_next_ptr = nullptr;
+		}
+		void onObjectDestruction() {
+			auto node_ptr = m_head_ptr;
+			m_head_ptr = nullptr;
+			while (nullptr != node_ptr) {
+				auto next_node_ptr = node_ptr->m_rpt_next_ptr;
+				(*(node_ptr->m_rpt_sp_ptr)).setToNull();
+				node_ptr->m_rpt_prev_ptr = nullptr;
+				node_ptr->m_rpt_next_ptr = nullptr;
+				node_ptr = next_node_ptr;
+			}
+		}
+		void reserve_space_for_one_more() {
+			/* registerPointer() never allocates memory in this mode, so there's nothing to do here. */
+		}
+
+		const node_type* m_head_ptr = nullptr;
+	};
+
 	/* CSORPTracker is a "size optimized" (smaller and slower) version of CSPTracker. Currently not used. */
 	class CSORPTracker {
 	public:
@@ -283,6 +516,7 @@ namespace mse {
 		bool operator!=(const CSORPTracker& _Right_cref) const { /* see above */ return false; }
 
 		void registerPointer(const CSaferPtrBase& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", registration);
 			if (!m_ptr_to_regptr_set_ptr) {
 				m_ptr_to_regptr_set_ptr = new std::unordered_set<const CSaferPtrBase*>();
 			}
@@ -290,6 +524,7 @@ namespace mse {
 			(*m_ptr_to_regptr_set_ptr).insert(item);
 		}
 		void unregisterPointer(const CSaferPtrBase& sp_ref) {
+			MSE_SAFETY_CHECK_COUNT("TRegisteredPointer", unregistration);
 			if (!m_ptr_to_regptr_set_ptr) {
 				assert(false);
 			}
@@ -330,7 +565,7 @@ namespace mse {
 	std::shared_ptr, but that does not take ownership of the target object (i.e. does not take responsibility for deallocation).
 	Because it does not take ownership, unlike std::shared_ptr, TRegisteredPointer can be used to point to objects on the stack. */
 	template<typename _Ty, int _Tn = sc_default_cache_size>
-	class TRegisteredPointer : public TSaferPtr<TRegisteredObj<_Ty, _Tn>> {
+	class TRegisteredPointer : public TSaferPtr<TRegisteredObj<_Ty, _Tn>>, public TRPTrackerNode<_Tn> {
 	public:
 		TRegisteredPointer();
 		TRegisteredPointer(TRegisteredObj<_Ty, _Tn>* ptr);
@@ -368,7 +603,7 @@ namespace mse {
 	};
 
 	template<typename _Ty, int _Tn = sc_default_cache_size>
-	class TRegisteredConstPointer : public TSaferPtr<const TRegisteredObj<_Ty, _Tn>> {
+	class TRegisteredConstPointer : public TSaferPtr<const TRegisteredObj<_Ty, _Tn>>, public TRPTrackerNode<_Tn> {
 	public:
 		TRegisteredConstPointer();
 		TRegisteredConstPointer(const TRegisteredObj<_Ty, _Tn>* ptr);
@@ -536,7 +771,7 @@ namespace mse {
 		}
 	}
 	template<typename _Ty, int _Tn>
-	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(const TRegisteredPointer& src_cref) : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr) {
+	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(const TRegisteredPointer& src_cref) : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr), TRPTrackerNode<_Tn>() {
 		if (nullptr != (*this).m_ptr) {
 			(*((*this).m_ptr)).mseRPManager().registerPointer(*this);
 		}
@@ -685,6 +920,228 @@ namespace mse {
 
 #endif /*MSE_REGISTEREDPOINTER_DISABLED*/
 
+	/* CRegisteredObjPool is a simple size-class based pool allocator that registered_new_in() and registered_pooled_new() can
+	use in place of the global heap. Each size class has its own free list, and memory is obtained from the heap in chunks, so
+	repeatedly allocating and freeing (registered) objects doesn't involve the heap. Allocations too big (or too aligned) for
+	any size class are passed on to the heap (the aligned ::operator new() for over-aligned types). Allocation from a pool
+	is not thread safe. Only the thread that created the pool (its "owner") should allocate from it. But objects can be
+	deallocated from any thread. Deallocations from other threads are pushed onto (per size class) atomic "remote free"
+	lists, which the owner takes over when its own free list runs out. Each thread has its own default pool (see
+	this_threads_pool()), so threads don't contend for one. */
+	class CRegisteredObjPool {
+	public:
+		CRegisteredObjPool() : m_owner_thread_id(std::this_thread::get_id()) {
+			for (int i = 0; i < sc_num_size_classes; i += 1) {
+				m_free_lists[i] = nullptr;
+				m_remote_free_lists[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+		CRegisteredObjPool(const CRegisteredObjPool&) = delete;
+		CRegisteredObjPool& operator=(const CRegisteredObjPool&) = delete;
+		~CRegisteredObjPool() {
+			/* The pool shouldn't be destroyed while any of its allocations are still outstanding. */
+			assert(0 == num_outstanding_allocations());
+			while (nullptr != m_chunks) {
+				auto next_chunk = m_chunks->m_next_chunk;
+				heap_deallocate(m_chunks->m_raw_ptr, reinterpret_cast<unsigned char*>(m_chunks + 1));
+				m_chunks = next_chunk;
+			}
+		}
+
+		void* allocate(size_t size, size_t alignment = sc_block_alignment) {
+			if ((sc_max_pooled_size < size) || (sc_block_alignment < alignment)) {
+				/* This allocation doesn't fit in any size class, so we'll just use the heap. */
+				void* raw_ptr = nullptr;
+				auto block_ptr = reinterpret_cast<CBlockHeader*>(heap_allocate(size, (sc_block_alignment < alignment) ? alignment : sc_block_alignment, raw_ptr)) - 1;
+				block_ptr->m_pool_ptr = nullptr;
+				block_ptr->m_raw_ptr = raw_ptr;
+				return block_ptr + 1;
+			}
+			const size_t size_class_index = (0 == size) ? 0 : ((size - 1) / sc_size_class_granularity);
+			if (nullptr == m_free_lists[size_class_index]) {
+				/* First we'll try taking over the blocks that other threads have deallocated. */
+				m_free_lists[size_class_index] = m_remote_free_lists[size_class_index].exchange(nullptr, std::memory_order_acquire);
+				if (nullptr == m_free_lists[size_class_index]) {
+					refill(size_class_index);
+				}
+			}
+			auto block_ptr = m_free_lists[size_class_index];
+			m_free_lists[size_class_index] = block_ptr->m_next_free_ptr;
+			block_ptr->m_size_class_index = size_class_index;
+			m_num_outstanding_allocations += 1;
+			return block_ptr + 1;
+		}
+		/* Returns the memory to the pool it was allocated from. */
+		static void deallocate(void* ptr) {
+			if (nullptr == ptr) { return; }
+			auto block_ptr = static_cast<CBlockHeader*>(ptr) - 1;
+			auto pool_ptr = block_ptr->m_pool_ptr;
+			if (nullptr == pool_ptr) {
+				heap_deallocate(block_ptr->m_raw_ptr, static_cast<unsigned char*>(ptr));
+				return;
+			}
+			const auto size_class_index = block_ptr->m_size_class_index;
+			/* Once the pool is orphaned, its owner thread id may be reused by another thread. */
+			if ((!pool_ptr->m_orphaned.load(std::memory_order_acquire)) && (std::this_thread::get_id() == pool_ptr->m_owner_thread_id)) {
+				block_ptr->m_next_free_ptr = pool_ptr->m_free_lists[size_class_index];
+				pool_ptr->m_free_lists[size_class_index] = block_ptr;
+				pool_ptr->m_num_outstanding_allocations -= 1;
+				return;
+			}
+			auto& remote_free_list_ref = pool_ptr->m_remote_free_lists[size_class_index];
+			block_ptr->m_next_free_ptr = remote_free_list_ref.load(std::memory_order_relaxed);
+			while (!remote_free_list_ref.compare_exchange_weak(block_ptr->m_next_free_ptr, block_ptr, std::memory_order_release, std::memory_order_relaxed)) {}
+			if (0 == (pool_ptr->m_num_remote_deallocations.fetch_add(1, std::memory_order_acq_rel) + 1)) {
+				/* The thread that owned this pool has exited, and this was its last outstanding allocation. */
+				delete pool_ptr;
+			}
+		}
+
+		size_t num_outstanding_allocations() const {
+			return size_t(std::ptrdiff_t(m_num_outstanding_allocations) - m_num_remote_deallocations.load(std::memory_order_acquire));
+		}
+
+		/* Each thread has its own (default) pool. */
+		static CRegisteredObjPool& this_threads_pool() {
+			static thread_local CThreadPoolHolder tl_pool_holder;
+			return *(tl_pool_holder.m_pool_ptr);
+		}
+
+		MSE_CONSTEXPR static const size_t sc_block_alignment = 16;
+		MSE_CONSTEXPR static const size_t sc_size_class_granularity = 16;
+		MSE_CONSTEXPR static const size_t sc_max_pooled_size = 256;
+
+	private:
+		MSE_CONSTEXPR static const int sc_num_size_classes = int(sc_max_pooled_size / sc_size_class_granularity);
+		MSE_CONSTEXPR static const size_t sc_min_chunk_size = 16 * 1024;
+		MSE_CONSTEXPR static const size_t sc_min_blocks_per_chunk = 16;
+
+#ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+		MSE_CONSTEXPR static const size_t sc_heap_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else /*__STDCPP_DEFAULT_NEW_ALIGNMENT__*/
+		MSE_CONSTEXPR static const size_t sc_heap_alignment = alignof(std::max_align_t);
+#endif /*__STDCPP_DEFAULT_NEW_ALIGNMENT__*/
+
+		/* Every block is preceded by this header, which is padded to preserve the block's alignment (on 32-bit targets too). */
+		class alignas(sc_block_alignment) CBlockHeader {
+		public:
+			CRegisteredObjPool* m_pool_ptr;
+			union {
+				size_t m_size_class_index;
+				CBlockHeader* m_next_free_ptr;
+				void* m_raw_ptr; /* (for blocks that were allocated directly from the heap) */
+			};
+		};
+		static_assert(sizeof(CBlockHeader) <= sc_block_alignment, "");
+		class alignas(sc_block_alignment) CChunkHeader {
+		public:
+			CChunkHeader* m_next_chunk;
+			void* m_raw_ptr;
+		};
+		static_assert(sizeof(CChunkHeader) <= sc_block_alignment, "");
+
+		/* Returns heap memory of the given size and (power of two, no less than sc_block_alignment) alignment that is preceded
+		by at least sc_block_alignment bytes of (similarly aligned) header space. raw_ptr receives the address to eventually
+		pass to heap_deallocate(). Alignments beyond what ::operator new() guarantees are passed on to the aligned
+		::operator new() where it's available. */
+		static unsigned char* heap_allocate(size_t size, size_t alignment, void*& raw_ptr) {
+			if ((std::numeric_limits<size_t>::max() - 2 * alignment) < size) {
+				throw(std::bad_alloc());
+			}
+			if (sc_heap_alignment >= alignment) {
+				raw_ptr = ::operator new(alignment + size);
+				return static_cast<unsigned char*>(raw_ptr) + alignment;
+			}
+#ifdef __cpp_aligned_new
+			raw_ptr = ::operator new(alignment + size, std::align_val_t(alignment));
+			return static_cast<unsigned char*>(raw_ptr) + alignment;
+#else /*__cpp_aligned_new*/
+			raw_ptr = ::operator new(sc_block_alignment + (alignment - 1) + size);
+			auto header_end = reinterpret_cast<std::uintptr_t>(raw_ptr) + sc_block_alignment;
+			return reinterpret_cast<unsigned char*>((header_end + (alignment - 1)) & ~std::uintptr_t(alignment - 1));
+#endif /*__cpp_aligned_new*/
+		}
+		static void heap_deallocate(void* raw_ptr, unsigned char* body_ptr) {
+#ifdef __cpp_aligned_new
+			/* heap_allocate() only uses the aligned ::operator new() when the body is offset by (its alignment, which is)
+			more than sc_heap_alignment. */
+			const size_t alignment = size_t(body_ptr - static_cast<unsigned char*>(raw_ptr));
+			if (sc_heap_alignment < alignment) {
+				::operator delete(raw_ptr, std::align_val_t(alignment));
+				return;
+			}
+#else /*__cpp_aligned_new*/
+			(void)body_ptr;
+#endif /*__cpp_aligned_new*/
+			::operator delete(raw_ptr);
+		}
+
+		class CThreadPoolHolder {
+		public:
+			CThreadPoolHolder() : m_pool_ptr(new CRegisteredObjPool()) {}
+			~CThreadPoolHolder() {
+				m_pool_ptr->m_orphaned.store(true, std::memory_order_release);
+				/* From here on every deallocation goes through m_num_remote_deallocations. Moving the (owner's count of)
+				outstanding allocations into it makes it reach zero when the last outstanding allocation is deallocated. */
+				const auto local_count = std::ptrdiff_t(m_pool_ptr->m_num_outstanding_allocations);
+				m_pool_ptr->m_num_outstanding_allocations = 0;
+				if (local_count == m_pool_ptr->m_num_remote_deallocations.fetch_sub(local_count, std::memory_order_acq_rel)) {
+					delete m_pool_ptr;
+				}
+				/* Otherwise the pool will be deleted when its last outstanding allocation is deallocated. */
+			}
+			CRegisteredObjPool* m_pool_ptr;
+		};
+
+		void refill(size_t size_class_index) {
+			const size_t block_size = sizeof(CBlockHeader) + (size_class_index + 1) * sc_size_class_granularity;
+			size_t num_blocks = sc_min_chunk_size / block_size;
+			if (sc_min_blocks_per_chunk > num_blocks) {
+				num_blocks = sc_min_blocks_per_chunk;
+			}
+			void* raw_ptr = nullptr;
+			auto block_bytes_ptr = heap_allocate(num_blocks * block_size, sc_block_alignment, raw_ptr);
+			auto chunk_ptr = reinterpret_cast<CChunkHeader*>(block_bytes_ptr) - 1;
+			chunk_ptr->m_next_chunk = m_chunks;
+			chunk_ptr->m_raw_ptr = raw_ptr;
+			m_chunks = chunk_ptr;
+			for (size_t i = 0; i < num_blocks; i += 1) {
+				auto block_ptr = reinterpret_cast<CBlockHeader*>(block_bytes_ptr + i * block_size);
+				block_ptr->m_pool_ptr = this;
+				block_ptr->m_next_free_ptr = m_free_lists[size_class_index];
+				m_free_lists[size_class_index] = block_ptr;
+			}
+		}
+
+		CBlockHeader* m_free_lists[sc_num_size_classes];
+		std::atomic<CBlockHeader*> m_remote_free_lists[sc_num_size_classes];
+		CChunkHeader* m_chunks = nullptr;
+		const std::thread::id m_owner_thread_id;
+		/* The number of allocations, less the deallocations done by the owner thread. Only accessed by the owner thread. */
+		size_t m_num_outstanding_allocations = 0;
+		/* The number of deallocations done by other threads (and by any thread once the pool is orphaned). */
+		std::atomic<std::ptrdiff_t> m_num_remote_deallocations{ 0 };
+		std::atomic<bool> m_orphaned{ false };
+	};
+
+	/* TRegisteredObjPoolTraits specifies the pool that registered_pooled_new<_Ty>() allocates from. By default it's the calling
+	thread's pool. You can specialize it for your own types. */
+	template<class _Ty>
+	class TRegisteredObjPoolTraits {
+	public:
+		static CRegisteredObjPool& default_pool() { return CRegisteredObjPool::this_threads_pool(); }
+	};
+
+	namespace us {
+		namespace impl {
+			/* The address of the memory block that was allocated for the (most derived) object. */
+			template<class _Ty>
+			const void* allocation_address(const _Ty* ptr, std::true_type/*is_polymorphic*/) { return dynamic_cast<const void*>(ptr); }
+			template<class _Ty>
+			const void* allocation_address(const _Ty* ptr, std::false_type/*is_polymorphic*/) { return ptr; }
+		}
+	}
+
 	/* registered_new is intended to be analogous to std::make_shared */
 	template <class _Ty, int _Tn = sc_default_cache_size, class... Args>
 	TRegisteredPointer<_Ty, _Tn> registered_new(Args&&... args) {
@@ -703,6 +1160,45 @@ namespace mse {
 		delete a;
 	}
 
+	/* registered_new_in() is like registered_new(), but allocates the object from the given pool. Objects allocated this
+	way must be deallocated with registered_pooled_delete(). */
+	template <class _Ty, int _Tn = sc_default_cache_size, class... Args>
+	TRegisteredPointer<_Ty, _Tn> registered_new_in(CRegisteredObjPool& pool, Args&&... args) {
+		auto mem_ptr = pool.allocate(sizeof(TRegisteredObj<_Ty, _Tn>), alignof(TRegisteredObj<_Ty, _Tn>));
+		TRegisteredObj<_Ty, _Tn>* a = nullptr;
+		try {
+			a = new (mem_ptr) TRegisteredObj<_Ty, _Tn>(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			CRegisteredObjPool::deallocate(mem_ptr);
+			throw;
+		}
+		return a;
+	}
+	/* registered_pooled_new() allocates from the type's default pool (see TRegisteredObjPoolTraits). */
+	template <class _Ty, int _Tn = sc_default_cache_size, class... Args>
+	TRegisteredPointer<_Ty, _Tn> registered_pooled_new(Args&&... args) {
+		return registered_new_in<_Ty, _Tn>(TRegisteredObjPoolTraits<_Ty>::default_pool(), std::forward<Args>(args)...);
+	}
+	template <class _Ty, int _Tn = sc_default_cache_size>
+	void registered_pooled_delete(const TRegisteredPointer<_Ty, _Tn>& regPtrRef) {
+		auto a = (TRegisteredObj<_Ty, _Tn>*)regPtrRef;
+		if (nullptr == a) { return; }
+		auto mem_ptr = const_cast<void*>(us::impl::allocation_address(a, typename std::is_polymorphic<TRegisteredObj<_Ty, _Tn>>::type()));
+		typedef TRegisteredObj<_Ty, _Tn> obj_type;
+		a->~obj_type();
+		CRegisteredObjPool::deallocate(mem_ptr);
+	}
+	template <class _Ty, int _Tn = sc_default_cache_size>
+	void registered_pooled_delete(const TRegisteredConstPointer<_Ty, _Tn>& regPtrRef) {
+		auto a = (const TRegisteredObj<_Ty, _Tn>*)regPtrRef;
+		if (nullptr == a) { return; }
+		auto mem_ptr = const_cast<void*>(us::impl::allocation_address(a, typename std::is_polymorphic<TRegisteredObj<_Ty, _Tn>>::type()));
+		typedef TRegisteredObj<_Ty, _Tn> obj_type;
+		a->~obj_type();
+		CRegisteredObjPool::deallocate(mem_ptr);
+	}
+
 #ifdef MSE_REGISTEREDPOINTER_DISABLED
 #else /*MSE_REGISTEREDPOINTER_DISABLED*/
 
@@ -977,6 +1473,101 @@ namespace mse {
 				int q = 7;
 			}
 		}
+
+#ifndef MSE_REGISTEREDPOINTER_DISABLED
+		{
+			/* Exercising the tracker's slow storage, which is used when lots of pointers target the same object. */
+			static const int num_ptrs = 200;
+			mse::TRegisteredPointer<A> A_registered_ptrs[num_ptrs];
+			{
+				mse::TRegisteredObj<A> registered_a;
+				for (int i = 0; i < num_ptrs; i += 1) {
+					A_registered_ptrs[i] = &registered_a;
+				}
+				/* Unregister (in a scattered order) about half of the pointers. */
+				for (int i = 0; i < num_ptrs; i += 7) {
+					A_registered_ptrs[(i * 37) % num_ptrs] = nullptr;
+				}
+				for (int i = 0; i < num_ptrs; i += 7) {
+					A_registered_ptrs[(i * 37) % num_ptrs] = &registered_a;
+				}
+				for (int i = 0; i < num_ptrs; i += 2) {
+					A_registered_ptrs[i] = nullptr;
+				}
+				assert(size_t(num_ptrs / 2) == registered_a.mseRPManager().m_ptr_to_regptr_set_ptr->size());
+				for (int i = 1; i < num_ptrs; i += 2) {
+					assert(3 == A_registered_ptrs[i]->b);
+				}
+			}
+			for (int i = 0; i < num_ptrs; i += 1) {
+				/* The target object has been destroyed, so all the pointers should have been set to null. */
+				assert(!A_registered_ptrs[i]);
+			}
+		}
+
+		{
+			/* The "intrusive list" tracking mechanism. */
+			static const int num_ptrs = 20;
+			mse::TRegisteredPointer<A, mse::sc_intrusive_list_tracking> A_registered_ptrs[num_ptrs];
+			mse::TRegisteredConstPointer<A, mse::sc_intrusive_list_tracking> A_registered_cptr1;
+			{
+				mse::TRegisteredObj<A, mse::sc_intrusive_list_tracking> registered_a;
+				for (int i = 0; i < num_ptrs; i += 1) {
+					A_registered_ptrs[i] = &registered_a;
+				}
+				A_registered_cptr1 = A_registered_ptrs[3];
+				/* Unregister the pointers at the head, the tail and the middle of the list. */
+				A_registered_ptrs[num_ptrs - 1] = nullptr;
+				A_registered_ptrs[0] = nullptr;
+				A_registered_ptrs[num_ptrs / 2] = nullptr;
+				{
+					auto A_registered_ptr2 = A_registered_ptrs[1];
+					assert(3 == A_registered_ptr2->b);
+				}
+				assert(3 == A_registered_cptr1->b);
+			}
+			assert(!A_registered_cptr1);
+			for (int i = 0; i < num_ptrs; i += 1) {
+				assert(!A_registered_ptrs[i]);
+			}
+		}
+#endif // !MSE_REGISTEREDPOINTER_DISABLED
+
+		{
+			/* Allocating registered objects from a pool. */
+			mse::CRegisteredObjPool pool;
+			auto A_registered_ptr5 = mse::registered_new_in<A>(pool);
+			auto A_registered_ptr6 = mse::registered_new_in<A>(pool);
+			mse::TRegisteredPointer<A> A_registered_ptr7 = A_registered_ptr6;
+			assert(3 == A_registered_ptr5->b);
+			assert(2 == pool.num_outstanding_allocations());
+			mse::registered_pooled_delete<A>(A_registered_ptr6);
+			assert(1 == pool.num_outstanding_allocations());
+#ifndef MSE_REGISTEREDPOINTER_DISABLED
+			assert(!A_registered_ptr7);
+#endif // !MSE_REGISTEREDPOINTER_DISABLED
+			mse::registered_pooled_delete<A>(A_registered_ptr5);
+			assert(0 == pool.num_outstanding_allocations());
+
+			/* Using the default (thread local) pool. */
+			auto A_registered_ptr8 = mse::registered_pooled_new<A>();
+			mse::TRegisteredConstPointer<A> A_registered_cptr2 = A_registered_ptr8;
+			mse::registered_pooled_delete<A>(A_registered_cptr2);
+
+			/* Objects may be deallocated from other threads. */
+			auto A_registered_ptr9 = mse::registered_new_in<A>(pool);
+			std::thread([&A_registered_ptr9]() { mse::registered_pooled_delete<A>(A_registered_ptr9); }).join();
+			assert(0 == pool.num_outstanding_allocations());
+			auto A_registered_ptr10 = mse::registered_new_in<A>(pool);
+			assert(1 == pool.num_outstanding_allocations());
+			mse::registered_pooled_delete<A>(A_registered_ptr10);
+
+			/* Objects may outlive the thread (and so the default pool) they were allocated from. */
+			mse::TRegisteredPointer<A> A_registered_ptr11;
+			std::thread([&A_registered_ptr11]() { A_registered_ptr11 = mse::registered_pooled_new<A>(); }).join();
+			assert(3 == A_registered_ptr11->b);
+			mse::registered_pooled_delete<A>(A_registered_ptr11);
+		}
 #endif // MSE_SELF_TESTS
 	}
 }
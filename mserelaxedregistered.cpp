@@ -5,29 +5,30 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 
 #include "mserelaxedregistered.h"
-
-#ifdef _MSC_VER
-#include "windows.h"
-#endif /*_MSC_VER*/
+#include <algorithm>
 
 
 namespace mse {
 
 	bool CSPTracker::registerPointer(const CSaferPtrBase& sp_ref, void *obj_ptr) {
 		if (nullptr == obj_ptr) { return true; }
+		MSE_SAFETY_CHECK_COUNT("TRelaxedRegisteredPointer", registration);
+		adjustFastStorage1CapacityIfDue();
 		{
 			//std::lock_guard<std::mutex> lock(m_mutex);
 
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+					note_fs1_hit(i);
 					auto& fs1_object_ref = m_fs1_objects[i];
-					if (sc_fs1_max_pointers == fs1_object_ref.m_num_pointers) {
+					if (m_fs1_max_pointers <= fs1_object_ref.m_num_pointers) {
 						/* Too many pointers. We're gonna move this object to slow storage. */
+						m_statistics.m_num_fs1_promotions += 1;
+						MSE_SAFETY_CHECK_COUNT("TRelaxedRegisteredPointer", fast_to_slow_mode_transition);
 						moveObjectFromFastStorage1ToSlowStorage(i);
 						/* Then add the new object-pointer mapping to slow storage. */
-						std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(obj_ptr, &sp_ref);
-						m_obj_pointer_map.insert(item);
+						m_slow_storage.insert(obj_ptr, &sp_ref);
 						return true;
 					}
 					else {
@@ -40,18 +41,17 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". Check if it's in "slow storage". */
+			note_fs1_miss();
 			bool object_is_in_slow_storage = false;
-			if (1 <= m_obj_pointer_map.size()) {
-				auto found_it = m_obj_pointer_map.find(obj_ptr);
-				if (m_obj_pointer_map.end() != found_it) {
-					object_is_in_slow_storage = true;
-				}
+			if (1 <= m_slow_storage.size()) {
+				object_is_in_slow_storage = m_slow_storage.containsObject(obj_ptr);
 			}
 
-			if ((!object_is_in_slow_storage) && (1 <= sc_fs1_max_objects) && (1 <= sc_fs1_max_pointers)) {
+			if ((!object_is_in_slow_storage) && (1 <= m_fs1_max_objects) && (1 <= m_fs1_max_pointers)) {
 				/* We'll add this object to fast storage. */
-				if (sc_fs1_max_objects == m_num_fs1_objects) {
+				if (m_fs1_max_objects <= m_num_fs1_objects) {
 					/* Too many objects. We're gonna move the oldest object to slow storage. */
+					m_statistics.m_num_fs1_evictions += 1;
 					moveObjectFromFastStorage1ToSlowStorage(0);
 				}
 				auto& fs1_object_ref = m_fs1_objects[m_num_fs1_objects];
@@ -63,8 +63,7 @@ namespace mse {
 			}
 			else {
 				/* Add the mapping to slow storage. */
-				std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(obj_ptr, &sp_ref);
-				m_obj_pointer_map.insert(item);
+				m_slow_storage.insert(obj_ptr, &sp_ref);
 			}
 		}
 		return true;
@@ -72,6 +71,7 @@ namespace mse {
 
 	bool CSPTracker::unregisterPointer(const CSaferPtrBase& sp_ref, void *obj_ptr) {
 		if (nullptr == obj_ptr) { return true; }
+		MSE_SAFETY_CHECK_COUNT("TRelaxedRegisteredPointer", unregistration);
 		bool retval = false;
 		{
 			//std::lock_guard<std::mutex> lock(m_mutex);
@@ -79,6 +79,7 @@ namespace mse {
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+					note_fs1_hit(i);
 					auto& fs1_object_ref = m_fs1_objects[i];
 					if (1 == fs1_object_ref.m_num_pointers) {
 						/* Special case code just for speed. */
@@ -117,16 +118,8 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". It's proably in "slow storage". */
-			auto range = m_obj_pointer_map.equal_range(obj_ptr);
-			if (true) {
-				for (auto& it = range.first; range.second != it; it++) {
-					if (((*it).second) == &sp_ref)/*we're comparing "native pointers pointing to smart pointers" here*/ {
-						m_obj_pointer_map.erase(it);
-						retval = true;
-						break;
-					}
-				}
-			}
+			note_fs1_miss();
+			retval = m_slow_storage.erase(obj_ptr, &sp_ref);
 		}
 		return retval;
 	}
@@ -139,6 +132,7 @@ namespace mse {
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+					note_fs1_hit(i);
 					auto& fs1_object_ref = m_fs1_objects[i];
 					for (int j = 0; j < fs1_object_ref.m_num_pointers; j += 1) {
 						(*(fs1_object_ref.m_pointer_ptrs[j])).setToNull();
@@ -149,20 +143,18 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". It's proably in "slow storage". */
-			auto range = m_obj_pointer_map.equal_range(obj_ptr);
-			for (auto it = range.first; range.second != it; it++) {
-				(*((*it).second)).setToNull();
-			}
-			m_obj_pointer_map.erase(obj_ptr);
+			note_fs1_miss();
+			m_slow_storage.onObjectDestruction(obj_ptr);
 		}
 	}
 
 	void CSPTracker::onObjectConstruction(void *obj_ptr) {
 		if (nullptr == obj_ptr) { assert(false); return; }
-		if ((1 <= sc_fs1_max_objects) && (1 <= sc_fs1_max_pointers)) {
+		if ((1 <= m_fs1_max_objects) && (1 <= m_fs1_max_pointers)) {
 			/* We'll add this object to fast storage. */
-			if (sc_fs1_max_objects == m_num_fs1_objects) {
+			if (m_fs1_max_objects <= m_num_fs1_objects) {
 				/* Too many objects. We're gonna move the oldest object to slow storage. */
+				m_statistics.m_num_fs1_evictions += 1;
 				moveObjectFromFastStorage1ToSlowStorage(0);
 			}
 			auto& fs1_object_ref = m_fs1_objects[m_num_fs1_objects];
@@ -184,18 +176,221 @@ namespace mse {
 		auto& fs1_object_ref = m_fs1_objects[fs1_obj_index];
 		/* First we're gonna copy this object to slow storage. */
 		for (int j = 0; j < fs1_object_ref.m_num_pointers; j += 1) {
-			std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(fs1_object_ref.m_object_ptr, fs1_object_ref.m_pointer_ptrs[j]);
-			m_obj_pointer_map.insert(item);
+			m_slow_storage.insert(fs1_object_ref.m_object_ptr, fs1_object_ref.m_pointer_ptrs[j]);
 		}
 		/* Then we're gonna remove the object from fast storage */
 		removeObjectFromFastStorage1(fs1_obj_index);
 	}
 
-#ifdef _MSC_VER
-	MSE_THREAD_ID_TYPE CSPTrackerMap::mseWindowsGetCurrentThreadId() {
-		return GetCurrentThreadId();
+	void CSPTracker::adjustFastStorage1Capacity() {
+		const auto& now = m_statistics;
+		const auto& before = m_statistics_at_last_adjustment;
+		const auto lookups = (now.m_num_fs1_hits - before.m_num_fs1_hits) + (now.m_num_fs1_misses - before.m_num_fs1_misses);
+		const auto misses = now.m_num_fs1_misses - before.m_num_fs1_misses;
+		const auto promotions = now.m_num_fs1_promotions - before.m_num_fs1_promotions;
+		const auto evictions = now.m_num_fs1_evictions - before.m_num_fs1_evictions;
+		bool resized = false;
+
+		if ((0 != evictions) && (lookups < 8 * misses)) {
+			/* More than an eighth of the lookups missed fast storage, and objects are being evicted to make room for others.
+			So we'll try a bigger fast storage. */
+			if (sc_fs1_max_objects_upper_bound > m_fs1_max_objects) {
+				m_fs1_max_objects = std::min(2 * m_fs1_max_objects, int(sc_fs1_max_objects_upper_bound));
+				resized = true;
+			}
+		}
+		else if ((0 == evictions) && (4 * m_deepest_fs1_hit_since_last_adjustment <= m_fs1_max_objects)) {
+			/* All the objects found in fast storage were among the most recently added quarter of them. So we'll shrink
+			it, which shortens the linear searches for objects that aren't in fast storage. */
+			if (sc_fs1_min_objects < m_fs1_max_objects) {
+				m_fs1_max_objects = std::max(m_fs1_max_objects / 2, int(sc_fs1_min_objects));
+				/* Moving objects to slow storage could allocate, so here we only drop the oldest objects that have no
+				pointers to move. Any remaining excess objects leave fast storage as they are evicted or destroyed. */
+				for (int i = 0; (m_fs1_max_objects < m_num_fs1_objects) && (i < m_num_fs1_objects);) {
+					if (0 == m_fs1_objects[i].m_num_pointers) {
+						removeObjectFromFastStorage1(i);
+					}
+					else {
+						i += 1;
+					}
+				}
+				resized = true;
+			}
+		}
+		if (lookups < 64 * promotions) {
+			/* Objects are frequently being moved to slow storage because they have too many pointers targeting them. */
+			if (sc_fs1_max_pointers_upper_bound > m_fs1_max_pointers) {
+				m_fs1_max_pointers += 1;
+				resized = true;
+			}
+		}
+		assert((sc_fs1_min_objects <= m_fs1_max_objects) && (sc_fs1_max_objects_upper_bound >= m_fs1_max_objects));
+		assert((sc_fs1_min_pointers <= m_fs1_max_pointers) && (sc_fs1_max_pointers_upper_bound >= m_fs1_max_pointers));
+
+		if (resized) {
+			m_statistics.m_num_fs1_resizes += 1;
+		}
+		m_statistics_at_last_adjustment = m_statistics;
+		m_deepest_fs1_hit_since_last_adjustment = 0;
+		m_fs1_lookups_until_adjustment = sc_fs1_adjustment_interval;
+	}
+
+	bool CSPTrackerMultimapSlowStorage::erase(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+		auto range = m_obj_pointer_map.equal_range(obj_ptr);
+		for (auto& it = range.first; range.second != it; it++) {
+			if (((*it).second) == sp_ptr)/*we're comparing "native pointers pointing to smart pointers" here*/ {
+				m_obj_pointer_map.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CSPTrackerMultimapSlowStorage::onObjectDestruction(void *obj_ptr) {
+		auto range = m_obj_pointer_map.equal_range(obj_ptr);
+		for (auto it = range.first; range.second != it; it++) {
+			(*((*it).second)).setToNull();
+		}
+		m_obj_pointer_map.erase(obj_ptr);
+	}
+
+	CSPTrackerFlatSlowStorage::~CSPTrackerFlatSlowStorage() {
+		for (size_t i = 0; i < m_capacity; i += 1) {
+			if ((nullptr != m_entries[i].m_object_ptr) && (sc_inline_pointers < m_entries[i].m_capacity)) {
+				delete[] m_entries[i].m_heap_pointers;
+			}
+		}
+		delete[] m_entries;
+	}
+
+	size_t CSPTrackerFlatSlowStorage::home_index(void *obj_ptr) const {
+		/* Fibonacci hashing. The low bits of the (aligned) object address are mostly zero so we drop them first. */
+		MSE_CONSTEXPR static const uintptr_t sc_multiplier = (8 <= sizeof(uintptr_t))
+			? uintptr_t(11400714819323198485ull) : uintptr_t(2654435769u);
+		const auto hash = (uintptr_t(obj_ptr) >> 3) * sc_multiplier;
+		return size_t(hash >> (sizeof(uintptr_t) * CHAR_BIT - m_capacity_log2));
+	}
+
+	size_t CSPTrackerFlatSlowStorage::find_index(void *obj_ptr) const {
+		size_t index = home_index(obj_ptr);
+		while ((nullptr != m_entries[index].m_object_ptr) && (obj_ptr != m_entries[index].m_object_ptr)) {
+			index = (index + 1) & (m_capacity - 1);
+		}
+		return index;
+	}
+
+	void CSPTrackerFlatSlowStorage::insert(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+		reserve_objects(m_num_objects + 1);
+		auto& entry_ref = m_entries[find_index(obj_ptr)];
+		if (nullptr == entry_ref.m_object_ptr) {
+			entry_ref.m_object_ptr = obj_ptr;
+			entry_ref.m_num_pointers = 0;
+			entry_ref.m_capacity = sc_inline_pointers;
+			m_num_objects += 1;
+		}
+		else if (entry_ref.m_capacity == entry_ref.m_num_pointers) {
+			/* The list of pointers is full. We'll move it to a bigger (heap allocated) array. */
+			const int new_capacity = 2 * entry_ref.m_capacity;
+			auto new_heap_pointers = new const CSaferPtrBase*[new_capacity];
+			const auto old_pointers = entry_ref.pointers();
+			for (int j = 0; j < entry_ref.m_num_pointers; j += 1) {
+				new_heap_pointers[j] = old_pointers[j];
+			}
+			if (sc_inline_pointers < entry_ref.m_capacity) {
+				delete[] entry_ref.m_heap_pointers;
+			}
+			entry_ref.m_heap_pointers = new_heap_pointers;
+			entry_ref.m_capacity = new_capacity;
+		}
+		entry_ref.pointers()[entry_ref.m_num_pointers] = sp_ptr;
+		entry_ref.m_num_pointers += 1;
+		m_num_mappings += 1;
+	}
+
+	bool CSPTrackerFlatSlowStorage::erase(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+		if (0 == m_num_objects) { return false; }
+		const auto index = find_index(obj_ptr);
+		auto& entry_ref = m_entries[index];
+		if (nullptr == entry_ref.m_object_ptr) { return false; }
+		auto pointers = entry_ref.pointers();
+		for (int j = (entry_ref.m_num_pointers - 1); j >= 0; j -= 1) {
+			if (sp_ptr == pointers[j]) {
+				/* The order of the pointers doesn't matter, so we just move the last one into the vacated position. */
+				entry_ref.m_num_pointers -= 1;
+				pointers[j] = pointers[entry_ref.m_num_pointers];
+				m_num_mappings -= 1;
+				if (0 == entry_ref.m_num_pointers) {
+					remove_entry(index);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CSPTrackerFlatSlowStorage::onObjectDestruction(void *obj_ptr) {
+		if (0 == m_num_objects) { return; }
+		const auto index = find_index(obj_ptr);
+		auto& entry_ref = m_entries[index];
+		if (nullptr == entry_ref.m_object_ptr) { return; }
+		const auto pointers = entry_ref.pointers();
+		for (int j = 0; j < entry_ref.m_num_pointers; j += 1) {
+			(*(pointers[j])).setToNull();
+		}
+		m_num_mappings -= entry_ref.m_num_pointers;
+		remove_entry(index);
+	}
+
+	void CSPTrackerFlatSlowStorage::remove_entry(size_t index) {
+		if (sc_inline_pointers < m_entries[index].m_capacity) {
+			delete[] m_entries[index].m_heap_pointers;
+		}
+		m_num_objects -= 1;
+		/* "Backward shift" deletion. We move subsequent entries in the probe sequence back into the vacated slot (when
+		doing so doesn't move them in front of their home slot) so that lookups never need tombstones. */
+		const size_t mask = m_capacity - 1;
+		size_t hole = index;
+		size_t next = index;
+		while (true) {
+			next = (next + 1) & mask;
+			if (nullptr == m_entries[next].m_object_ptr) {
+				break;
+			}
+			const size_t next_home = home_index(m_entries[next].m_object_ptr);
+			if (((next - next_home) & mask) >= ((next - hole) & mask)) {
+				m_entries[hole] = m_entries[next];
+				hole = next;
+			}
+		}
+		m_entries[hole].m_object_ptr = nullptr;
+	}
+
+	void CSPTrackerFlatSlowStorage::reserve_objects(size_t num_objects) {
+		/* We keep the load factor at or below 1/2. */
+		if (2 * num_objects <= m_capacity) { return; }
+		size_t new_capacity_log2 = (0 == m_capacity_log2) ? 4 : m_capacity_log2;
+		while (2 * num_objects > (size_t(1) << new_capacity_log2)) {
+			new_capacity_log2 += 1;
+		}
+		const size_t new_capacity = size_t(1) << new_capacity_log2;
+		auto new_entries = new CEntry[new_capacity];
+		for (size_t i = 0; i < new_capacity; i += 1) {
+			new_entries[i].m_object_ptr = nullptr;
+		}
+
+		auto old_entries = m_entries;
+		const auto old_capacity = m_capacity;
+		m_entries = new_entries;
+		m_capacity = new_capacity;
+		m_capacity_log2 = new_capacity_log2;
+		for (size_t i = 0; i < old_capacity; i += 1) {
+			if (nullptr != old_entries[i].m_object_ptr) {
+				/* The entries (including any inline pointers) are just moved bitwise. */
+				m_entries[find_index(old_entries[i].m_object_ptr)] = old_entries[i];
+			}
+		}
+		delete[] old_entries;
 	}
-#endif /*_MSC_VER*/
 
 	CSPTrackerMap gSPTrackerMap;
 }
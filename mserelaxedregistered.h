@@ -24,23 +24,14 @@ former purpose could be satisfied with a faster, safer, "header file only" set o
 #include "msepointerbasics.h"
 #include <utility>
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <mutex>
 #include <cassert>
+#include <cstdint>
 //include <typeinfo>      // std::bad_cast
 #include <stdexcept>
 
-
-#ifdef _MSC_VER
-/* Jan 2016: For some reason std::this_thread::get_id() seems to be really slow in windows. So we're replacing it with the
-native GetCurrentThreadId(). */
-#define MSE_THREAD_ID_TYPE unsigned long /*DWORD*/
-#define MSE_GET_CURRENT_THREAD_ID CSPTrackerMap::mseWindowsGetCurrentThreadId()
-#else /*_MSC_VER*/
-#include <thread>         // std::thread, MSE_THREAD_ID_TYPE, MSE_GET_CURRENT_THREAD_ID
-#define MSE_THREAD_ID_TYPE std::thread::id
-#define MSE_GET_CURRENT_THREAD_ID std::this_thread::get_id()
-#endif /*_MSC_VER*/
-
 #if defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)
 #define MSE_REGISTEREDPOINTER_DISABLED
 #endif /*defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)*/
@@ -83,8 +74,78 @@ namespace mse {
 		using std::logic_error::logic_error;
 	};
 
+	/* CSPTracker's "slow storage" holds the object-pointer mappings that don't fit in its "fast storage". A slow storage class
+	needs to provide the interface below. The default, CSPTrackerFlatSlowStorage, is an open-addressed hash table keyed by
+	object address, where each entry holds the (small) list of pointers targeting the object inline. So for example,
+	destroying an object is just one lookup followed by a scan of a contiguous array of pointers. The original
+	std::unordered_multimap based storage can be selected by defining MSE_SPTRACKER_USE_MULTIMAP_SLOW_STORAGE. */
+	class CSPTrackerMultimapSlowStorage {
+	public:
+		size_t size() const { return m_obj_pointer_map.size(); }
+		bool containsObject(void *obj_ptr) const { return (m_obj_pointer_map.end() != m_obj_pointer_map.find(obj_ptr)); }
+		void insert(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+			std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(obj_ptr, sp_ptr);
+			m_obj_pointer_map.insert(item);
+		}
+		bool erase(void *obj_ptr, const CSaferPtrBase* sp_ptr);
+		/* Sets all the pointers targeting the object to null and removes them. */
+		void onObjectDestruction(void *obj_ptr);
+		void reserve_space_for_one_more() { m_obj_pointer_map.reserve(m_obj_pointer_map.size() + 1); }
+
+		std::unordered_multimap<void*, const CSaferPtrBase*> m_obj_pointer_map;
+	};
+
+	class CSPTrackerFlatSlowStorage {
+	public:
+		CSPTrackerFlatSlowStorage() {}
+		CSPTrackerFlatSlowStorage(const CSPTrackerFlatSlowStorage&) = delete;
+		CSPTrackerFlatSlowStorage& operator=(const CSPTrackerFlatSlowStorage&) = delete;
+		~CSPTrackerFlatSlowStorage();
+
+		size_t size() const { return m_num_mappings; }
+		bool containsObject(void *obj_ptr) const { return (0 != m_num_objects) && (nullptr != m_entries[find_index(obj_ptr)].m_object_ptr); }
+		void insert(void *obj_ptr, const CSaferPtrBase* sp_ptr);
+		bool erase(void *obj_ptr, const CSaferPtrBase* sp_ptr);
+		/* Sets all the pointers targeting the object to null and removes them. */
+		void onObjectDestruction(void *obj_ptr);
+		/* This ensures that the next insert() won't need to grow the table. (Though it could still need to grow the target
+		object's list of pointers.) */
+		void reserve_space_for_one_more() { reserve_objects(m_num_objects + 1); }
+
+	private:
+		MSE_CONSTEXPR static const int sc_inline_pointers = 2;
+		/* Each entry holds the address of an object and the list of pointers targeting it. Small lists are stored inline. */
+		class CEntry {
+		public:
+			const CSaferPtrBase* const* pointers() const { return (sc_inline_pointers >= m_capacity) ? m_inline_pointers : m_heap_pointers; }
+			const CSaferPtrBase** pointers() { return (sc_inline_pointers >= m_capacity) ? m_inline_pointers : m_heap_pointers; }
+
+			void *m_object_ptr;
+			int m_num_pointers;
+			int m_capacity;
+			union {
+				const CSaferPtrBase* m_inline_pointers[sc_inline_pointers];
+				const CSaferPtrBase** m_heap_pointers;
+			};
+		};
+
+		size_t home_index(void *obj_ptr) const;
+		/* Returns the index of the entry for the given object, or of the empty slot where it would be inserted. */
+		size_t find_index(void *obj_ptr) const;
+		void remove_entry(size_t index);
+		void reserve_objects(size_t num_objects);
+
+		CEntry* m_entries = nullptr;
+		size_t m_capacity = 0;
+		size_t m_capacity_log2 = 0;
+		size_t m_num_objects = 0;
+		size_t m_num_mappings = 0;
+	};
+
 	/* CSPTracker is intended to keep track of all pointers, objects and their lifespans in order to ensure that pointers don't
 	end up pointing to deallocated objects. */
+	class CSPTrackerMap;
+
 	class CSPTracker {
 	public:
 		CSPTracker() {}
@@ -101,95 +162,288 @@ namespace mse {
 			/* The purpose of this function is to ensure that the next call to registerPointer() won't
 			need to allocate more memory, and thus won't have any chance of throwing an exception due to
 			memory allocation failure. */
-			m_obj_pointer_map.reserve(m_obj_pointer_map.size() + 1);
+			m_slow_storage.reserve_space_for_one_more();
 		}
 
-		bool isEmpty() const { return ((0 == m_num_fs1_objects) && (0 == m_obj_pointer_map.size())); }
+		bool isEmpty() const { return ((0 == m_num_fs1_objects) && (0 == m_slow_storage.size())); }
+
+		/* Counters describing how effective "fast storage1" has been, along with its current size. Note that the tracker
+		returned by gSPTrackerMap.SPTrackerRef() is specific to the calling thread, and so are its statistics. */
+		class CStatistics {
+		public:
+			/* The number of lookups that found, or didn't find, the object in fast storage. */
+			unsigned long long m_num_fs1_hits = 0;
+			unsigned long long m_num_fs1_misses = 0;
+			/* The number of objects moved to slow storage because they had too many pointers for fast storage. */
+			unsigned long long m_num_fs1_promotions = 0;
+			/* The number of objects moved to slow storage to make room for another object. */
+			unsigned long long m_num_fs1_evictions = 0;
+			unsigned long long m_num_fs1_resizes = 0;
+			int m_fs1_max_objects = 0;
+			int m_fs1_max_pointers = 0;
+		};
+		CStatistics statistics() const {
+			CStatistics retval = m_statistics;
+			retval.m_fs1_max_objects = m_fs1_max_objects;
+			retval.m_fs1_max_pointers = m_fs1_max_pointers;
+			return retval;
+		}
 
 		/* So this tracker stores the object-pointer mappings in either "fast storage1" or "slow storage". The code for
 		"fast storage1" is ugly. The code for "slow storage" is more readable. */
 		void removeObjectFromFastStorage1(int fs1_obj_index);
 		void moveObjectFromFastStorage1ToSlowStorage(int fs1_obj_index);
-		MSE_CONSTEXPR static const int sc_fs1_max_pointers = 3/* must be at least 1 */;
+
+		/* The capacity of "fast storage1" is adjusted at run-time (within these bounds) based on the observed rates of
+		fast storage misses, evictions and promotions. The optimal size depends on how slow "slow storage" is, and on
+		the program's pattern of object and pointer use. */
+		MSE_CONSTEXPR static const int sc_fs1_min_pointers = 2/* must be at least 1 */;
+		MSE_CONSTEXPR static const int sc_fs1_initial_max_pointers = 3;
+		MSE_CONSTEXPR static const int sc_fs1_max_pointers_upper_bound = 6;
+		MSE_CONSTEXPR static const int sc_fs1_min_objects = 4/* must be at least 1 */;
+		MSE_CONSTEXPR static const int sc_fs1_initial_max_objects = 8;
+		MSE_CONSTEXPR static const int sc_fs1_max_objects_upper_bound = 32;
+		/* The number of fast storage lookups between (potential) adjustments. */
+		MSE_CONSTEXPR static const int sc_fs1_adjustment_interval = 4096;
+
+		void note_fs1_hit(int fs1_obj_index) {
+			m_statistics.m_num_fs1_hits += 1;
+			m_fs1_lookups_until_adjustment -= 1;
+			/* Fast storage is searched starting with the most recently added object. */
+			const int depth = m_num_fs1_objects - fs1_obj_index;
+			if (depth > m_deepest_fs1_hit_since_last_adjustment) {
+				m_deepest_fs1_hit_since_last_adjustment = depth;
+			}
+		}
+		void note_fs1_miss() {
+			m_statistics.m_num_fs1_misses += 1;
+			m_fs1_lookups_until_adjustment -= 1;
+		}
+		/* Adjustments are only done at the start of registerPointer(), never from the unregistration and destruction
+		paths, which are called from destructors. They don't allocate or throw. */
+		void adjustFastStorage1CapacityIfDue() {
+			if (0 >= m_fs1_lookups_until_adjustment) {
+				adjustFastStorage1Capacity();
+			}
+		}
+		void adjustFastStorage1Capacity();
+
 		class CFS1Object {
 		public:
 			void* m_object_ptr;
-			const CSaferPtrBase* m_pointer_ptrs[sc_fs1_max_pointers];
+			const CSaferPtrBase* m_pointer_ptrs[sc_fs1_max_pointers_upper_bound];
 			int m_num_pointers = 0;
 		};
-		MSE_CONSTEXPR static const int sc_fs1_max_objects = 8/* Arbitrary. The optimal number depends on how slow "slow storage" is. */;
-		CFS1Object m_fs1_objects[sc_fs1_max_objects];
+		CFS1Object m_fs1_objects[sc_fs1_max_objects_upper_bound];
 		int m_num_fs1_objects = 0;
+		int m_fs1_max_objects = sc_fs1_initial_max_objects;
+		int m_fs1_max_pointers = sc_fs1_initial_max_pointers;
+
+		CStatistics m_statistics;
+		/* The statistics at the time of the last adjustment. */
+		CStatistics m_statistics_at_last_adjustment;
+		int m_fs1_lookups_until_adjustment = sc_fs1_adjustment_interval;
+		int m_deepest_fs1_hit_since_last_adjustment = 0;
 
 		/* "slow storage" */
-		std::unordered_multimap<void*, const CSaferPtrBase*> m_obj_pointer_map;
+#ifdef MSE_SPTRACKER_USE_MULTIMAP_SLOW_STORAGE
+		typedef CSPTrackerMultimapSlowStorage slow_storage_type;
+#else // MSE_SPTRACKER_USE_MULTIMAP_SLOW_STORAGE
+		typedef CSPTrackerFlatSlowStorage slow_storage_type;
+#endif // MSE_SPTRACKER_USE_MULTIMAP_SLOW_STORAGE
+		slow_storage_type m_slow_storage;
+
+		/* The number of relaxed registered pointers and objects that hold (a CSPTrackerPtr to) this tracker. */
+		size_t m_num_referrers = 0;
+		/* Set (by the tracker map) when this tracker should be returned to the map's pool once it has no referrers. */
+		CSPTrackerMap* m_orphaning_map_ptr = nullptr;
 
 		//std::mutex m_mutex;
+
+		friend class CSPTrackerMap;
+		friend class CSPTrackerPtr;
 	};
 
+	/* CSPTrackerMap provides each thread with its own CSPTracker. A pointer to the current thread's tracker is cached in
+	thread_local storage, so obtaining it doesn't involve any locking. The mutex is only taken when a thread obtains its tracker
+	for the first time, and when the thread exits. At that point the tracker, if it's empty, is returned to a pool to be reused
+	by subsequently created threads. A tracker that's still referenced by (relaxed registered) objects or pointers when its
+	thread exits is set aside, as they will continue to use it, and returned to the pool when the last of them is destroyed.
+	thread_local destructors that run after the thread's tracker has been released get a separate ("late") tracker, which is
+	similarly returned to the pool when it no longer has any referrers (if that happens in the exiting thread). */
 	class CSPTrackerMap {
 	public:
-		CSPTrackerMap() {
-			m_first_thread_id = MSE_GET_CURRENT_THREAD_ID;
-			m_first_sp_tracker_pointer = new CSPTracker();
-			//std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*>::value_type item(m_first_thread_id, m_first_sp_tracker_pointer);
-			//auto insert_retval = m_tracker_map.insert(item);
-		}
+		CSPTrackerMap() {}
 		~CSPTrackerMap() {
-			delete m_first_sp_tracker_pointer; m_first_sp_tracker_pointer = nullptr;
-			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it; it++) {
-				delete (*it).second; (*it).second = nullptr;
+			for (auto sp_tracker_ptr : m_available_trackers) {
+				delete sp_tracker_ptr;
+			}
+			for (auto sp_tracker_ptr : m_orphaned_trackers) {
+				delete sp_tracker_ptr;
+			}
+			for (auto sp_tracker_ptr : m_late_trackers) {
+				delete sp_tracker_ptr;
 			}
 		}
-		CSPTracker& SPTrackerRef(const MSE_THREAD_ID_TYPE &thread_id_cref) {
-			if (thread_id_cref == m_first_thread_id) {
-				return (*m_first_sp_tracker_pointer);
+		CSPTracker& SPTrackerRef() {
+			auto& sp_tracker_ptr_ref = this_threads_sp_tracker_ptr_ref();
+			if (nullptr == sp_tracker_ptr_ref) {
+				if (this_threads_sp_tracker_released_ref()) {
+					/* We're being called from a thread_local destructor that ran after this thread's tracker was released. */
+					sp_tracker_ptr_ref = acquire_late_tracker();
+				}
+				else {
+					/* First use in this thread. */
+					static thread_local CThreadSPTrackerHolder tl_sp_tracker_holder(*this);
+					sp_tracker_ptr_ref = tl_sp_tracker_holder.m_sp_tracker_ptr;
+				}
 			}
-			else {
-				std::lock_guard<std::mutex> lock(m_mutex);
-
-				auto found_it = m_tracker_map.find(thread_id_cref);
-				if (m_tracker_map.end() == found_it) {
-					auto new_sp_tracker_ptr = new CSPTracker();
-					std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*>::value_type item(thread_id_cref, new_sp_tracker_ptr);
-					auto insert_retval = m_tracker_map.insert(item);
-					number_of_added_trackers_since_last_pruning += 1;
-					if (10000/*arbitrary*/ < number_of_added_trackers_since_last_pruning) {
-						remove_empty_trackers();
-						number_of_added_trackers_since_last_pruning = 0;
-					}
+			return (*sp_tracker_ptr_ref);
+		}
 
-					found_it = insert_retval.first;
-				}
+		size_t number_of_trackers() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_number_of_trackers;
+		}
+		size_t number_of_available_trackers() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_available_trackers.size();
+		}
+
+	private:
+		class CThreadSPTrackerHolder {
+		public:
+			CThreadSPTrackerHolder(CSPTrackerMap& sp_tracker_map_ref)
+				: m_sp_tracker_map_ref(sp_tracker_map_ref), m_sp_tracker_ptr(sp_tracker_map_ref.acquire_tracker()) {}
+			~CThreadSPTrackerHolder() {
+				/* The tracker may be reused by another thread once released, so any thread_local destructors that run after
+				this one mustn't obtain it from the cache. */
+				this_threads_sp_tracker_ptr_ref() = nullptr;
+				this_threads_sp_tracker_released_ref() = true;
+				m_sp_tracker_map_ref.release_tracker(m_sp_tracker_ptr);
+			}
 
-				m_first_thread_id = thread_id_cref;
-				m_first_sp_tracker_pointer = ((*found_it).second);
+			CSPTrackerMap& m_sp_tracker_map_ref;
+			CSPTracker* m_sp_tracker_ptr = nullptr;
+		};
 
-				return (*((*found_it).second));
+		static CSPTracker*& this_threads_sp_tracker_ptr_ref() {
+			/* This (constant initialized) thread_local pointer doesn't require any "initialization guard" to access. */
+			static thread_local CSPTracker* tl_sp_tracker_ptr = nullptr;
+			return tl_sp_tracker_ptr;
+		}
+		static bool& this_threads_sp_tracker_released_ref() {
+			static thread_local bool tl_sp_tracker_released = false;
+			return tl_sp_tracker_released;
+		}
+		CSPTracker* acquire_tracker() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return acquire_tracker_while_locked();
+		}
+		CSPTracker* acquire_late_tracker() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_late_trackers.reserve(m_late_trackers.size() + 1);
+			auto retval = acquire_tracker_while_locked();
+			retval->m_orphaning_map_ptr = this;
+			m_late_trackers.push_back(retval);
+			return retval;
+		}
+		CSPTracker* acquire_tracker_while_locked() {
+			if (0 != m_available_trackers.size()) {
+				auto retval = m_available_trackers.back();
+				m_available_trackers.pop_back();
+				return retval;
 			}
+			/* Here we ensure that release_tracker() won't need to allocate memory (and potentially throw). */
+			m_available_trackers.reserve(m_number_of_trackers + 1);
+			m_orphaned_trackers.reserve(m_number_of_trackers + 1);
+			auto retval = new CSPTracker();
+			m_number_of_trackers += 1;
+			return retval;
 		}
-		void remove_empty_trackers() {
-			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it; it++) {
-				if ((*it).second->isEmpty()) {
-					delete ((*it).second); (*it).second = nullptr;
-					m_tracker_map.erase(it);
+		void release_tracker(CSPTracker* sp_tracker_ptr) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (0 == sp_tracker_ptr->m_num_referrers) {
+				m_available_trackers.push_back(sp_tracker_ptr);
+			}
+			else {
+				sp_tracker_ptr->m_orphaning_map_ptr = this;
+				m_orphaned_trackers.push_back(sp_tracker_ptr);
+			}
+		}
+		/* Called when an orphaned or late tracker loses its last referrer. */
+		void reclaim_tracker(CSPTracker* sp_tracker_ptr) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto found_it = std::find(m_orphaned_trackers.begin(), m_orphaned_trackers.end(), sp_tracker_ptr);
+			if (m_orphaned_trackers.end() != found_it) {
+				m_orphaned_trackers.erase(found_it);
+			}
+			else {
+				/* A late tracker remains cached by its (exiting) thread, so only that thread can reclaim it (and clear the
+				cache). */
+				auto& sp_tracker_ptr_ref = this_threads_sp_tracker_ptr_ref();
+				if (sp_tracker_ptr_ref != sp_tracker_ptr) {
+					return;
 				}
+				auto late_found_it = std::find(m_late_trackers.begin(), m_late_trackers.end(), sp_tracker_ptr);
+				assert(m_late_trackers.end() != late_found_it);
+				m_late_trackers.erase(late_found_it);
+				sp_tracker_ptr_ref = nullptr;
 			}
+			sp_tracker_ptr->m_orphaning_map_ptr = nullptr;
+			m_available_trackers.push_back(sp_tracker_ptr);
 		}
-#ifdef _MSC_VER
-		static MSE_THREAD_ID_TYPE mseWindowsGetCurrentThreadId();
-#endif /*_MSC_VER*/
 
-
-		MSE_THREAD_ID_TYPE m_first_thread_id;
-		CSPTracker* m_first_sp_tracker_pointer = nullptr;
-		std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*> m_tracker_map;
-		int number_of_added_trackers_since_last_pruning = 0;
+		std::vector<CSPTracker*> m_available_trackers;
+		std::vector<CSPTracker*> m_orphaned_trackers;
+		std::vector<CSPTracker*> m_late_trackers;
+		size_t m_number_of_trackers = 0;
 		std::mutex m_mutex;
+
+		friend class CSPTrackerPtr;
 	};
 
 	extern CSPTrackerMap gSPTrackerMap;
 
+	/* A pointer to a CSPTracker that maintains the tracker's count of referrers, so that a tracker whose thread has exited can
+	be reused once nothing refers to it. */
+	class CSPTrackerPtr {
+	public:
+		CSPTrackerPtr() {}
+		CSPTrackerPtr(CSPTracker* sp_tracker_ptr) : m_ptr(sp_tracker_ptr) { add_referrer(); }
+		CSPTrackerPtr(const CSPTrackerPtr& src) : m_ptr(src.m_ptr) { add_referrer(); }
+		~CSPTrackerPtr() { remove_referrer(); }
+		CSPTrackerPtr& operator=(CSPTracker* sp_tracker_ptr) {
+			if (sp_tracker_ptr != m_ptr) {
+				remove_referrer();
+				m_ptr = sp_tracker_ptr;
+				add_referrer();
+			}
+			return (*this);
+		}
+		CSPTrackerPtr& operator=(const CSPTrackerPtr& _Right_cref) { return operator=(_Right_cref.m_ptr); }
+		operator CSPTracker*() const { return m_ptr; }
+		CSPTracker& operator*() const { return (*m_ptr); }
+		CSPTracker* operator->() const { return m_ptr; }
+
+	private:
+		void add_referrer() {
+			if (nullptr != m_ptr) {
+				m_ptr->m_num_referrers += 1;
+			}
+		}
+		void remove_referrer() {
+			if (nullptr != m_ptr) {
+				m_ptr->m_num_referrers -= 1;
+				if ((0 == m_ptr->m_num_referrers) && (nullptr != m_ptr->m_orphaning_map_ptr)) {
+					m_ptr->m_orphaning_map_ptr->reclaim_tracker(m_ptr);
+				}
+			}
+		}
+
+		CSPTracker* m_ptr = nullptr;
+	};
+
 	template<typename _Ty> class TRelaxedRegisteredObj;
 	template<typename _Ty> class TRelaxedRegisteredConstPointer;
 	template<typename _Ty> class TRelaxedRegisteredNotNullPointer;
@@ -204,10 +458,10 @@ namespace mse {
 	class TRelaxedRegisteredPointer : public TSaferPtrForLegacy<_Ty> {
 	public:
 		TRelaxedRegisteredPointer() : TSaferPtrForLegacy<_Ty>() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 		}
 		TRelaxedRegisteredPointer(_Ty* ptr) : TSaferPtrForLegacy<_Ty>(ptr) {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
@@ -217,14 +471,14 @@ namespace mse {
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
 		TRelaxedRegisteredPointer(const TRelaxedRegisteredPointer& src_cref) : TSaferPtrForLegacy<_Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			(*m_sp_tracker_ptr).registerPointer((*this), src_cref.m_ptr);
 		}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TRelaxedRegisteredPointer(const TRelaxedRegisteredPointer<_Ty2>& src_cref) : TSaferPtrForLegacy<_Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			//m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
@@ -314,7 +568,7 @@ namespace mse {
 			return (TRelaxedRegisteredObj<_Ty>*)((*this).m_ptr);
 		}
 
-		CSPTracker* m_sp_tracker_ptr = nullptr;
+		CSPTrackerPtr m_sp_tracker_ptr;
 		bool m_might_not_point_to_a_TRelaxedRegisteredObj = false;
 
 		template <class Y> friend class TRelaxedRegisteredPointer;
@@ -325,10 +579,10 @@ namespace mse {
 	class TRelaxedRegisteredConstPointer : public TSaferPtrForLegacy<const _Ty> {
 	public:
 		TRelaxedRegisteredConstPointer() : TSaferPtrForLegacy<const _Ty>() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 		}
 		TRelaxedRegisteredConstPointer(const _Ty* ptr) : TSaferPtrForLegacy<const _Ty>(ptr) {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
@@ -338,28 +592,28 @@ namespace mse {
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
 		TRelaxedRegisteredConstPointer(const TRelaxedRegisteredConstPointer& src_cref) : TSaferPtrForLegacy<const _Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			(*m_sp_tracker_ptr).registerPointer((*this), src_cref.m_ptr);
 		}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TRelaxedRegisteredConstPointer(const TRelaxedRegisteredConstPointer<_Ty2>& src_cref) : TSaferPtrForLegacy<const _Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			//m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
 			(*m_sp_tracker_ptr).registerPointer((*this), src_cref.m_ptr);
 		}
 		TRelaxedRegisteredConstPointer(const TRelaxedRegisteredPointer<_Ty>& src_cref) : TSaferPtrForLegacy<const _Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			(*m_sp_tracker_ptr).registerPointer((*this), src_cref.m_ptr);
 		}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TRelaxedRegisteredConstPointer(const TRelaxedRegisteredPointer<_Ty2>& src_cref) : TSaferPtrForLegacy<const _Ty>(src_cref.m_ptr) {
-			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			//m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			m_sp_tracker_ptr = src_cref.m_sp_tracker_ptr;
 			m_might_not_point_to_a_TRelaxedRegisteredObj = src_cref.m_might_not_point_to_a_TRelaxedRegisteredObj;
 			(*m_sp_tracker_ptr).registerPointer((*this), src_cref.m_ptr);
@@ -455,7 +709,7 @@ namespace mse {
 			return (const TRelaxedRegisteredObj<_Ty>*)((*this).m_ptr);
 		}
 
-		CSPTracker* m_sp_tracker_ptr = nullptr;
+		CSPTrackerPtr m_sp_tracker_ptr;
 		bool m_might_not_point_to_a_TRelaxedRegisteredObj = false;
 
 		template <class Y> friend class TRelaxedRegisteredConstPointer;
@@ -581,7 +835,7 @@ namespace mse {
 	class CTrackerNotifier {
 	public:
 		CTrackerNotifier() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef());
 			(*m_sp_tracker_ptr).onObjectConstruction(this);
 		}
 		~CTrackerNotifier() {
@@ -589,7 +843,7 @@ namespace mse {
 		}
 		CSPTracker* trackerPtr() const { return m_sp_tracker_ptr; }
 
-		CSPTracker* m_sp_tracker_ptr = nullptr;
+		CSPTrackerPtr m_sp_tracker_ptr;
 	};
 
 	/* TRelaxedRegisteredObj is intended as a transparent wrapper for other classes/objects. The purpose is to register the object's
@@ -602,7 +856,7 @@ namespace mse {
 		TRelaxedRegisteredObj(const TRelaxedRegisteredObj& _X) : _TROFLy(_X) {}
 		TRelaxedRegisteredObj(TRelaxedRegisteredObj&& _X) : _TROFLy(std::move(_X)) {}
 		virtual ~TRelaxedRegisteredObj() {
-			//gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID).onObjectDestruction(this);
+			//gSPTrackerMap.SPTrackerRef().onObjectDestruction(this);
 		}
 		using _TROFLy::operator=;
 		//TRelaxedRegisteredObj& operator=(TRelaxedRegisteredObj&& _X) { _TROFLy::operator=(std::move(_X)); return (*this); }
@@ -721,6 +975,83 @@ namespace mse {
 			mse::TRelaxedRegisteredFixedPointer<D> D_relaxedregistered_fptr2 = &relaxedregistered_gd;
 			mse::TRelaxedRegisteredFixedConstPointer<D> D_relaxedregistered_fcptr2 = &relaxedregistered_gd;
 		}
+
+#ifndef MSE_REGISTEREDPOINTER_DISABLED
+		{
+			/* Exercising the tracker's "slow storage", which holds the object-pointer mappings when there are lots of objects or
+			lots of pointers targeting an object. */
+			static const int num_objects = 40;
+			static const int num_ptrs_per_object = 6;
+			int objects[num_objects];
+			mse::TSaferPtr<int> ptrs[num_objects][num_ptrs_per_object];
+			mse::CSPTracker::slow_storage_type slow_storage;
+			for (int i = 0; i < num_objects; i += 1) {
+				for (int j = 0; j < num_ptrs_per_object; j += 1) {
+					ptrs[i][j] = &(objects[i]);
+					slow_storage.insert(&(objects[i]), &(ptrs[i][j]));
+				}
+			}
+			assert(size_t(num_objects * num_ptrs_per_object) == slow_storage.size());
+			for (int i = 0; i < num_objects; i += 1) {
+				bool res = slow_storage.erase(&(objects[i]), &(ptrs[i][i % num_ptrs_per_object]));
+				assert(res);
+				res = slow_storage.erase(&(objects[i]), &(ptrs[i][i % num_ptrs_per_object]));
+				assert(!res);
+			}
+			for (int i = 0; i < num_objects; i += 2) {
+				slow_storage.onObjectDestruction(&(objects[i]));
+				assert(!slow_storage.containsObject(&(objects[i])));
+			}
+			for (int i = 0; i < num_objects; i += 1) {
+				for (int j = 0; j < num_ptrs_per_object; j += 1) {
+					if ((0 == (i % 2)) && ((i % num_ptrs_per_object) != j)) {
+						assert(!ptrs[i][j]);
+					}
+					else {
+						assert(ptrs[i][j] == &(objects[i]));
+					}
+				}
+			}
+			for (int i = 1; i < num_objects; i += 2) {
+				assert(slow_storage.containsObject(&(objects[i])));
+				for (int j = 0; j < num_ptrs_per_object; j += 1) {
+					slow_storage.erase(&(objects[i]), &(ptrs[i][j]));
+				}
+				assert(!slow_storage.containsObject(&(objects[i])));
+			}
+			assert(0 == slow_storage.size());
+		}
+		{
+			/* Fast storage capacity adjustment. */
+			static const int num_objects = 64;
+			int objects[num_objects];
+			mse::TSaferPtr<int> ptrs[num_objects];
+			mse::CSPTracker sp_tracker;
+			const auto initial_statistics = sp_tracker.statistics();
+			/* Cycling through more objects than fit in fast storage should cause fast storage to grow. */
+			for (int k = 0; k < 200; k += 1) {
+				for (int i = 0; i < num_objects; i += 1) {
+					sp_tracker.registerPointer(ptrs[i], &(objects[i]));
+				}
+				for (int i = 0; i < num_objects; i += 1) {
+					sp_tracker.unregisterPointer(ptrs[i], &(objects[i]));
+				}
+			}
+			const auto statistics2 = sp_tracker.statistics();
+			assert(statistics2.m_fs1_max_objects > initial_statistics.m_fs1_max_objects);
+			assert(mse::CSPTracker::sc_fs1_max_objects_upper_bound >= statistics2.m_fs1_max_objects);
+			assert(0 != statistics2.m_num_fs1_evictions);
+			assert(0 != statistics2.m_num_fs1_resizes);
+			/* Repeatedly using just one object should cause it to shrink. */
+			for (int k = 0; k < 100000; k += 1) {
+				sp_tracker.registerPointer(ptrs[0], &(objects[0]));
+				sp_tracker.unregisterPointer(ptrs[0], &(objects[0]));
+			}
+			const auto statistics3 = sp_tracker.statistics();
+			assert(mse::CSPTracker::sc_fs1_min_objects == statistics3.m_fs1_max_objects);
+			assert(statistics3.m_num_fs1_hits > statistics2.m_num_fs1_hits);
+		}
+#endif // !MSE_REGISTEREDPOINTER_DISABLED
 #endif // MSE_SELF_TESTS
 	}
 }
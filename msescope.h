@@ -222,7 +222,8 @@ namespace mse {
 	template<typename _Ty>
 	class TXScopeFixedPointer : public TXScopeNotNullPointer<_Ty> {
 	public:
-		TXScopeFixedPointer(const TXScopeFixedPointer& src_cref) : TXScopeNotNullPointer<_Ty>(src_cref) {}
+		TXScopeFixedPointer(const TXScopeFixedPointer& src_cref) noexcept(std::is_nothrow_copy_constructible<TXScopePointerBase<_Ty>>::value)
+			: TXScopeNotNullPointer<_Ty>(src_cref) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeFixedPointer(const TXScopeFixedPointer<_Ty2>& src_cref) : TXScopeNotNullPointer<_Ty>(src_cref) {}
 		virtual ~TXScopeFixedPointer() {}
@@ -245,7 +246,8 @@ namespace mse {
 	template<typename _Ty>
 	class TXScopeFixedConstPointer : public TXScopeNotNullConstPointer<_Ty> {
 	public:
-		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
+		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty>& src_cref) noexcept(std::is_nothrow_copy_constructible<TXScopeConstPointerBase<const _Ty>>::value)
+			: TXScopeNotNullConstPointer<_Ty>(src_cref) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty2>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
 		TXScopeFixedConstPointer(const TXScopeFixedPointer<_Ty>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
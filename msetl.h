@@ -12,5 +12,6 @@
 #include "msemsevector.h"
 #include "msemstdvector.h"
 #include "mseivector.h"
+#include "msealgorithm.h"
 
 #endif /*ndef MSETL_H*/
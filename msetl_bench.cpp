@@ -0,0 +1,928 @@
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/*
+Microbenchmarks for the library's pointer, container and shared object types.
+
+Each benchmark is run for enough iterations to take at least the minimum time, then repeated (with the same number of
+iterations) to get the mean, median, standard deviation and minimum (wall-clock) time per iteration, along with the cpu
+time per iteration. The command line options follow the conventions of Google Benchmark, and the JSON output uses its
+format, so existing tools for comparing runs (and tracking regressions) can be used.
+
+usage: msetl_bench [--benchmark_filter=<regex>] [--benchmark_repetitions=<n>] [--benchmark_min_time=<seconds>]
+	[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_list_tests]
+*/
+
+#include "mseregistered.h"
+#include "mserelaxedregistered.h"
+#include "mserefcounting.h"
+#include "msescope.h"
+#include "mseasyncshared.h"
+#include "msepoly.h"
+#include "msemsearray.h"
+#include "msemsevector.h"
+#include "msemstdvector.h"
+#include "msealgorithm.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <future>
+#include <regex>
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
+namespace msetl_bench {
+
+	/*****************/
+	/*   Harness     */
+	/*****************/
+
+	/* Benchmarks store their results here so that the optimizer can't discard the work that produced them. */
+	volatile long long g_sink = 0;
+	inline void sink(long long value) { g_sink = g_sink + value; }
+
+	class CBenchmarkState {
+	public:
+		CBenchmarkState(size_t iterations, long long arg) : m_iterations(iterations), m_arg(arg) {}
+
+		/* Intended to be used as the loop condition: while (state.keep_running()) { ... }
+		Only the loop is timed. */
+		bool keep_running() {
+			if (0 == m_num_keep_running_calls) {
+				start_timer();
+			}
+			if (m_iterations > m_num_keep_running_calls) {
+				m_num_keep_running_calls += 1;
+				return true;
+			}
+			stop_timer();
+			return false;
+		}
+		/* Benchmarks that don't use keep_running() (multi-threaded ones, for example) time themselves. Both wall-clock
+		time and (process-wide, so including any threads the benchmark starts) cpu time are measured. */
+		void start_timer() {
+			m_start_time = std::chrono::steady_clock::now();
+			m_start_cpu_time = std::clock();
+		}
+		void stop_timer() {
+			m_elapsed += std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - m_start_time).count();
+			m_cpu_elapsed += double(std::clock() - m_start_cpu_time) / CLOCKS_PER_SEC;
+		}
+
+		size_t iterations() const { return m_iterations; }
+		long long arg() const { return m_arg; }
+		double elapsed_seconds() const { return m_elapsed; }
+		double cpu_elapsed_seconds() const { return m_cpu_elapsed; }
+
+	private:
+		size_t m_iterations;
+		long long m_arg;
+		size_t m_num_keep_running_calls = 0;
+		std::chrono::steady_clock::time_point m_start_time;
+		std::clock_t m_start_cpu_time = 0;
+		double m_elapsed = 0.0;
+		double m_cpu_elapsed = 0.0;
+	};
+
+	class CBenchmark {
+	public:
+		std::string m_name;
+		std::function<void(CBenchmarkState&)> m_function;
+		/* Each argument value is a separate run (named "<name>/<arg name>:<arg>", or "<name>/<arg>"). */
+		std::vector<long long> m_args;
+		std::string m_arg_name;
+	};
+
+	std::vector<CBenchmark>& benchmarks() {
+		static std::vector<CBenchmark> s_benchmarks;
+		return s_benchmarks;
+	}
+	void register_benchmark(const std::string& name, std::function<void(CBenchmarkState&)> function
+		, std::vector<long long> args = std::vector<long long>{ 0 }, const std::string& arg_name = "") {
+		benchmarks().push_back(CBenchmark{ name, function, args, arg_name });
+	}
+
+	/* Divides the state's iterations among number_of_threads threads, each of which calls
+	thread_function(number_of_iterations). The whole thing, including thread creation, is timed. */
+	template<class _TThreadFunction>
+	void run_in_threads(CBenchmarkState& state, int number_of_threads, const _TThreadFunction& thread_function) {
+		state.start_timer();
+		std::vector<std::thread> threads;
+		for (int j = 0; j < number_of_threads; j += 1) {
+			const size_t number_of_iterations = (state.iterations() + size_t(number_of_threads - 1 - j)) / size_t(number_of_threads);
+			threads.emplace_back([&thread_function, number_of_iterations]() { thread_function(number_of_iterations); });
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		state.stop_timer();
+	}
+
+	double mean(const std::vector<double>& times) {
+		double sum = 0.0;
+		for (auto time : times) { sum += time; }
+		return sum / double(times.size());
+	}
+	double median(std::vector<double> times) {
+		std::sort(times.begin(), times.end());
+		const auto n = times.size();
+		return (0 == (n % 2)) ? ((times[n / 2 - 1] + times[n / 2]) / 2.0) : times[n / 2];
+	}
+	double stddev(const std::vector<double>& times) {
+		if (2 > times.size()) { return 0.0; }
+		const auto l_mean = mean(times);
+		double sum_of_squares = 0.0;
+		for (auto time : times) { sum_of_squares += (time - l_mean) * (time - l_mean); }
+		return std::sqrt(sum_of_squares / double(times.size() - 1));
+	}
+	double min(const std::vector<double>& times) {
+		return *std::min_element(times.begin(), times.end());
+	}
+
+	class CRunResult {
+	public:
+		std::string m_run_name;
+		size_t m_iterations = 0;
+		/* nanoseconds per iteration, one per repetition */
+		std::vector<double> m_times;
+		std::vector<double> m_cpu_times;
+	};
+
+	class COptions {
+	public:
+		std::string m_filter = ".*";
+		int m_repetitions = 5;
+		double m_min_time = 0.1;
+		std::string m_format = "console";
+		std::string m_out_filename;
+		bool m_list_tests = false;
+	};
+
+	CRunResult run_benchmark(const CBenchmark& benchmark, long long arg, const std::string& run_name, const COptions& options) {
+		/* First find the number of iterations that takes at least the minimum time. */
+		size_t iterations = 1;
+		while (true) {
+			CBenchmarkState state(iterations, arg);
+			benchmark.m_function(state);
+			const double elapsed = state.elapsed_seconds();
+			if ((elapsed >= options.m_min_time) || (size_t(1000000000) <= iterations)) {
+				break;
+			}
+			double multiplier = (1e-9 < elapsed) ? (options.m_min_time * 1.4 / elapsed) : 10.0;
+			multiplier = std::min(10.0, std::max(2.0, multiplier));
+			iterations = std::max(iterations + 1, size_t(double(iterations) * multiplier));
+		}
+
+		CRunResult retval;
+		retval.m_run_name = run_name;
+		retval.m_iterations = iterations;
+		for (int i = 0; i < options.m_repetitions; i += 1) {
+			CBenchmarkState state(iterations, arg);
+			benchmark.m_function(state);
+			retval.m_times.push_back(state.elapsed_seconds() * 1e9 / double(iterations));
+			retval.m_cpu_times.push_back(state.cpu_elapsed_seconds() * 1e9 / double(iterations));
+		}
+		return retval;
+	}
+
+	std::string json_escaped(const std::string& str) {
+		std::string retval;
+		for (auto ch : str) {
+			if (('"' == ch) || ('\\' == ch)) { retval += '\\'; }
+			retval += ch;
+		}
+		return retval;
+	}
+
+	void write_json(std::ostream& os, const std::vector<CRunResult>& results, const COptions& options, const char* executable_name) {
+		char date_str[64] = "";
+		const auto now = std::time(nullptr);
+		std::strftime(date_str, sizeof(date_str), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+		os << "{\n";
+		os << "  \"context\": {\n";
+		os << "    \"date\": \"" << date_str << "\",\n";
+		os << "    \"executable\": \"" << json_escaped(executable_name) << "\",\n";
+		os << "    \"num_cpus\": " << std::max(1u, std::thread::hardware_concurrency()) << ",\n";
+#ifdef NDEBUG
+		os << "    \"library_build_type\": \"release\",\n";
+#else // NDEBUG
+		os << "    \"library_build_type\": \"debug\",\n";
+#endif // NDEBUG
+		os << "    \"repetitions\": " << options.m_repetitions << ",\n";
+		os << "    \"min_time\": " << options.m_min_time << "\n";
+		os << "  },\n";
+		os << "  \"benchmarks\": [";
+		bool first = true;
+		auto write_entry = [&](const CRunResult& result, const std::string& name, const char* run_type, int repetition_index, const char* aggregate_name, double time, double cpu_time) {
+			os << (first ? "\n" : ",\n");
+			first = false;
+			os << "    {\n";
+			os << "      \"name\": \"" << json_escaped(name) << "\",\n";
+			os << "      \"run_name\": \"" << json_escaped(result.m_run_name) << "\",\n";
+			os << "      \"run_type\": \"" << run_type << "\",\n";
+			os << "      \"repetitions\": " << result.m_times.size() << ",\n";
+			if (0 <= repetition_index) {
+				os << "      \"repetition_index\": " << repetition_index << ",\n";
+			}
+			if (nullptr != aggregate_name) {
+				os << "      \"aggregate_name\": \"" << aggregate_name << "\",\n";
+			}
+			os << "      \"iterations\": " << result.m_iterations << ",\n";
+			os << "      \"real_time\": " << std::setprecision(9) << time << ",\n";
+			os << "      \"cpu_time\": " << std::setprecision(9) << cpu_time << ",\n";
+			os << "      \"time_unit\": \"ns\"\n";
+			os << "    }";
+		};
+		for (const auto& result : results) {
+			for (size_t i = 0; i < result.m_times.size(); i += 1) {
+				write_entry(result, result.m_run_name, "iteration", int(i), nullptr, result.m_times[i], result.m_cpu_times[i]);
+			}
+			write_entry(result, result.m_run_name + "_mean", "aggregate", -1, "mean", mean(result.m_times), mean(result.m_cpu_times));
+			write_entry(result, result.m_run_name + "_median", "aggregate", -1, "median", median(result.m_times), median(result.m_cpu_times));
+			write_entry(result, result.m_run_name + "_stddev", "aggregate", -1, "stddev", stddev(result.m_times), stddev(result.m_cpu_times));
+			write_entry(result, result.m_run_name + "_min", "aggregate", -1, "min", min(result.m_times), min(result.m_cpu_times));
+		}
+		os << "\n  ]\n";
+		os << "}\n";
+	}
+
+	void write_csv(std::ostream& os, const std::vector<CRunResult>& results) {
+		os << "name,iterations,mean_ns,median_ns,stddev_ns,min_ns,mean_cpu_ns\n";
+		for (const auto& result : results) {
+			os << "\"" << result.m_run_name << "\"," << result.m_iterations << "," << mean(result.m_times) << "," << median(result.m_times)
+				<< "," << stddev(result.m_times) << "," << min(result.m_times) << "," << mean(result.m_cpu_times) << "\n";
+		}
+	}
+
+	void write_console_header(std::ostream& os, size_t name_width) {
+		os << std::left << std::setw(int(name_width)) << "Benchmark" << std::right << std::setw(14) << "Mean (ns)" << std::setw(14) << "Median"
+			<< std::setw(12) << "Stddev" << std::setw(14) << "Min" << std::setw(14) << "CPU (ns)" << std::setw(14) << "Iterations" << "\n";
+		os << std::string(name_width + 82, '-') << "\n";
+	}
+	void write_console_line(std::ostream& os, const CRunResult& result, size_t name_width) {
+		os << std::left << std::setw(int(name_width)) << result.m_run_name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(14) << mean(result.m_times) << std::setw(14) << median(result.m_times) << std::setw(12) << stddev(result.m_times)
+			<< std::setw(14) << min(result.m_times) << std::setw(14) << mean(result.m_cpu_times) << std::setw(14) << result.m_iterations << "\n";
+		os.unsetf(std::ios_base::floatfield);
+	}
+
+	/*****************/
+	/*   Pointers    */
+	/*****************/
+
+	class CE {
+	public:
+		CE() {}
+		CE(int& count_ref) : m_count_ptr(&count_ref) { (*m_count_ptr) += 1; }
+		virtual ~CE() { (*m_count_ptr) -= 1; }
+		int m_x = 0;
+		int *m_count_ptr = nullptr;
+	};
+
+	void native_pointer_allocate_and_destroy(CBenchmarkState& state) {
+		int count = 0;
+		CE* item_ptr2 = nullptr;
+		while (state.keep_running()) {
+			auto item_ptr = new CE(count);
+			item_ptr2 = item_ptr;
+			delete item_ptr;
+		}
+		sink(count + (nullptr != item_ptr2));
+	}
+	void registered_pointer_allocate_and_destroy(CBenchmarkState& state) {
+		int count = 0;
+		mse::TRegisteredPointer<CE> item_ptr2 = mse::registered_new<CE>(count);
+		mse::registered_delete<CE>(item_ptr2);
+		while (state.keep_running()) {
+			mse::TRegisteredPointer<CE> item_ptr = mse::registered_new<CE>(count);
+			item_ptr2 = item_ptr;
+			mse::registered_delete<CE>(item_ptr);
+		}
+		sink(count);
+	}
+	void registered_pointer_pooled_allocate_and_destroy(CBenchmarkState& state) {
+		int count = 0;
+		mse::TRegisteredPointer<CE> item_ptr2 = mse::registered_pooled_new<CE>(count);
+		mse::registered_pooled_delete<CE>(item_ptr2);
+		while (state.keep_running()) {
+			mse::TRegisteredPointer<CE> item_ptr = mse::registered_pooled_new<CE>(count);
+			item_ptr2 = item_ptr;
+			mse::registered_pooled_delete<CE>(item_ptr);
+		}
+		sink(count);
+	}
+	template<int _Tn>
+	void registered_pointer_target_the_stack(CBenchmarkState& state) {
+		int count = 0;
+		mse::TRegisteredObj<CE, _Tn> place_holder1(count);
+		mse::TRegisteredPointer<CE, _Tn> item_ptr2 = &place_holder1;
+		while (state.keep_running()) {
+			mse::TRegisteredObj<CE, _Tn> object(count);
+			mse::TRegisteredPointer<CE, _Tn> item_ptr = &object;
+			item_ptr2 = item_ptr;
+		}
+		sink(count);
+	}
+	/* Copying and destroying pointers to an object that is targeted by (arg) other registered pointers. */
+	template<int _Tn>
+	void registered_pointer_copy(CBenchmarkState& state) {
+		const size_t number_of_pointers = size_t(state.arg());
+		int count = 0;
+		mse::TRegisteredObj<CE, _Tn> object(count);
+		std::vector<mse::TRegisteredPointer<CE, _Tn>> item_ptrs(number_of_pointers);
+		for (auto& item_ptr_ref : item_ptrs) {
+			item_ptr_ref = &object;
+		}
+		size_t i = 0;
+		while (state.keep_running()) {
+			mse::TRegisteredPointer<CE, _Tn> item_ptr = item_ptrs[i];
+			item_ptrs[i] = nullptr;
+			item_ptrs[i] = item_ptr;
+			i = (number_of_pointers <= i + 1) ? 0 : i + 1;
+		}
+		sink(count);
+	}
+	void relaxed_registered_pointer_allocate_and_destroy(CBenchmarkState& state) {
+		int count = 0;
+		mse::TRelaxedRegisteredPointer<CE> item_ptr2 = mse::relaxed_registered_new<CE>(count);
+		mse::relaxed_registered_delete<CE>(item_ptr2);
+		while (state.keep_running()) {
+			mse::TRelaxedRegisteredPointer<CE> item_ptr = mse::relaxed_registered_new<CE>(count);
+			item_ptr2 = item_ptr;
+			mse::relaxed_registered_delete<CE>(item_ptr);
+		}
+		sink(count);
+	}
+	/* The same thing, but with the work divided among (arg) threads. (Each thread uses its own tracker.) */
+	void relaxed_registered_pointer_allocate_and_destroy_threads(CBenchmarkState& state) {
+		run_in_threads(state, int(state.arg()), [](size_t number_of_iterations) {
+			int count = 0;
+			mse::TRelaxedRegisteredPointer<CE> item_ptr2 = mse::relaxed_registered_new<CE>(count);
+			mse::relaxed_registered_delete<CE>(item_ptr2);
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				mse::TRelaxedRegisteredPointer<CE> item_ptr = mse::relaxed_registered_new<CE>(count);
+				item_ptr2 = item_ptr;
+				mse::relaxed_registered_delete<CE>(item_ptr);
+			}
+			assert(0 == count);
+		});
+	}
+
+	/* For the pointer types that manage the lifespan of their target. */
+	template<class _TPointer, class _TMakeFunction>
+	void owning_pointer_allocate_and_destroy(CBenchmarkState& state, const _TMakeFunction& make_function) {
+		int count = 0;
+		_TPointer item_ptr2 = make_function(count);
+		while (state.keep_running()) {
+			_TPointer item_ptr = make_function(count);
+			item_ptr2 = item_ptr;
+			item_ptr = nullptr;
+		}
+		item_ptr2 = nullptr;
+		sink(count);
+	}
+	/* Copying (and releasing) pointers to an existing object. */
+	template<class _TPointer>
+	void owning_pointer_copy(CBenchmarkState& state, const _TPointer& item_ptr1) {
+		_TPointer item_ptr2 = item_ptr1;
+		while (state.keep_running()) {
+			_TPointer item_ptr = item_ptr1;
+			item_ptr2 = item_ptr;
+		}
+		sink(item_ptr2 == item_ptr1);
+	}
+	/* Here we allocate (arg) small objects, where the size of the control block matters more. */
+	template<class _TPointer, class _TMakeFunction>
+	void owning_pointer_many_small_objects(CBenchmarkState& state, const _TMakeFunction& make_function) {
+		const int number_of_objects = int(state.arg());
+		std::vector<_TPointer> ptrs;
+		ptrs.reserve(number_of_objects);
+		long long sum = 0;
+		while (state.keep_running()) {
+			for (int i = 0; i < number_of_objects; i += 1) {
+				ptrs.push_back(make_function(i));
+			}
+			for (const auto& ptr : ptrs) {
+				sum += (*ptr);
+			}
+			ptrs.clear();
+		}
+		sink(sum);
+	}
+	/* Here the objects are allocated in an arena and are released in bulk. */
+	void arena_refcounting_pointer_allocate_and_destroy(CBenchmarkState& state) {
+		int count = 0;
+		mse::CRefCountingArena arena;
+		mse::TArenaRefCountingPointer<CE> item_ptr2 = mse::make_refcounting_in<CE>(arena, count);
+		size_t i = 0;
+		while (state.keep_running()) {
+			mse::TArenaRefCountingPointer<CE> item_ptr = mse::make_refcounting_in<CE>(arena, count);
+			item_ptr2 = item_ptr;
+			item_ptr = nullptr;
+			i += 1;
+			if (0 == (i % 1024)) {
+				arena.release_all();
+			}
+		}
+		item_ptr2 = nullptr;
+		arena.release_all();
+		sink(count);
+	}
+
+	/* Traversing a (circular) linked list of three items. */
+	template<class _TNode, class _TStep>
+	void linked_list_traversal(CBenchmarkState& state, _TNode start_node, const _TStep& step) {
+		auto node = start_node;
+		while (state.keep_running()) {
+			node = step(node);
+		}
+		sink(step(node) == node);
+	}
+	void native_pointer_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			CF* m_next_item_ptr = nullptr;
+			int m_a = 3;
+		};
+		CF item1, item2, item3;
+		item1.m_next_item_ptr = &item2;
+		item2.m_next_item_ptr = &item3;
+		item3.m_next_item_ptr = &item1;
+		linked_list_traversal(state, &item1, [](CF* cf_ptr) { return cf_ptr->m_next_item_ptr; });
+	}
+	void registered_pointer_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			mse::TRegisteredPointer<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		mse::TRegisteredObj<CF> item1, item2, item3;
+		item1.m_next_item_ptr = &item2;
+		item2.m_next_item_ptr = &item3;
+		item3.m_next_item_ptr = &item1;
+		linked_list_traversal(state, std::addressof(item1.m_next_item_ptr), [](mse::TRegisteredPointer<CF>* rp_ptr) { return std::addressof((*rp_ptr)->m_next_item_ptr); });
+	}
+	void relaxed_registered_pointer_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		mse::TRelaxedRegisteredObj<CF> item1, item2, item3;
+		item1.m_next_item_ptr = &item2;
+		item2.m_next_item_ptr = &item3;
+		item3.m_next_item_ptr = &item1;
+		linked_list_traversal(state, std::addressof(item1.m_next_item_ptr), [](mse::TRelaxedRegisteredPointer<CF>* rrp_ptr) { return std::addressof((*rrp_ptr)->m_next_item_ptr); });
+	}
+	void relaxed_registered_pointer_unchecked_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		mse::TRelaxedRegisteredObj<CF> item1, item2, item3;
+		item1.m_next_item_ptr = &item2;
+		item2.m_next_item_ptr = &item3;
+		item3.m_next_item_ptr = &item1;
+		linked_list_traversal(state, static_cast<CF*>(item1.m_next_item_ptr), [](CF* cf_ptr) { return static_cast<CF*>(cf_ptr->m_next_item_ptr); });
+	}
+	void weak_ptr_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			std::weak_ptr<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		auto item1_ptr = std::make_shared<CF>();
+		auto item2_ptr = std::make_shared<CF>();
+		auto item3_ptr = std::make_shared<CF>();
+		item1_ptr->m_next_item_ptr = item2_ptr;
+		item2_ptr->m_next_item_ptr = item3_ptr;
+		item3_ptr->m_next_item_ptr = item1_ptr;
+		linked_list_traversal(state, &(item1_ptr->m_next_item_ptr), [](std::weak_ptr<CF>* wp_ptr) { return &((*wp_ptr).lock()->m_next_item_ptr); });
+	}
+	void shared_ptr_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			std::shared_ptr<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		auto item1_ptr = std::make_shared<CF>();
+		auto item2_ptr = std::make_shared<CF>();
+		auto item3_ptr = std::make_shared<CF>();
+		item1_ptr->m_next_item_ptr = item2_ptr;
+		item2_ptr->m_next_item_ptr = item3_ptr;
+		item3_ptr->m_next_item_ptr = item1_ptr;
+		linked_list_traversal(state, &(item1_ptr->m_next_item_ptr), [](std::shared_ptr<CF>* sp_ptr) { return &((*sp_ptr)->m_next_item_ptr); });
+		item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
+	}
+	void refcounting_pointer_dereference(CBenchmarkState& state) {
+		class CF {
+		public:
+			mse::TRefCountingPointer<CF> m_next_item_ptr;
+			int m_a = 3;
+		};
+		auto item1_ptr = mse::make_refcounting<CF>();
+		auto item2_ptr = mse::make_refcounting<CF>();
+		auto item3_ptr = mse::make_refcounting<CF>();
+		item1_ptr->m_next_item_ptr = item2_ptr;
+		item2_ptr->m_next_item_ptr = item3_ptr;
+		item3_ptr->m_next_item_ptr = item1_ptr;
+		linked_list_traversal(state, &(item1_ptr->m_next_item_ptr), [](mse::TRefCountingPointer<CF>* refc_ptr) { return &((*refc_ptr)->m_next_item_ptr); });
+		item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
+	}
+	/* A container of pointers of differing types, accessed via (type-erased) _TPolyPointers. */
+	template<template<class> class _TPolyPointer>
+	void poly_pointer_dereference(CBenchmarkState& state) {
+		class CE2 {
+		public:
+			CE2(int a = 0) : m_a(a) {}
+			int m_a = 0;
+		};
+		auto e1_refcptr = mse::make_refcounting<CE2>(1);
+		mse::TRegisteredObj<CE2> e2_regobj(2);
+		auto e3_shptr = std::make_shared<CE2>(3);
+		mse::TRelaxedRegisteredObj<CE2> e4_rlxregobj(4);
+		std::vector<_TPolyPointer<CE2>> ptr_vec;
+		for (int i = 0; i < 16; i += 1) {
+			ptr_vec.push_back(e1_refcptr);
+			ptr_vec.push_back(mse::TRegisteredPointer<CE2>(&e2_regobj));
+			ptr_vec.push_back(e3_shptr);
+			ptr_vec.push_back(mse::TRelaxedRegisteredPointer<CE2>(&e4_rlxregobj));
+		}
+		long long sum = 0;
+		size_t i = 0;
+		while (state.keep_running()) {
+			sum += ptr_vec[i % 64/*ptr_vec.size()*/]->m_a;
+			i += 1;
+		}
+		sink(sum);
+	}
+
+	/*****************/
+	/*   Containers  */
+	/*****************/
+
+	/* Pushing (arg) elements onto an empty vector, then summing them. */
+	template<class _TVector>
+	void vector_push_back(CBenchmarkState& state) {
+		const int number_of_elements = int(state.arg());
+		long long sum = 0;
+		while (state.keep_running()) {
+			_TVector v1;
+			for (int i = 0; i < number_of_elements; i += 1) {
+				v1.push_back(i);
+			}
+			for (size_t i = 0; i < v1.size(); i += 1) {
+				sum += v1[i];
+			}
+		}
+		sink(sum);
+	}
+	void msevector_ss_iterator_increment_and_sum(CBenchmarkState& state) {
+		mse::msevector<int> v1(size_t(state.arg()), 1);
+		long long sum = 0;
+		while (state.keep_running()) {
+			for (auto ss_iter = v1.ss_begin(); v1.ss_end() != ss_iter; ss_iter++) {
+				(*ss_iter) += 1;
+			}
+			for (auto ss_citer = v1.ss_cbegin(); v1.ss_cend() != ss_citer; ss_citer++) {
+				sum += (*ss_citer);
+			}
+		}
+		sink(sum);
+	}
+	void msevector_bulk_increment_and_sum(CBenchmarkState& state) {
+		mse::msevector<int> v1(size_t(state.arg()), 1);
+		long long sum = 0;
+		while (state.keep_running()) {
+			mse::bulk_transform(v1.ss_cbegin(), v1.ss_cend(), v1.ss_begin(), [](int a) { return a + 1; });
+			sum += mse::bulk_accumulate(v1.ss_cbegin(), v1.ss_cend(), 0);
+		}
+		sink(sum);
+	}
+	void xscope_random_access_section_increment_and_sum(CBenchmarkState& state) {
+		mse::TXScopeObj<mse::msevector<int>> v1_xscpobj = mse::msevector<int>(size_t(state.arg()), 1);
+		long long sum = 0;
+		while (state.keep_running()) {
+			mse::TXScopeRandomAccessSection<int> section1(v1_xscpobj.ss_begin(), v1_xscpobj.size());
+			for (size_t i = 0; i < section1.size(); i += 1) {
+				section1[i] += 1;
+			}
+			for (size_t i = 0; i < section1.size(); i += 1) {
+				sum += section1[i];
+			}
+		}
+		sink(sum);
+	}
+	void xscope_span_increment_and_sum(CBenchmarkState& state) {
+		mse::TXScopeObj<mse::msevector<int>> v1_xscpobj = mse::msevector<int>(size_t(state.arg()), 1);
+		long long sum = 0;
+		while (state.keep_running()) {
+			mse::TXScopeSpan<int> span1(&v1_xscpobj);
+			for (size_t i = 0; i < span1.size(); i += 1) {
+				span1[i] += 1;
+			}
+			for (size_t i = 0; i < span1.size(); i += 1) {
+				sum += span1[i];
+			}
+		}
+		sink(sum);
+	}
+	/* Here we insert into (and erase from) an msevector near its end while (arg) ipointers, spread across the vector,
+	are live. Only the ipointers positioned after the insertion point need to be updated. */
+	void msevector_insert_and_erase(CBenchmarkState& state) {
+		const int number_of_ipointers = int(state.arg());
+		mse::msevector<int> v1(4 * number_of_ipointers + 4, 1);
+		std::vector<mse::msevector<int>::ipointer> ipointers;
+		ipointers.reserve(number_of_ipointers);
+		for (int i = 0; i < number_of_ipointers; i += 1) {
+			ipointers.push_back(v1.ibegin() + 4 * i);
+		}
+		int i = 0;
+		while (state.keep_running()) {
+			v1.insert(v1.end() - 2, i);
+			v1.erase(v1.end() - 3);
+			i += 1;
+		}
+		long long sum = 0;
+		for (const auto& ipointer : ipointers) {
+			sum += (*ipointer);
+		}
+		sink(sum);
+	}
+
+	/*****************/
+	/*  AsyncShared  */
+	/*****************/
+
+	class CRoutingTable {
+	public:
+		CRoutingTable() : m_routes(64, 3) {}
+		std::vector<int> m_routes;
+	};
+	struct CSmallTrivial {
+		int m_a = 1;
+		int m_b = 2;
+	};
+	struct CSmallNonTrivial {
+		CSmallNonTrivial() {}
+		CSmallNonTrivial(const CSmallNonTrivial& src) : m_a(src.m_a), m_b(src.m_b) {}
+		int m_a = 1;
+		int m_b = 2;
+	};
+
+	/* Concurrent read pointer acquisition (by (arg) threads). */
+	template<class _TAccessRequester>
+	void async_shared_readlock_ptr(CBenchmarkState& state, _TAccessRequester access_requester) {
+		std::atomic<long long> total{ 0 };
+		run_in_threads(state, int(state.arg()), [access_requester, &total](size_t number_of_iterations) {
+			auto l_access_requester = access_requester;
+			long long sum = 0;
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				sum += l_access_requester.readlock_ptr()->m_routes[i % 64];
+			}
+			total += sum;
+		});
+		sink(total);
+	}
+	template<class _Ty, class _TAccessRequester>
+	void async_shared_small_object_readlock_ptr(CBenchmarkState& state, _TAccessRequester access_requester) {
+		std::atomic<long long> total{ 0 };
+		run_in_threads(state, int(state.arg()), [access_requester, &total](size_t number_of_iterations) {
+			auto l_access_requester = access_requester;
+			long long sum = 0;
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				sum += l_access_requester.readlock_ptr()->m_b;
+			}
+			total += sum;
+		});
+		sink(total);
+	}
+	/* Contended write pointer acquisition (by (arg) threads). */
+	void async_shared_readwrite_writelock_ptr(CBenchmarkState& state) {
+		auto access_requester = mse::make_asyncsharedreadwrite<CSmallNonTrivial>();
+		run_in_threads(state, int(state.arg()), [access_requester](size_t number_of_iterations) {
+			auto l_access_requester = access_requester;
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				l_access_requester.writelock_ptr()->m_a += 1;
+			}
+		});
+		sink(access_requester.readlock_ptr()->m_a);
+	}
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+	void async_shared_readwrite_async_writelock_ptr(CBenchmarkState& state) {
+		auto access_requester = mse::make_asyncsharedreadwrite<CSmallNonTrivial>();
+		run_in_threads(state, int(state.arg()), [access_requester](size_t number_of_iterations) {
+			auto l_access_requester = access_requester;
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				l_access_requester.async_writelock_ptr().get()->m_a += 1;
+			}
+		});
+		sink(access_requester.readlock_ptr()->m_a);
+	}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+	/* Acquiring write pointers to two objects at once. */
+	void async_shared_writelock_ptrs(CBenchmarkState& state) {
+		auto access_requester1 = mse::make_asyncsharedreadwrite<CSmallNonTrivial>();
+		auto access_requester2 = mse::make_asyncsharedreadwrite<CSmallNonTrivial>();
+		run_in_threads(state, int(state.arg()), [access_requester1, access_requester2](size_t number_of_iterations) {
+			auto l_access_requester1 = access_requester1;
+			auto l_access_requester2 = access_requester2;
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				/* Alternating the order in which the objects are requested. */
+				auto writelock_ptrs1 = (0 == (i % 2)) ? mse::writelock_ptrs(l_access_requester1, l_access_requester2)
+					: mse::writelock_ptrs(l_access_requester2, l_access_requester1);
+				std::get<0>(writelock_ptrs1)->m_a += 1;
+				std::get<1>(writelock_ptrs1)->m_a -= 1;
+			}
+		});
+		sink(access_requester1.readlock_ptr()->m_a);
+	}
+	/* Read lock acquisition on the mutex types that can be used by TAsyncSharedObj. */
+	template<class _TMutex>
+	void mutex_lock_shared(CBenchmarkState& state) {
+		_TMutex mutex1;
+		run_in_threads(state, int(state.arg()), [&mutex1](size_t number_of_iterations) {
+			for (size_t i = 0; i < number_of_iterations; i += 1) {
+				mutex1.lock_shared();
+				mutex1.unlock_shared();
+			}
+		});
+	}
+}
+
+int main(int argc, char* argv[]) {
+	using namespace msetl_bench;
+
+	COptions options;
+	for (int i = 1; i < argc; i += 1) {
+		const std::string arg = argv[i];
+		auto value_of = [&arg](const std::string& prefix) { return arg.substr(prefix.size()); };
+		if (0 == arg.find("--benchmark_filter=")) {
+			options.m_filter = value_of("--benchmark_filter=");
+		}
+		else if (0 == arg.find("--benchmark_repetitions=")) {
+			options.m_repetitions = std::max(1, std::atoi(value_of("--benchmark_repetitions=").c_str()));
+		}
+		else if (0 == arg.find("--benchmark_min_time=")) {
+			options.m_min_time = std::atof(value_of("--benchmark_min_time=").c_str());
+		}
+		else if (0 == arg.find("--benchmark_format=")) {
+			options.m_format = value_of("--benchmark_format=");
+		}
+		else if (0 == arg.find("--benchmark_out=")) {
+			options.m_out_filename = value_of("--benchmark_out=");
+		}
+		else if ("--benchmark_list_tests" == arg) {
+			options.m_list_tests = true;
+		}
+		else {
+			std::cerr << "unrecognized option: " << arg << std::endl;
+			std::cerr << "usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_repetitions=<n>] [--benchmark_min_time=<seconds>]"
+				<< " [--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_list_tests]" << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<long long> thread_counts;
+	const int number_of_cores = std::max(1, int(std::thread::hardware_concurrency()));
+	for (int number_of_threads = 1; number_of_cores * 2 > number_of_threads; number_of_threads *= 2) {
+		thread_counts.push_back(std::min(number_of_threads, number_of_cores));
+	}
+	thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+
+	auto make_shared_ce = [](int& count) { return std::make_shared<CE>(count); };
+	auto make_refcounting_ce = [](int& count) { return mse::make_refcounting<CE>(count); };
+	auto make_atomic_refcounting_ce = [](int& count) { return mse::make_atomic_refcounting<CE>(count); };
+	auto make_biased_refcounting_ce = [](int& count) { return mse::make_biased_refcounting<CE>(count); };
+
+	register_benchmark("native_pointer/allocate_and_destroy", native_pointer_allocate_and_destroy);
+	register_benchmark("mse::TRegisteredPointer/allocate_and_destroy", registered_pointer_allocate_and_destroy);
+	register_benchmark("mse::TRegisteredPointer/pooled_allocate_and_destroy", registered_pointer_pooled_allocate_and_destroy);
+	register_benchmark("mse::TRegisteredPointer/target_the_stack", registered_pointer_target_the_stack<mse::sc_default_cache_size>);
+	register_benchmark("mse::TRegisteredPointer/copy", registered_pointer_copy<mse::sc_default_cache_size>, { 1, 32 }, "pointers_to_target");
+	register_benchmark("mse::TRegisteredPointer(intrusive_list_tracking)/target_the_stack", registered_pointer_target_the_stack<mse::sc_intrusive_list_tracking>);
+	register_benchmark("mse::TRegisteredPointer(intrusive_list_tracking)/copy", registered_pointer_copy<mse::sc_intrusive_list_tracking>, { 1, 32 }, "pointers_to_target");
+	register_benchmark("mse::TRelaxedRegisteredPointer/allocate_and_destroy", relaxed_registered_pointer_allocate_and_destroy);
+	register_benchmark("mse::TRelaxedRegisteredPointer/allocate_and_destroy", relaxed_registered_pointer_allocate_and_destroy_threads, thread_counts, "threads");
+	register_benchmark("std::shared_ptr/allocate_and_destroy", [&](CBenchmarkState& state) { owning_pointer_allocate_and_destroy<std::shared_ptr<CE>>(state, make_shared_ce); });
+	register_benchmark("mse::TRefCountingPointer/allocate_and_destroy", [&](CBenchmarkState& state) { owning_pointer_allocate_and_destroy<mse::TRefCountingPointer<CE>>(state, make_refcounting_ce); });
+	register_benchmark("mse::TAtomicRefCountingPointer/allocate_and_destroy", [&](CBenchmarkState& state) { owning_pointer_allocate_and_destroy<mse::TAtomicRefCountingPointer<CE>>(state, make_atomic_refcounting_ce); });
+	register_benchmark("mse::TBiasedRefCountingPointer/allocate_and_destroy", [&](CBenchmarkState& state) { owning_pointer_allocate_and_destroy<mse::TBiasedRefCountingPointer<CE>>(state, make_biased_refcounting_ce); });
+	register_benchmark("mse::TArenaRefCountingPointer/allocate_and_destroy", arena_refcounting_pointer_allocate_and_destroy);
+	register_benchmark("std::shared_ptr/copy", [](CBenchmarkState& state) { int count = 0; owning_pointer_copy<std::shared_ptr<CE>>(state, std::make_shared<CE>(count)); });
+	register_benchmark("mse::TRefCountingPointer/copy", [](CBenchmarkState& state) { int count = 0; owning_pointer_copy<mse::TRefCountingPointer<CE>>(state, mse::make_refcounting<CE>(count)); });
+	register_benchmark("mse::TAtomicRefCountingPointer/copy", [](CBenchmarkState& state) { int count = 0; owning_pointer_copy<mse::TAtomicRefCountingPointer<CE>>(state, mse::make_atomic_refcounting<CE>(count)); });
+	register_benchmark("mse::TBiasedRefCountingPointer/copy", [](CBenchmarkState& state) { int count = 0; owning_pointer_copy<mse::TBiasedRefCountingPointer<CE>>(state, mse::make_biased_refcounting<CE>(count)); });
+	register_benchmark("std::shared_ptr/many_small_objects", [](CBenchmarkState& state) {
+		owning_pointer_many_small_objects<std::shared_ptr<int>>(state, [](int i) { return std::make_shared<int>(i); });
+	}, { 1024 }, "objects");
+	register_benchmark("mse::TRefCountingPointer/many_small_objects", [](CBenchmarkState& state) {
+		owning_pointer_many_small_objects<mse::TRefCountingPointer<int>>(state, [](int i) { return mse::make_refcounting<int>(i); });
+	}, { 1024 }, "objects");
+
+	register_benchmark("native_pointer/dereference", native_pointer_dereference);
+	register_benchmark("mse::TRegisteredPointer/dereference", registered_pointer_dereference);
+	register_benchmark("mse::TRelaxedRegisteredPointer/dereference", relaxed_registered_pointer_dereference);
+	register_benchmark("mse::TRelaxedRegisteredPointer/unchecked_dereference", relaxed_registered_pointer_unchecked_dereference);
+	register_benchmark("std::weak_ptr/dereference", weak_ptr_dereference);
+	register_benchmark("std::shared_ptr/dereference", shared_ptr_dereference);
+	register_benchmark("mse::TRefCountingPointer/dereference", refcounting_pointer_dereference);
+	register_benchmark("mse::TAnyPointer/dereference_mixed_pointer_types", poly_pointer_dereference<mse::TAnyPointer>);
+	register_benchmark("mse::TPolyPointer/dereference_mixed_pointer_types", poly_pointer_dereference<mse::TPolyPointer>);
+
+	register_benchmark("std::vector/push_back_and_sum", vector_push_back<std::vector<int>>, { 1024, 65536 }, "elements");
+	register_benchmark("mse::msevector/push_back_and_sum", vector_push_back<mse::msevector<int>>, { 1024, 65536 }, "elements");
+	register_benchmark("mse::msevector(no_ipointer_tracking)/push_back_and_sum", vector_push_back<mse::msevector<int, std::allocator<int>, mse::msevector_no_ipointer_tracking>>, { 1024, 65536 }, "elements");
+	register_benchmark("mse::mstd::vector/push_back_and_sum", vector_push_back<mse::mstd::vector<int>>, { 1024, 65536 }, "elements");
+	register_benchmark("mse::msevector/ss_iterator_increment_and_sum", msevector_ss_iterator_increment_and_sum, { 1024, 65536 }, "elements");
+	register_benchmark("mse::msevector/bulk_increment_and_sum", msevector_bulk_increment_and_sum, { 1024, 65536 }, "elements");
+	register_benchmark("mse::TXScopeRandomAccessSection/indexed_increment_and_sum", xscope_random_access_section_increment_and_sum, { 1024, 65536 }, "elements");
+	register_benchmark("mse::TXScopeSpan/indexed_increment_and_sum", xscope_span_increment_and_sum, { 1024, 65536 }, "elements");
+	register_benchmark("mse::msevector/insert_and_erase", msevector_insert_and_erase, { 0, 256 }, "live_ipointers");
+
+	register_benchmark("mse::TAsyncSharedReadWrite/writelock_ptr", async_shared_readwrite_writelock_ptr, thread_counts, "threads");
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+	register_benchmark("mse::TAsyncSharedReadWrite/async_writelock_ptr", async_shared_readwrite_async_writelock_ptr, thread_counts, "threads");
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+	register_benchmark("mse::writelock_ptrs(2_objects)", async_shared_writelock_ptrs, thread_counts, "threads");
+	register_benchmark("mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnly/readlock_ptr", [](CBenchmarkState& state) {
+		async_shared_readlock_ptr(state, mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadonly<CRoutingTable>());
+	}, thread_counts, "threads");
+	register_benchmark("mse::TAsyncSharedRCU/readlock_ptr", [](CBenchmarkState& state) {
+		async_shared_readlock_ptr(state, mse::make_asyncsharedrcu<CRoutingTable>());
+	}, thread_counts, "threads");
+	register_benchmark("mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWrite/readlock_ptr(mutex)", [](CBenchmarkState& state) {
+		async_shared_small_object_readlock_ptr<CSmallNonTrivial>(state, mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<CSmallNonTrivial>());
+	}, thread_counts, "threads");
+	register_benchmark("mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWrite/readlock_ptr(trivially_copyable)", [](CBenchmarkState& state) {
+		async_shared_small_object_readlock_ptr<CSmallTrivial>(state, mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<CSmallTrivial>());
+	}, thread_counts, "threads");
+	register_benchmark("mse::recursive_shared_timed_mutex/lock_shared", mutex_lock_shared<mse::recursive_shared_timed_mutex>, thread_counts, "threads");
+	register_benchmark("mse::distributed_recursive_shared_timed_mutex/lock_shared", mutex_lock_shared<mse::distributed_recursive_shared_timed_mutex>, thread_counts, "threads");
+
+	const std::regex filter_regex(options.m_filter);
+	std::vector<std::tuple<const CBenchmark*, long long, std::string>> runs;
+	size_t name_width = 10;
+	for (const auto& benchmark : benchmarks()) {
+		for (auto arg : benchmark.m_args) {
+			std::string run_name = benchmark.m_name;
+			if ((1 < benchmark.m_args.size()) || (!benchmark.m_arg_name.empty())) {
+				run_name += "/" + (benchmark.m_arg_name.empty() ? std::string() : benchmark.m_arg_name + ":") + std::to_string(arg);
+			}
+			if (std::regex_search(run_name, filter_regex)) {
+				name_width = std::max(name_width, run_name.size() + 2);
+				runs.emplace_back(&benchmark, arg, run_name);
+			}
+		}
+	}
+	if (options.m_list_tests) {
+		for (const auto& run : runs) {
+			std::cout << std::get<2>(run) << std::endl;
+		}
+		return 0;
+	}
+
+	std::vector<CRunResult> results;
+	const bool console_output = ("console" == options.m_format);
+	if (console_output) {
+		write_console_header(std::cout, name_width);
+	}
+	for (const auto& run : runs) {
+		results.push_back(run_benchmark(*std::get<0>(run), std::get<1>(run), std::get<2>(run), options));
+		if (console_output) {
+			write_console_line(std::cout, results.back(), name_width);
+		}
+	}
+
+	if ("json" == options.m_format) {
+		write_json(std::cout, results, options, argv[0]);
+	}
+	else if ("csv" == options.m_format) {
+		write_csv(std::cout, results);
+	}
+	if (!options.m_out_filename.empty()) {
+		std::ofstream ofs(options.m_out_filename);
+		if (!ofs) {
+			std::cerr << "couldn't open " << options.m_out_filename << std::endl;
+			return 1;
+		}
+		write_json(ofs, results, options, argv[0]);
+	}
+	return 0;
+}
@@ -55,6 +55,7 @@ them to be enabled. */
 #include "msemsevector.h"
 #include "msemstdvector.h"
 #include "mseivector.h"
+#include "msealgorithm.h"
 #include "msevector_test.h"
 #include "mseprimitives.h"
 #include <algorithm>
@@ -62,7 +63,7 @@ them to be enabled. */
 #include <ctime>
 #include <ratio>
 #include <chrono>
-//include <thread>
+#include <thread>
 //include <sstream>
 #include <future>
 
@@ -74,6 +75,30 @@ them to be enabled. */
 #include <numeric>
 #include <random>
 #include <functional>
+#include <cstdlib>
+#include <new>
+
+/* The global allocation functions are replaced here just to count the heap allocations (made by the current thread), so
+that some of the examples below can verify that an operation doesn't allocate. */
+static thread_local size_t tl_num_heap_allocations = 0;
+void* operator new(std::size_t size) {
+	tl_num_heap_allocations += 1;
+	void* retval = std::malloc((0 == size) ? 1 : size);
+	if (nullptr == retval) { throw std::bad_alloc(); }
+	return retval;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	tl_num_heap_allocations += 1;
+	return std::malloc((0 == size) ? 1 : size);
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
 
 class H {
 public:
@@ -381,6 +406,19 @@ int main(int argc, char* argv[])
 		ss_cit1.set_to_end_marker();
 		bool bres4 = ss_cit1.points_to_an_item();
 
+		{
+			/* When the index is known at compile-time, get<>() (or at<>()) checks it at compile-time, so there's no
+			run-time bounds checking cost. And msearrays can be constexpr, so for example, fixed lookup tables can be
+			evaluated at compile-time. */
+			static constexpr mse::msearray<int, 4> lookup_table1 = { 1, 10, 100, 1000 };
+			static_assert(100 == lookup_table1.get<2>(), "");
+			//auto res0 = lookup_table1.get<4>(); /* would be a compile error */
+
+			int sum = 0;
+			mse::bulk_for_each_n<3>(a1.ss_cbegin(), [&sum](int a) { sum += lookup_table1.at<1>() * a; });
+			a2.get<0>() = sum;
+		}
+
 		{
 			/* A "scope" version of the safe iterators can be used when the array is declared as a scope
 			object. There are limitations on when thay can be used, but unlike the other msearray iterators,
@@ -421,6 +459,24 @@ int main(int argc, char* argv[])
 
 	}
 
+	{
+		/**************************/
+		/*   bulk algorithms      */
+		/**************************/
+
+		/* mse::bulk_fill(), mse::bulk_copy(), mse::bulk_transform(), mse::bulk_accumulate(), mse::bulk_find() and
+		mse::bulk_for_each_n() take (bounds checked) iterators of contiguous containers, and check the validity of the
+		whole range once, up front, rather than for every element. */
+		mse::msevector<int> v1 = { 1, 2, 3, 4, 5 };
+		mse::mstd::vector<int> v2(5);
+		mse::bulk_transform(v1.ss_cbegin(), v1.ss_cend(), v2.begin(), [](int a) { return 10 * a; });
+		auto sum1 = mse::bulk_accumulate(v2.cbegin(), v2.cend(), 0);
+		auto found_it = mse::bulk_find(v2.cbegin(), v2.cend(), 30);
+
+		mse::msealgorithm_test testobj1;
+		testobj1.test1();
+	}
+
 	{
 		/*******************************/
 		/*   CInt, CSize_t and CBool   */
@@ -724,280 +780,7 @@ int main(int argc, char* argv[])
 		mse::s_regptr_test1();
 		mse::s_relaxedregptr_test1();
 
-		{
-			/*************************/
-			/*   Simple Benchmarks   */
-			/*************************/
-
-			/* Just some simple speed tests. */
-			class CE {
-			public:
-				CE() {}
-				CE(int& count_ref) : m_count_ptr(&count_ref) { (*m_count_ptr) += 1; }
-				virtual ~CE() { (*m_count_ptr) -= 1; }
-				int m_x;
-				int *m_count_ptr;
-			};
-#ifndef NDEBUG
-			static const int number_of_loops = 10/*arbitrary*/;
-#else // !NDEBUG
-			static const int number_of_loops = 1000000/*arbitrary*/;
-#endif // !NDEBUG
-			std::cout << std::endl;
-			std::cout << "Some simple benchmarks: \n";
-			std::cout << "number of loops: " << number_of_loops << " \n" << " \n";
-			{
-				int count = 0;
-				auto item_ptr2 = new CE(count);
-				delete item_ptr2; item_ptr2 = nullptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					auto item_ptr = new CE(count);
-					item_ptr2 = item_ptr;
-					delete item_ptr;
-					item_ptr = nullptr;
-				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "native pointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRegisteredPointer<CE> item_ptr2 = mse::registered_new<CE>(count);
-				mse::registered_delete<CE>(item_ptr2);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRegisteredPointer<CE> item_ptr = mse::registered_new<CE>(count);
-					item_ptr2 = item_ptr;
-					mse::registered_delete<CE>(item_ptr);
-				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRegisteredPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRelaxedRegisteredPointer<CE> item_ptr2 = mse::relaxed_registered_new<CE>(count);
-				mse::relaxed_registered_delete<CE>(item_ptr2);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRelaxedRegisteredPointer<CE> item_ptr = mse::relaxed_registered_new<CE>(count);
-					item_ptr2 = item_ptr;
-					mse::relaxed_registered_delete<CE>(item_ptr);
-				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				auto item_ptr2 = std::make_shared<CE>(count);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					auto item_ptr = std::make_shared<CE>(count);
-					item_ptr2 = item_ptr;
-					item_ptr = nullptr;
-				}
-				item_ptr2 = nullptr;
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "std::shared_ptr: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRegisteredObj<CE> place_holder1(count);
-				mse::TRegisteredPointer<CE> item_ptr2 = &place_holder1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				{
-					for (int i = 0; i < number_of_loops; i += 1) {
-						mse::TRegisteredObj<CE> object(count);
-						mse::TRegisteredPointer<CE> item_ptr = &object;
-						item_ptr2 = item_ptr;
-					}
-				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRegisteredPointer targeting the stack: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRefCountingPointer<CE> item_ptr2 = mse::make_refcounting<CE>(count);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRefCountingPointer<CE> item_ptr = mse::make_refcounting<CE>(count);
-					item_ptr2 = item_ptr;
-					item_ptr = nullptr;
-				}
-				item_ptr2 = nullptr;
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRefCountingPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-
-			std::cout << std::endl;
-			static const int number_of_loops2 = (10/*arbitrary*/)*number_of_loops;
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					CF* m_next_item_ptr;
-					int m_a = 3;
-				};
-				CF item1(1);
-				CF item2(2);
-				CF item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				CF* cf_ptr = item1.m_next_item_ptr;
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					cf_ptr = cf_ptr->m_next_item_ptr;
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "native pointer dereferencing: " << time_span.count() << " seconds.";
-				if (3 == cf_ptr->m_a) {
-					std::cout << " "; /* Using cf_ptr->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				mse::TRelaxedRegisteredObj<CF> item1(1);
-				mse::TRelaxedRegisteredObj<CF> item2(2);
-				mse::TRelaxedRegisteredObj<CF> item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				mse::TRelaxedRegisteredPointer<CF>* rpfl_ptr = std::addressof(item1.m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					rpfl_ptr = std::addressof((*rpfl_ptr)->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer (checked) dereferencing: " << time_span.count() << " seconds.";
-				if (3 == (*rpfl_ptr)->m_a) {
-					std::cout << " "; /* Using rpfl_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				mse::TRelaxedRegisteredObj<CF> item1(1);
-				mse::TRelaxedRegisteredObj<CF> item2(2);
-				mse::TRelaxedRegisteredObj<CF> item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				CF* cf_ptr = (item1.m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					cf_ptr = (cf_ptr->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer unchecked dereferencing: " << time_span.count() << " seconds.";
-				if (3 == cf_ptr->m_a) {
-					std::cout << " "; /* Using rpfl_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					std::weak_ptr<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				auto item1_ptr = std::make_shared<CF>(1);
-				auto item2_ptr = std::make_shared<CF>(2);
-				auto item3_ptr = std::make_shared<CF>(3);
-				item1_ptr->m_next_item_ptr = item2_ptr;
-				item2_ptr->m_next_item_ptr = item3_ptr;
-				item3_ptr->m_next_item_ptr = item1_ptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				std::weak_ptr<CF>* wp_ptr = &(item1_ptr->m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					wp_ptr = &((*wp_ptr).lock()->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "std::weak_ptr dereferencing: " << time_span.count() << " seconds.";
-				if (3 == (*wp_ptr).lock()->m_a) {
-					std::cout << " "; /* Using wp_ref.lock()->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRefCountingPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				auto item1_ptr = mse::make_refcounting<CF>(1);
-				auto item2_ptr = mse::make_refcounting<CF>(2);
-				auto item3_ptr = mse::make_refcounting<CF>(3);
-				item1_ptr->m_next_item_ptr = item2_ptr;
-				item2_ptr->m_next_item_ptr = item3_ptr;
-				item3_ptr->m_next_item_ptr = item1_ptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				mse::TRefCountingPointer<CF>* refc_ptr = &(item1_ptr->m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					refc_ptr = &((*refc_ptr)->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRefCountingPointer (checked) dereferencing: " << time_span.count() << " seconds.";
-				item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
-				if (3 == (*refc_ptr)->m_a) {
-					std::cout << " "; /* Using refc_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-		}
+		/* The simple benchmarks that used to be here are now in msetl_bench.cpp (the msetl_bench target). */
 	}
 
 #if defined(MSEREGISTEREDREFWRAPPER) && !defined(MSE_PRIMITIVES_DISABLED)
@@ -1139,6 +922,9 @@ int main(int argc, char* argv[])
 		mse::TRefCountingPointer_test TRefCountingPointer_test1;
 		bool TRefCountingPointer_test1_res = TRefCountingPointer_test1.testBehaviour();
 		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testLinked();
+		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testArena();
+		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testAtomic();
+		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testBiased();
 		TRefCountingPointer_test1.test1();
 	}
 
@@ -1518,7 +1304,24 @@ int main(int argc, char* argv[])
 		nanyptr1 = mse::TNullableAnyPointer<A>(&a_regobj);
 		nanyptr1 = mse::TNullableAnyPointer<A>(a_refcptr);
 		auto res_nap1 = *nanyptr1;
-		
+
+		{
+			/* The library's (refcounting, scope) pointers and (vector) iterators are held inline in the type-erased pointers,
+			so copying and assigning those doesn't allocate (beyond what copying the held pointer itself does). */
+			mse::TAnyPointer<A> anyptr4(a_refcptr);
+			mse::TAnyPointer<A> anyptr5(a_msevec_ssiter);
+			mse::TAnyPointer<A> anyptr6(a_mstdvec_iter);
+			mse::TXScopeAnyPointer<A> xscp_anyptr1(&a_scpobj);
+			const auto num_heap_allocations_before = tl_num_heap_allocations;
+			anyptr3 = anyptr4;
+			anyptr4 = anyptr5;
+			anyptr5 = anyptr6;
+			anyptr6 = anyptr3;
+			mse::TXScopeAnyPointer<A> xscp_anyptr2(xscp_anyptr1);
+			assert(num_heap_allocations_before == tl_num_heap_allocations);
+			assert((*anyptr6).b == a_refcptr->b);
+		}
+
 		mse::s_poly_test1();
 		int q = 3;
 	}
@@ -1624,6 +1427,43 @@ int main(int argc, char* argv[])
 		naraiter1 = naraiter2;
 		naraiter1 = mse::TNullableAnyRandomAccessIterator<int>(iptrwbv1);
 		auto res13 = naraiter1[1];
+
+		{
+			/* Spans check the bounds of their range once, at construction. Element access is then just an index compare
+			and (unlike the sections above) there's no type-erased iterator involved. */
+			class CD {
+			public:
+				static int sum(mse::TXScopeSpan<const int> span) {
+					int retval = 0;
+					span.for_each([&retval](const int& item) { retval += item; });
+					return retval;
+				}
+			};
+			mse::TXScopeObj<mse::msevector<int>> msevector1_xscpobj = mse::msevector<int>{ 1, 2, 3, 4, 5 };
+			mse::TXScopeObj<mse::mstd::array<int, 4>> mstd_array4_xscpobj = mse::mstd::array<int, 4>({ 1, 2, 3, 4 });
+
+			mse::TXScopeSpan<int> span1(&msevector1_xscpobj, 1, 3);
+			span1[0] = 20;
+			auto res14 = CD::sum(span1);
+			auto res15 = CD::sum(span1.subspan(1));
+			for (auto& item : span1) {
+				item += 1;
+			}
+			try {
+				/* The vector is size change locked while span1 exists. */
+				msevector1_xscpobj.push_back(6);
+			}
+			catch (...) {
+				std::cerr << "expected exception" << std::endl;
+			}
+			auto res16 = CD::sum(&mstd_array4_xscpobj);
+
+			auto msevector2_refcptr = mse::make_refcounting<mse::msevector<int>>(mse::msevector<int>{ 1, 2, 3 });
+			mse::TSpan<int> span2(msevector2_refcptr);
+			/* A TXScopeSpan can't be constructed from a temporary TSpan, so sub-spans are stored before being passed. */
+			auto span3 = span2.last(2);
+			auto res17 = CD::sum(span3);
+		}
 	}
 
 	{
@@ -1751,6 +1591,136 @@ int main(int argc, char* argv[])
 			}
 			std::cout << std::endl;
 		}
+		{
+			/* Small trivially copyable objects are shared without any mutex. Read pointers hold a snapshot of the
+			(committed) value, and modifications made through a write pointer are committed when it's destroyed. */
+			struct CPoint {
+				int x;
+				int y;
+			};
+			auto ash_access_requester = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<CPoint>(CPoint{ 1, 2 });
+			{
+				auto writelock_ptr1 = ash_access_requester.writelock_ptr();
+				writelock_ptr1->x = 3;
+				int res1 = ash_access_requester.readlock_ptr()->x; // still 1, the write hasn't been committed yet
+			}
+			int res2 = ash_access_requester.readlock_ptr()->x; // 3
+			mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<CPoint> ash_read_only_access_requester(ash_access_requester);
+			int res3 = ash_read_only_access_requester.readlock_ptr()->y;
+
+			/* A pointer to a member of the snapshot held by a (temporary) read pointer keeps the snapshot alive. */
+			auto y_const_ptr1 = [&]() {
+				auto readlock_ptr1 = ash_access_requester.readlock_ptr();
+				return mse::make_const_pointer_to_member(readlock_ptr1->y, readlock_ptr1);
+			}();
+			auto y_const_ptr2 = [&]() {
+				auto readlock_ptr2 = ash_read_only_access_requester.readlock_ptr();
+				return mse::make_const_pointer_to_member(readlock_ptr2->y, readlock_ptr2);
+			}();
+			ash_access_requester.writelock_ptr()->y = 5;
+			assert((2 == *y_const_ptr1) && (2 == *y_const_ptr2));
+		}
+		{
+			/* For read-mostly objects shared among many threads, mse::TAsyncSharedRCUAccessRequester<> provides read
+			pointers without any locking. Each read pointer is a snapshot of the version that was current when it was
+			obtained. Writers publish new versions rather than modifying the object in place. */
+			std::cout << "TAsyncSharedRCU:";
+			std::cout << std::endl;
+			auto ash_access_requester = mse::make_asyncsharedrcu<A>(7);
+			auto snapshot_ptr1 = ash_access_requester.readlock_ptr();
+			ash_access_requester.update([](A& a) { a.b = 11; });
+			int res1 = snapshot_ptr1->b; // still 7, the snapshot is unaffected by the update
+			int res2 = ash_access_requester.readlock_ptr()->b; // 11
+			assert((7 == res1) && (11 == res2));
+			ash_access_requester.publish(13);
+
+			std::list<std::future<double>> futures;
+			for (size_t i = 0; i < 3; i += 1) {
+				futures.emplace_back(std::async(H::foo7<mse::TAsyncSharedRCUAccessRequester<A>>, ash_access_requester));
+			}
+			int count = 1;
+			for (auto it = futures.begin(); futures.end() != it; it++, count++) {
+				std::cout << "thread: " << count << ", time to acquire read pointer: " << (*it).get() << " seconds.";
+				std::cout << std::endl;
+			}
+			std::cout << std::endl;
+
+			/* mse::TAsyncSharedRCUReadOnlyAccessRequester<>s can be copy constructed from
+			mse::TAsyncSharedRCUAccessRequester<>s */
+			mse::TAsyncSharedRCUReadOnlyAccessRequester<A> ash_read_only_access_requester(ash_access_requester);
+			int res3 = ash_read_only_access_requester.readlock_ptr()->b;
+		}
+#ifdef MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+		{
+			/* With MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS defined, async_writelock_ptr() and async_readlock_ptr() don't block the
+			calling thread. The requests are queued and granted (in the order they were made) when the object becomes
+			available. You can either wait on the returned future, or supply a callback which will be called with the
+			pointer once access is granted. */
+			std::cout << "TAsyncSharedReadWrite async lock requests:";
+			std::cout << std::endl;
+			auto ash_access_requester = mse::make_asyncsharedreadwrite<A>(7);
+			std::future<mse::TAsyncSharedReadWriteConstPointer<A>> readlock_ptr_future1;
+			std::future<void> callback_future1;
+			{
+				auto writelock_ptr1 = ash_access_requester.writelock_ptr();
+				for (int i = 1; i <= 3; i += 1) {
+					/* Callbacks are called from whichever thread makes the object available (in this case, this one when
+					writelock_ptr1 is destroyed), so they should be brief. */
+					ash_access_requester.async_writelock_ptr([i](mse::TAsyncSharedReadWritePointer<A> writelock_ptr) {
+						writelock_ptr->b = i;
+						std::cout << "request: " << i << ", granted. ";
+					});
+				}
+				/* An exception thrown by a callback is stored in the future the request returned, rather than being thrown
+				in the thread that happened to make the object available. */
+				callback_future1 = ash_access_requester.async_readlock_ptr([](mse::TAsyncSharedReadWriteConstPointer<A> readlock_ptr) {
+					if (3 == readlock_ptr->b) { throw std::runtime_error("some error"); }
+				});
+				readlock_ptr_future1 = ash_access_requester.async_readlock_ptr();
+				writelock_ptr1->b = 11;
+			}
+			std::cout << std::endl;
+			try {
+				callback_future1.get();
+				assert(false);
+			}
+			catch (const std::runtime_error&) {}
+			/* Unlike the ones returned by writelock_ptr(), asynchronously obtained pointers can be passed to, and released by,
+			other threads. */
+			auto future1 = std::async([](mse::TAsyncSharedReadWriteConstPointer<A> readlock_ptr) { return readlock_ptr->b; }, readlock_ptr_future1.get());
+			int res1 = future1.get(); // 3
+			assert(3 == res1);
+			std::cout << std::endl;
+		}
+#endif // MSE_ASYNCSHARED_ASYNC_LOCK_REQUESTS
+		{
+			/* When you need write access to more than one shared object at a time, mse::writelock_ptrs() acquires all the
+			locks without risk of deadlock (with other callers of mse::writelock_ptrs()), regardless of argument order. */
+			auto ash_access_requester1 = mse::make_asyncsharedreadwrite<A>(7);
+			auto ash_access_requester2 = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<A>(11);
+			{
+				auto writelock_ptrs1 = mse::writelock_ptrs(ash_access_requester1, ash_access_requester2);
+				std::swap(std::get<0>(writelock_ptrs1)->b, std::get<1>(writelock_ptrs1)->b);
+			}
+			auto writelock_ptr_tuple2 = mse::writelock_ptrs(ash_access_requester2, ash_access_requester1);
+			int res1 = std::get<0>(writelock_ptr_tuple2)->b; // 7
+			assert(7 == res1);
+
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+			/* With MSE_ASYNCSHARED_INSTRUMENTATION1 defined, you can get the lock contention statistics of the (live)
+			shared objects. Here we list the (up to) three most contended ones. */
+			std::cout << "most contended shared objects:";
+			std::cout << std::endl;
+			for (const auto& stats : mse::async_shared_lock_stats_snapshot(3)) {
+				std::cout << stats.m_mutex_address << ": writer acquisitions: " << stats.m_writer_stats.m_acquisition_count
+					<< ", reader acquisitions: " << stats.m_reader_stats.m_acquisition_count
+					<< ", failed tries: " << stats.m_writer_stats.m_failed_try_count + stats.m_reader_stats.m_failed_try_count
+					<< ", total wait: " << stats.total_wait_nanoseconds() << " nanoseconds.";
+				std::cout << std::endl;
+			}
+			std::cout << std::endl;
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+		}
 		{
 			/* Just demonstrating the existence of the "try" versions. */
 			auto access_requester = mse::make_asyncsharedreadwrite<std::string>("some text");
@@ -1780,6 +1750,18 @@ int main(int argc, char* argv[])
 		}
 	}
 
+#ifdef MSE_SAFETY_CHECK_INSTRUMENTATION1
+	{
+		/* With MSE_SAFETY_CHECK_INSTRUMENTATION1 defined, the library counts the safety check events (registrations,
+		bounds checks, null checks, etc.) of each pointer and container type. The counts are also written to a (JSON) file
+		at program exit. */
+		std::cout << std::endl;
+		std::cout << "safety check counts:";
+		std::cout << std::endl;
+		mse::write_safety_check_counts_json(std::cout);
+	}
+#endif // MSE_SAFETY_CHECK_INSTRUMENTATION1
+
 	return 0;
 }
 